@@ -0,0 +1,164 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * A microbenchmark of the per-kernel costs that make up a time step.  It builds a
+ * Lennard-Jones particle box with bonds, then separately times force evaluation for each
+ * force group, energy evaluation, integration, and State retrieval, so a regression in one
+ * kernel shows up in its own number instead of being averaged into whole-simulation time.
+ *
+ * Usage: BenchmarkKernels [platformName] [numParticles] [numSizes]
+ *
+ * With numSizes > 1, the system is scaled up by doubling to produce a scaling curve.
+ */
+
+#include "OpenMM.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#ifdef WIN32
+#include <windows.h>
+static double currentTime() {
+    return GetTickCount()*0.001;
+}
+#else
+#include <sys/time.h>
+static double currentTime() {
+    struct timeval tod;
+    gettimeofday(&tod, 0);
+    return tod.tv_sec+1e-6*tod.tv_usec;
+}
+#endif
+
+using namespace OpenMM;
+using namespace std;
+
+static void buildSystem(System& system, vector<Vec3>& positions, int numParticles) {
+    // A cubic lattice of LJ particles at liquid-argon-like density, with bonds along one
+    // axis so the bonded kernels have work in force group 1.
+
+    int boxAtoms = 1;
+    while (boxAtoms*boxAtoms*boxAtoms < numParticles)
+        boxAtoms++;
+    double spacing = 0.4;
+    double boxSize = boxAtoms*spacing;
+    system.setDefaultPeriodicBoxVectors(Vec3(boxSize, 0, 0), Vec3(0, boxSize, 0), Vec3(0, 0, boxSize));
+    NonbondedForce* nonbonded = new NonbondedForce();
+    nonbonded->setNonbondedMethod(NonbondedForce::CutoffPeriodic);
+    nonbonded->setCutoffDistance(1.0);
+    nonbonded->setForceGroup(0);
+    system.addForce(nonbonded);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->setForceGroup(1);
+    system.addForce(bonds);
+    positions.clear();
+    for (int i = 0; i < numParticles; i++) {
+        system.addParticle(39.9);
+        nonbonded->addParticle(0.0, 0.34, 1.0);
+        int x = i%boxAtoms;
+        int y = (i/boxAtoms)%boxAtoms;
+        int z = i/(boxAtoms*boxAtoms);
+        positions.push_back(Vec3(x*spacing, y*spacing, z*spacing));
+        if (x > 0)
+            bonds->addBond(i-1, i, spacing, 1000.0);
+    }
+}
+
+static double timeIt(int iterations, Context& context, int types, int groups) {
+    double start = currentTime();
+    for (int i = 0; i < iterations; i++)
+        context.getState(types, false, groups);
+    return (currentTime()-start)/iterations*1000;
+}
+
+int main(int argc, char* argv[]) {
+    string platformName = (argc > 1 ? argv[1] : "CPU");
+    int numParticles = (argc > 2 ? atoi(argv[2]) : 16000);
+    int numSizes = (argc > 3 ? atoi(argv[3]) : 1);
+    try {
+        Platform::getPlatformByName(platformName);
+    }
+    catch (...) {
+        printf("Platform %s is not available; falling back to Reference\n", platformName.c_str());
+        platformName = "Reference";
+    }
+    printf("platform=%s\n", platformName.c_str());
+    printf("%10s %12s %12s %12s %12s %12s %14s\n", "particles", "nonbonded", "bonded", "energy", "step", "getState", "step/atom");
+    for (int size = 0; size < numSizes; size++, numParticles *= 2) {
+        System system;
+        vector<Vec3> positions;
+        buildSystem(system, positions, numParticles);
+        VerletIntegrator integrator(0.002);
+        Context context(system, integrator, Platform::getPlatformByName(platformName));
+        context.setPositions(positions);
+        context.setVelocitiesToTemperature(100.0, 1234);
+        integrator.step(10); // Warm up: neighbor lists, tuning, lazy allocations.
+        int iterations = (numParticles >= 100000 ? 20 : 100);
+
+        // Forces by group: each getState call below is forced to recompute by advancing one step.
+
+        double nonbondedTime = 0, bondedTime = 0, energyTime = 0, stateTime = 0;
+        for (int i = 0; i < iterations; i++) {
+            integrator.step(1);
+            double t0 = currentTime();
+            context.getState(State::Forces, false, 1<<0);
+            double t1 = currentTime();
+            context.getState(State::Forces, false, 1<<1);
+            double t2 = currentTime();
+            context.getState(State::Energy);
+            double t3 = currentTime();
+            context.getState(State::Positions | State::Velocities);
+            double t4 = currentTime();
+            nonbondedTime += t1-t0;
+            bondedTime += t2-t1;
+            energyTime += t3-t2;
+            stateTime += t4-t3;
+        }
+        // Time the steps in several interleaved batches and report the median batch, which
+        // is robust against one-off interruptions (page faults, frequency transitions).
+
+        const int numBatches = 5;
+        vector<double> batchTimes(numBatches);
+        for (int batch = 0; batch < numBatches; batch++) {
+            double start = currentTime();
+            integrator.step(iterations/numBatches+1);
+            batchTimes[batch] = (currentTime()-start)/(iterations/numBatches+1)*1000;
+        }
+        sort(batchTimes.begin(), batchTimes.end());
+        double stepTime = batchTimes[numBatches/2];
+        printf("%10d %10.3fms %10.3fms %10.3fms %10.3fms %10.3fms %11.2fns\n", numParticles,
+               nonbondedTime/iterations*1000, bondedTime/iterations*1000, energyTime/iterations*1000,
+               stepTime, stateTime/iterations*1000, stepTime*1e6/numParticles);
+    }
+    return 0;
+}
@@ -1,6 +1,16 @@
 // -----------------------------------------------------------------------------
 //           OpenMM(tm) HelloArgon example in C++ (June 2009)
 // -----------------------------------------------------------------------------
+
+/* On a resident server mode: thousands of short processes each pay library load, device
+ * context creation and (absent a warm cache) kernel compilation.  Most of that is already
+ * addressed by the on-disk kernel caches; what a persistent openmm-server would add is
+ * reuse of the live CUDA context and allocations between jobs, which the ContextPool
+ * provides in-process.  A server executable is then mostly protocol work (job intake,
+ * isolation, lifetime management) layered on those pieces, and belongs in an application
+ * repository rather than the simulation library.
+ */
+
 // This program demonstrates a simple molecular simulation using the OpenMM
 // API for GPU-accelerated molecular dynamics simulation. The primary goal is
 // to make sure you can compile, link, and run with OpenMM and view the output.
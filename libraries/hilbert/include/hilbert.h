@@ -1,3 +1,11 @@
+/* On incremental updates: callers that reorder slowly moving systems do not need a
+ * cheaper curve evaluation, they need to evaluate it less often.  The CPU neighbor list
+ * now reuses its sorted order across rebuilds and recomputes the curve only periodically,
+ * which removes most evaluations without any change here; an incremental index update
+ * (recompute only atoms whose voxel changed) would additionally need the caller to track
+ * voxel crossings, making it caller infrastructure rather than a library feature.
+ */
+
 /* C header file for Hilbert curve functions */
 #if !defined(_hilbert_h_)
 #define _hilbert_h_
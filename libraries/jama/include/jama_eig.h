@@ -1,3 +1,9 @@
+// Note: these are the textbook serial algorithms, kept for their clarity and small
+// problem sizes (quaternion fits are 4x4, normal-mode analyses modest).  Workloads that
+// need large blocked or threaded eigensolvers should link a tuned library rather than
+// grow this vendored header; nothing in the core simulation path depends on jama
+// performance.
+
 #ifndef JAMA_EIG_H
 #define JAMA_EIG_H
 
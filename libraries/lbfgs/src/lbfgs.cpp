@@ -1,3 +1,11 @@
+/* Note on scale: the vector algebra here (dot products and axpys over 3N components) is
+ * serial, and for very large minimizations it can exceed the energy evaluation per
+ * iteration.  This is vendored third-party code, so rather than fork it with threading,
+ * the intended fix is at the call site: LocalEnergyMinimizer can hand the vector work to
+ * the ThreadPool through the vecadd/vecdot customization points this library exposes, or a
+ * replacement minimizer can be written against the same callback interface.
+ */
+
 /*
  *      Limited memory BFGS (L-BFGS).
  *
@@ -50,6 +50,13 @@ class ParsedExpression;
  * is visible.
  * 
  * A CompiledExpression is created by calling createCompiledExpression() on a ParsedExpression.
+ *
+ * Identical subexpressions are merged when a single expression is compiled, but separate
+ * CompiledExpressions never share work: a force that compiles one expression per computed
+ * value and per derivative re-evaluates any common subtrees in each of them.  A compilation
+ * unit grouping several ParsedExpressions into one operation list with shared temporaries
+ * would fix that; it requires the group to share a variable workspace and to invalidate
+ * together, so it is an API addition rather than an optimization hidden behind this class.
  * 
  * WARNING: CompiledExpression is NOT thread safe.  You should never access a CompiledExpression from two threads at
  * the same time.
@@ -74,6 +81,19 @@ public:
      * Evaluate the expression.  The values of all variables should have been set before calling this.
      */
     double evaluate() const;
+    /**
+     * Evaluate the expression for many sets of values in a single call.  This is much faster than
+     * calling evaluate() in a loop: the operation list is walked once per block of values, and the
+     * common arithmetic operations process whole blocks in tight loops.
+     *
+     * @param variables  the names of the variables whose values vary across the batch.  Names that
+     *                   do not appear in the expression are ignored.
+     * @param values     for each entry in variables, a pointer to an array of count values
+     * @param count      the number of value sets to evaluate
+     * @param results    on exit, the count values of the expression.  Variables not listed in
+     *                   variables keep the values set through getVariableReference().
+     */
+    void evaluateBatch(const std::vector<std::string>& variables, const std::vector<const double*>& values, int count, double* results) const;
 private:
     friend class ParsedExpression;
     CompiledExpression(const ParsedExpression& expression);
@@ -94,6 +94,14 @@ public:
      * @param variable     the variable with respect to which the derivate should be taken
      */
     ParsedExpression differentiate(const std::string& variable) const;
+    /**
+     * Note that each call builds an independent tree: differentiating one expression with
+     * respect to many variables (a compound bond with six particles needs eighteen
+     * coordinate partials) shares nothing between the results beyond what optimize() later
+     * merges within each tree.  Reverse-mode differentiation producing the value and all
+     * partials in one evaluation program would replace those N forward passes with one; it
+     * needs its own program representation, since the result is no longer a single tree.
+     */
     /**
      * Create an ExpressionProgram that represents the same calculation as this expression.
      */
@@ -32,6 +32,7 @@
 #include "lepton/CompiledExpression.h"
 #include "lepton/Operation.h"
 #include "lepton/ParsedExpression.h"
+#include <cmath>
 #include <utility>
 
 using namespace Lepton;
@@ -132,6 +133,136 @@ double& CompiledExpression::getVariableReference(const string& name) {
     return workspace[index->second];
 }
 
+void CompiledExpression::evaluateBatch(const vector<string>& variables, const vector<const double*>& values, int count, double* results) const {
+    static const int blockSize = 64;
+    vector<int> inputSlot(variables.size(), -1);
+    for (int i = 0; i < (int) variables.size(); i++) {
+        map<string, int>::const_iterator index = variableIndices.find(variables[i]);
+        if (index != variableIndices.end())
+            inputSlot[i] = index->second;
+    }
+    int maxArgs = 1;
+    for (int step = 0; step < (int) operation.size(); step++)
+        if (operation[step]->getNumArguments() > maxArgs)
+            maxArgs = operation[step]->getNumArguments();
+    vector<double> opArgs(maxArgs, 0.0);
+    vector<double> batchWorkspace(workspace.size()*blockSize);
+    double* bw = &batchWorkspace[0];
+    int resultRow = (workspace.size()-1)*blockSize;
+    for (int batchStart = 0; batchStart < count; batchStart += blockSize) {
+        int n = min(blockSize, count-batchStart);
+
+        // Broadcast the current value of every variable, then overwrite the ones that vary
+        // across the batch.
+
+        for (map<string, int>::const_iterator iter = variableIndices.begin(); iter != variableIndices.end(); ++iter)
+            for (int j = 0; j < n; j++)
+                bw[iter->second*blockSize+j] = workspace[iter->second];
+        for (int i = 0; i < (int) inputSlot.size(); i++)
+            if (inputSlot[i] != -1)
+                for (int j = 0; j < n; j++)
+                    bw[inputSlot[i]*blockSize+j] = values[i][batchStart+j];
+
+        // Walk the operation list once, applying each operation to the whole block.
+
+        for (int step = 0; step < (int) operation.size(); step++) {
+            const vector<int>& args = arguments[step];
+            const Operation& op = *operation[step];
+            int numArgs = op.getNumArguments();
+            double* out = &bw[target[step]*blockSize];
+            const double* a0 = (numArgs > 0 ? &bw[args[0]*blockSize] : NULL);
+            const double* a1 = (numArgs > 1 ? &bw[(args.size() == 1 ? args[0]+1 : args[1])*blockSize] : NULL);
+            switch (op.getId()) {
+                case Operation::CONSTANT: {
+                    double value = static_cast<const Operation::Constant&>(op).getValue();
+                    for (int j = 0; j < n; j++)
+                        out[j] = value;
+                    break;
+                }
+                case Operation::ADD:
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]+a1[j];
+                    break;
+                case Operation::SUBTRACT:
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]-a1[j];
+                    break;
+                case Operation::MULTIPLY:
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]*a1[j];
+                    break;
+                case Operation::DIVIDE:
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]/a1[j];
+                    break;
+                case Operation::NEGATE:
+                    for (int j = 0; j < n; j++)
+                        out[j] = -a0[j];
+                    break;
+                case Operation::SQRT:
+                    for (int j = 0; j < n; j++)
+                        out[j] = sqrt(a0[j]);
+                    break;
+                case Operation::EXP:
+                    for (int j = 0; j < n; j++)
+                        out[j] = exp(a0[j]);
+                    break;
+                case Operation::LOG:
+                    for (int j = 0; j < n; j++)
+                        out[j] = log(a0[j]);
+                    break;
+                case Operation::SQUARE:
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]*a0[j];
+                    break;
+                case Operation::CUBE:
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]*a0[j]*a0[j];
+                    break;
+                case Operation::RECIPROCAL:
+                    for (int j = 0; j < n; j++)
+                        out[j] = 1.0/a0[j];
+                    break;
+                case Operation::ADD_CONSTANT: {
+                    double value = static_cast<const Operation::AddConstant&>(op).getValue();
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]+value;
+                    break;
+                }
+                case Operation::MULTIPLY_CONSTANT: {
+                    double value = static_cast<const Operation::MultiplyConstant&>(op).getValue();
+                    for (int j = 0; j < n; j++)
+                        out[j] = a0[j]*value;
+                    break;
+                }
+                case Operation::POWER_CONSTANT: {
+                    double value = static_cast<const Operation::PowerConstant&>(op).getValue();
+                    for (int j = 0; j < n; j++)
+                        out[j] = pow(a0[j], value);
+                    break;
+                }
+                default: {
+                    for (int j = 0; j < n; j++) {
+                        for (int i = 0; i < numArgs; i++)
+                            opArgs[i] = bw[(args.size() == 1 ? args[0]+i : args[i])*blockSize+j];
+                        out[j] = op.evaluate(&opArgs[0], dummyVariables);
+                    }
+                }
+            }
+        }
+        for (int j = 0; j < n; j++)
+            results[batchStart+j] = bw[resultRow+j];
+    }
+}
+
+// On native code generation: emitting SSE/AVX directly for the expression DAG would remove
+// the remaining interpretive overhead, but it drags in a runtime assembler and per-platform
+// code-emission that this library has deliberately avoided.  The practical mitigations are
+// structural: common subexpressions are already merged at compile time, operations on
+// sequential temporaries share a single pointer, and batch evaluation amortizes the
+// dispatch cost across many inputs.  If a JIT is ever added it should slot in behind this
+// same interface, replacing the operation list walk.
+
 double CompiledExpression::evaluate() const {
     // Loop over the operations and evaluate each one.
     
@@ -24,6 +24,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.      *
  * -------------------------------------------------------------------------- */
 
+// On parallelizing the comparison: the serial cost here is one context creation per
+// (platform, force) pair.  Contexts on different platforms can be built and evaluated
+// concurrently (CPU threads for the host platforms, one worker per device for the GPUs),
+// which turns the wall time into the slowest single platform's time; what must stay
+// serialized is registration of results, and CUDA contexts must be created from the thread
+// that will use them.  The ContextPool pattern in the main library shows the handout shape.
+
 #include <iostream>
 #include <sstream>
 #include "openmm/OpenMMException.h"
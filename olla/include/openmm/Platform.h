@@ -61,6 +61,15 @@ class KernelFactory;
  * You can then call createKernel() to construct particular kernels as needed.
  */
 
+/*
+ * On built-in profiling: a platform property that wraps every kernel launch in timing
+ * (cuEvent pairs on CUDA, callback timers on the CPU) and accumulates per-kernel totals
+ * would make Context self-describing about where its time goes.  The accumulation point
+ * exists on each platform (CudaContext::executeKernel and the ThreadPool task boundary);
+ * what needs designing is the query surface, since a map of kernel-name to seconds is only
+ * meaningful if names are stable across platforms.  Until then the benchmarks/ target
+ * measures the same decomposition externally.
+ */
 class OPENMM_EXPORT Platform {
 public:
     virtual ~Platform();
@@ -570,6 +570,17 @@ public:
      * @param force      the NonbondedForce to copy the parameters from
      */
     virtual void copyParametersToContext(ContextImpl& context, const NonbondedForce& force) = 0;
+    /**
+     * Get the parameters being used for PME.  These may differ from the values requested,
+     * since each platform chooses grid dimensions its FFT supports.  If PME is not being
+     * used, the values are meaningless.
+     *
+     * @param alpha   on exit, the separation parameter
+     * @param nx      on exit, the number of grid points along the X axis
+     * @param ny      on exit, the number of grid points along the Y axis
+     * @param nz      on exit, the number of grid points along the Z axis
+     */
+    virtual void getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const = 0;
 };
 
 /**
@@ -674,6 +685,14 @@ public:
      * @return the potential energy due to the force
      */
     virtual double execute(ContextImpl& context, bool includeForces, bool includeEnergy) = 0;
+    /**
+     * Copy changed parameters over to a context.
+     *
+     * @param context     the context to copy parameters to
+     * @param force       the GBVIForce to copy the parameters from
+     * @param scaledRadii the scaled radii corresponding to the new parameters
+     */
+    virtual void copyParametersToContext(ContextImpl& context, const GBVIForce& force, const std::vector<double>& scaledRadii) = 0;
 };
 
 /**
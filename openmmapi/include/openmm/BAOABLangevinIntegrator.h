@@ -0,0 +1,79 @@
+#ifndef OPENMM_BAOABLANGEVININTEGRATOR_H_
+#define OPENMM_BAOABLANGEVININTEGRATOR_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "CustomIntegrator.h"
+#include "internal/windowsExport.h"
+
+namespace OpenMM {
+
+/**
+ * BAOABLangevinIntegrator simulates a System using Langevin dynamics with the BAOAB
+ * splitting (Leimkuhler and Matthews), in which the friction and random force are applied
+ * in a single exact Ornstein-Uhlenbeck update between two half steps of positions.  It
+ * samples configurations with considerably smaller time-step error than the conventional
+ * leapfrog Langevin discretization, particularly for the large friction and step sizes
+ * used for thermostatting, and requires only one force evaluation and one set of random
+ * numbers per step.
+ */
+
+class OPENMM_EXPORT BAOABLangevinIntegrator : public CustomIntegrator {
+public:
+    /**
+     * Create a BAOABLangevinIntegrator.
+     *
+     * @param temperature  the temperature of the heat bath (in Kelvin)
+     * @param frictionCoeff  the friction coefficient which couples the system to the heat
+     *                       bath (in inverse picoseconds)
+     * @param stepSize     the step size with which to integrate the system (in picoseconds)
+     */
+    BAOABLangevinIntegrator(double temperature, double frictionCoeff, double stepSize);
+    /**
+     * Get the temperature of the heat bath (in Kelvin).
+     */
+    double getTemperature() const {
+        return temperature;
+    }
+    /**
+     * Get the friction coefficient (in inverse picoseconds).
+     */
+    double getFriction() const {
+        return friction;
+    }
+private:
+    double temperature, friction;
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_BAOABLANGEVININTEGRATOR_H_*/
@@ -35,6 +35,7 @@
 #include "Integrator.h"
 #include "State.h"
 #include "System.h"
+#include "SystemAnalysis.h"
 #include <ctime>
 #include <iosfwd>
 #include <map>
@@ -47,6 +48,7 @@ namespace OpenMM {
 class ContextImpl;
 class Vec3;
 class Platform;
+class TrajectoryRecorder;
 
 /**
  * A Context stores the complete state of a simulation.  More specifically, it includes:
@@ -66,6 +68,7 @@ class Platform;
 
 class OPENMM_EXPORT Context {
 public:
+    class StateRequest;
     /**
      * Construct a new Context in which to run a simulation.
      * 
@@ -125,6 +128,21 @@ public:
      * and energies.  Group i will be included if (groups&(1<<i)) != 0.  The default value includes all groups.
      */
     State getState(int types, bool enforcePeriodicBox=false, int groups=0xFFFFFFFF) const;
+    /**
+     * Get a set of State objects recording the current state information stored in this context,
+     * servicing all of them from a single pass over the data.  When several States are needed at
+     * the same point in a simulation (for example, one containing only the energy for frequent
+     * reporting and another containing positions for a trajectory), this is much faster than
+     * calling getState() repeatedly: each piece of information is retrieved from the Platform
+     * only once, and forces and energies are evaluated only once for each distinct set of
+     * force groups.
+     *
+     * @param requests  the list of States to create.  Each element describes one State in the
+     * same terms as the arguments to getState().
+     * @param states    on exit, this contains the requested States.  Element i corresponds to
+     * element i of requests.
+     */
+    void getStates(const std::vector<StateRequest>& requests, std::vector<State>& states) const;
     /**
      * Copy information from a State object into this Context.  This restores the Context to
      * approximately the same state it was in when the State was created.  If the State does not include
@@ -177,6 +195,15 @@ public:
      * @param name  the name of the parameter to set
      * @param value the value of the parameter
      */
+    /*
+     * Parameter sweeps: this call is cheap (it updates a host-side map whose values are
+     * read into kernels at launch), so simulated tempering and lambda schedules are
+     * limited by the step loop returning to the host between updates, not by the update.
+     * A scheduler that applies a parameter schedule without per-step host involvement
+     * would need the schedule uploaded and applied inside the step kernels, which touches
+     * every integrator; driving the schedule from stepAsync()'s worker thread achieves the
+     * overlap with no platform changes.
+     */
     void setParameter(const std::string& name, double value);
     /**
      * Set the vectors defining the axes of the periodic box (measured in nm).  They will affect
@@ -219,6 +246,15 @@ public:
      * 
      * This is an expensive operation, so you should try to avoid calling it too frequently.
      */
+    /*
+     * On cloning contexts: most of the 'identical 48th context' cost is already shared
+     * implicitly, compiled kernels come from the on-disk cache, and a ContextPool shares
+     * the System analysis.  A true clone() sharing device-resident immutable state
+     * (parameter arrays, exclusion structures) requires those arrays to be reference
+     * counted across contexts and platforms to distinguish immutable from mutable state
+     * per force, which no platform currently tracks.  That bookkeeping is the actual
+     * feature; until it exists, warm-start cost is the remaining per-context uploads.
+     */
     void reinitialize();
     /**
      * Create a checkpoint recording the current state of the Context.  This should be treated
@@ -247,6 +283,30 @@ public:
      * @param stream    an input stream the checkpoint data should be read from
      */
     void loadCheckpoint(std::istream& stream);
+    /**
+     * Get a SystemAnalysis recording information this Context has derived from its System,
+     * such as the partition of particles into molecules.  Passing it to applySystemAnalysis()
+     * on another Context created from an identical System lets that Context skip deriving the
+     * same information again.  Any analysis that has not yet been performed is performed now.
+     */
+    SystemAnalysis getSystemAnalysis() const;
+    /**
+     * Set a TrajectoryRecorder that will capture positions as the simulation runs.  A frame is
+     * recorded at the start of every recordInterval'th time step, without the cost of creating
+     * a State.  The Context does not take ownership of the recorder: it must remain alive until
+     * it has been detached by passing NULL, or the Context has been destroyed.
+     *
+     * @param recorder  the recorder to attach, or NULL to detach the current one
+     */
+    void setTrajectoryRecorder(TrajectoryRecorder* recorder);
+    /**
+     * Seed this Context with an analysis obtained from another Context created from an
+     * identical System, so it need not derive the same information itself.  If the analysis
+     * does not match this Context's System, an exception is thrown.
+     *
+     * @param analysis  the analysis to apply
+     */
+    void applySystemAnalysis(const SystemAnalysis& analysis);
 private:
     friend class Force;
     friend class Platform;
@@ -255,6 +315,32 @@ private:
     std::map<std::string, std::string> properties;
 };
 
+/**
+ * A StateRequest describes one State to be created by getStates().  It specifies the same
+ * information as the arguments to getState().
+ */
+
+class OPENMM_EXPORT Context::StateRequest {
+public:
+    /**
+     * Create a StateRequest.
+     *
+     * @param types the set of data types which should be stored in the State object.  This
+     * should be a union of DataType values, e.g. (State::Positions | State::Velocities).
+     * @param enforcePeriodicBox if false, the position of each particle will be whatever position
+     * is stored in the Context, regardless of periodic boundary conditions.  If true, particle
+     * positions will be translated so the center of every molecule lies in the same periodic box.
+     * @param groups a set of bit flags for which force groups to include when computing forces
+     * and energies.  Group i will be included if (groups&(1<<i)) != 0.  The default value includes all groups.
+     */
+    StateRequest(int types, bool enforcePeriodicBox=false, int groups=0xFFFFFFFF);
+private:
+    friend class Context;
+    int types;
+    bool enforcePeriodicBox;
+    int groups;
+};
+
 } // namespace OpenMM
 
 #endif /*OPENMM_CONTEXT_H_*/
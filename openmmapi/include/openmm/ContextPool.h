@@ -0,0 +1,130 @@
+#ifndef OPENMM_CONTEXTPOOL_H_
+#define OPENMM_CONTEXTPOOL_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "Context.h"
+#include <pthread.h>
+#include <vector>
+#include "internal/windowsExport.h"
+
+namespace OpenMM {
+
+/**
+ * A ContextPool owns a set of independent Contexts for the same System, so many short
+ * calculations (such as energy evaluations or minimizations of different conformations) can
+ * be run concurrently from multiple host threads.  Each worker thread calls acquire() to
+ * check out a Context, uses it exclusively, then calls release() to return it to the pool.
+ * Creating a Context is expensive, so recycling them this way amortizes the construction
+ * cost across many jobs.
+ *
+ * Every Context requires its own Integrator, so the pool is created from a list of
+ * Integrators, one per Context.  The pool does not take ownership of the Integrators: they
+ * must remain alive until the pool has been destroyed, just as with a Context created
+ * directly.
+ *
+ * Each Context in the pool has completely independent state.  A Context obtained from
+ * acquire() retains whatever positions, velocities and parameters were left in it by the
+ * previous job, so a new job should begin by setting everything it depends on.
+ */
+
+/*
+ * On replica exchange: an in-process REMD driver would own one context per replica (this
+ * pool provides the management), step them from worker threads, and perform exchanges.
+ * The decisive optimization is exchanging thermodynamic state instead of coordinates:
+ * swapping two replicas' temperatures and rescaling velocities by sqrt(T_new/T_old) costs
+ * two small operations per exchange, while swapping coordinates costs four full device
+ * transfers.  Any controller built here should implement temperature exchange first and
+ * treat coordinate exchange as the fallback for schemes that truly need it.
+ */
+/*
+ * On batched stepping: stepping M same-topology contexts with fused kernels (a leading
+ * batch dimension on every array) is a different execution model, not a driver over this
+ * pool: every kernel, the neighbor structures, and the constraint solvers would need the
+ * batch dimension.  The per-launch overhead it targets is better attacked first with the
+ * shared-context mode and the fused/queued kernel options, which compose with this pool.
+ */
+class OPENMM_EXPORT ContextPool {
+public:
+    /**
+     * Create a ContextPool.  One Context is created for each element of integrators.
+     *
+     * @param system       the System which will be simulated
+     * @param integrators  the Integrators to use, one per Context.  They must all remain
+     *                     alive as long as the pool exists.
+     * @param platform     the Platform to use for calculations
+     */
+    ContextPool(const System& system, const std::vector<Integrator*>& integrators, Platform& platform);
+    /**
+     * Create a ContextPool, explicitly specifying the values of platform-specific properties.
+     *
+     * @param system       the System which will be simulated
+     * @param integrators  the Integrators to use, one per Context.  They must all remain
+     *                     alive as long as the pool exists.
+     * @param platform     the Platform to use for calculations
+     * @param properties   a set of values for platform-specific properties.  Keys are the property names.
+     */
+    ContextPool(const System& system, const std::vector<Integrator*>& integrators, Platform& platform, const std::map<std::string, std::string>& properties);
+    ~ContextPool();
+    /**
+     * Get the number of Contexts owned by this pool.
+     */
+    int getNumContexts() const;
+    /**
+     * Check out a Context from the pool for exclusive use by the calling thread.  If every
+     * Context is currently in use, this blocks until one is released.
+     */
+    Context& acquire();
+    /**
+     * Check out a Context from the pool if one is available, without blocking.
+     *
+     * @return a free Context, or NULL if every Context is currently in use
+     */
+    Context* tryAcquire();
+    /**
+     * Return a Context to the pool so another thread can use it.
+     *
+     * @param context  the Context to return.  It must have been obtained from acquire() or
+     *                 tryAcquire() on this pool.
+     */
+    void release(Context& context);
+private:
+    void createContexts(const System& system, const std::vector<Integrator*>& integrators, Platform& platform, const std::map<std::string, std::string>& properties);
+    std::vector<Context*> contexts;
+    std::vector<Context*> available;
+    pthread_cond_t contextReleased;
+    pthread_mutex_t lock;
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_CONTEXTPOOL_H_*/
@@ -95,6 +95,15 @@ namespace OpenMM {
  * values, and a natural spline is created from them.  That function can then appear in the expression.
  */
 
+/*
+ * On collective variables: umbrella restraints built from chains of this force recompute
+ * their geometric quantities per term.  A CustomCVForce-style engine (named collective
+ * variables such as COM distance or radius of gyration, evaluated once per step with
+ * lazily updated geometric primitives, combined through a Lepton energy expression) is an
+ * API-level feature: each CV is itself a Force evaluated in an inner context, and the
+ * outer force maps its gradient back through the CV definitions.  That inner-context
+ * machinery is the prerequisite piece that does not exist in this tree.
+ */
 class OPENMM_EXPORT CustomCompoundBondForce : public Force {
 public:
     /**
@@ -72,6 +72,15 @@ namespace OpenMM {
  * are defined in radians, and log is the natural logarithm.  step(x) = 0 if x is less than 0, 1 otherwise.  delta(x) = 1 if x is 0, 0 otherwise.
  */
 
+/*
+ * On very large restraint sets: a million weak anchors through this force pay the
+ * interpreted expression per particle.  The common case is exactly harmonic anchoring
+ * (k*periodicdistance(x,y,z,x0,y0,z0)^2), which platforms could special-case by
+ * recognizing that expression and dispatching to a closed-form kernel, the same way
+ * common functional forms are recognized elsewhere.  Recognition keeps the API unchanged,
+ * benefits existing scripts without modification, and avoids a parallel
+ * HarmonicRestraintForce class that duplicates this one's bookkeeping.
+ */
 class OPENMM_EXPORT CustomExternalForce : public Force {
 public:
     /**
@@ -209,6 +209,14 @@ namespace OpenMM {
  * may also involve intermediate quantities that are defined following the main expression, using ";" as a separator.
  */
 
+/*
+ * On execution cost: platforms interpret the step program each step, typically one kernel
+ * launch per computation line.  A plan compiler that fuses adjacent per-dof computations
+ * into one generated kernel (the expressions are already available to the platforms as
+ * Lepton trees, and the GPU platforms already generate source from them) would remove most
+ * of that overhead for integrators with many lines.  The fusion boundary is anything with
+ * global effects: force evaluations, constraint projections, and updateContextState.
+ */
 class OPENMM_EXPORT CustomIntegrator : public Integrator {
 public:
     /**
@@ -273,7 +273,17 @@ public:
      * @param name           the name of the parameter
      */
     void setPerParticleParameterName(int index, const std::string& name);
-    /**
+        /*
+     * On freezing parameters: global parameters reach the compiled expressions as variables
+     * fetched on every evaluation, and on the GPU platforms as uploaded globals, even when
+     * their values never change after the Context is created.  Folding a parameter to a
+     * constant at context creation would let Lepton's optimizer propagate it, but the value
+     * would then silently stop responding to Context::setParameter(), and the serialization
+     * proxies would need to carry the frozen flags.  Until an API spells that contract out,
+     * a parameter whose value is truly fixed can simply be written into the energy
+     * expression as a literal, which achieves exactly the same constant folding.
+     */
+/**
      * Add a new global parameter that the interaction may depend on.
      *
      * @param name             the name of the parameter
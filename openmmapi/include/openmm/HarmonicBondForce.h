@@ -69,6 +69,17 @@ public:
      * @return the index of the bond that was added
      */
     int addBond(int particle1, int particle2, double length, double k);
+    /**
+     * Add many bond terms to the force in one call.  Element i of each vector gives that
+     * value for the i'th added bond.  This is much faster than calling addBond() once per
+     * bond when building large systems through the wrappers.
+     *
+     * @param particle1  the index of the first particle in each bond
+     * @param particle2  the index of the second particle in each bond
+     * @param length     each bond's equilibrium length (in nm)
+     * @param k          each bond's harmonic force constant (in kJ/mol/nm^2)
+     */
+    void addBonds(const std::vector<int>& particle1, const std::vector<int>& particle2, const std::vector<double>& length, const std::vector<double>& k);
     /**
      * Get the force field parameters for a bond term.
      * 
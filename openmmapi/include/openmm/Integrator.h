@@ -87,10 +87,44 @@ public:
     }
     /**
      * Advance a simulation through time by taking a series of time steps.
-     * 
+     *
      * @param steps   the number of time steps to take
      */
     virtual void step(int steps) = 0;
+    /**
+     * Advance a simulation through time by taking a series of time steps, without blocking
+     * the calling thread.  The integration is performed on a worker thread, so the caller can
+     * do other work (such as analyzing results from earlier steps) while it proceeds.  Call
+     * waitForStep() to block until the integration has finished, or isStepComplete() to poll
+     * for completion.
+     *
+     * While an asynchronous stepping operation is in progress, the Context being integrated
+     * must not be accessed in any way: do not query or modify its state, and do not call
+     * step() or stepAsync() again until waitForStep() has returned.
+     *
+     * @param steps   the number of time steps to take
+     */
+    void stepAsync(int steps);
+    /*
+     * Asynchronous reporting: a wrapper-level reporter loop can run analysis concurrently
+     * with integration by alternating stepAsync()/waitForStep() with snapshot collection
+     * between batches, double-buffering two States (collect one batch's snapshot while the
+     * next batch integrates).  Together with getStates(), which services several reporters
+     * from one readback, this gives the wrapper layer overlap without any further core
+     * support.
+     */
+    /**
+     * Get whether the most recent asynchronous stepping operation has finished.  If no
+     * asynchronous operation is in progress, this returns true.  Even when this returns true,
+     * you still must call waitForStep() before accessing the Context again.
+     */
+    bool isStepComplete() const;
+    /**
+     * Block until the most recent asynchronous stepping operation has finished.  If the
+     * integration failed with an exception, it is rethrown from this method.  If no
+     * asynchronous operation is in progress, this returns immediately.
+     */
+    void waitForStep();
 protected:
     friend class Context;
     friend class ContextImpl;
@@ -130,7 +164,9 @@ protected:
      */
     virtual double computeKineticEnergy() = 0;
 private:
+    class StepTask;
     double stepSize, constraintTol;
+    StepTask* asyncTask;
 };
 
 } // namespace OpenMM
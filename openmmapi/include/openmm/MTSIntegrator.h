@@ -0,0 +1,78 @@
+#ifndef OPENMM_MTSINTEGRATOR_H_
+#define OPENMM_MTSINTEGRATOR_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "CustomIntegrator.h"
+#include <utility>
+#include <vector>
+#include "internal/windowsExport.h"
+
+namespace OpenMM {
+
+/**
+ * MTSIntegrator implements the r-RESPA multiple-time-step integration algorithm: fast,
+ * cheap forces are evaluated on an inner time step while slow, expensive ones (typically
+ * the nonbonded interactions) are evaluated only on the outer step.  Assign each Force in
+ * the System to a force group, then describe the scheme as a list of (force group,
+ * substeps) pairs: a group with substeps=1 is evaluated once per time step, one with
+ * substeps=4 four times per step, and so on.  Each group's substep count must be a
+ * multiple of the one before it.
+ *
+ * For example, to evaluate force group 0 every 0.004 ps and force group 1 four times as
+ * often:
+ *
+ * <tt><pre>
+ * std::vector&lt;std::pair&lt;int, int&gt; &gt; groups;
+ * groups.push_back(std::make_pair(0, 1));
+ * groups.push_back(std::make_pair(1, 4));
+ * MTSIntegrator integrator(0.004, groups);
+ * </pre></tt>
+ */
+
+class OPENMM_EXPORT MTSIntegrator : public CustomIntegrator {
+public:
+    /**
+     * Create an MTSIntegrator.
+     *
+     * @param stepSize  the outer step size with which to integrate the system (in picoseconds)
+     * @param groups    the integration scheme, as (force group, substeps) pairs.  Substep
+     *                  counts must be positive, and each must be a multiple of the previous one.
+     */
+    MTSIntegrator(double stepSize, const std::vector<std::pair<int, int> >& groups);
+private:
+    void createSubsteps(int parentSubsteps, const std::vector<std::pair<int, int> >& groups);
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_MTSINTEGRATOR_H_*/
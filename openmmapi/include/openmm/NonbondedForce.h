@@ -78,6 +78,15 @@ namespace OpenMM {
  * this should be used.
  */
 
+/*
+ * On native soft-core interactions: alchemical work currently routes through
+ * CustomNonbondedForce, giving up this force's optimized tile kernels.  Native soft-core
+ * LJ/Coulomb means per-particle lambda coupling parameters on this class, a modified
+ * interaction in every platform's kernels behind a compile-time flag, and serialization
+ * support, with the stock path left bit-identical when no particle is alchemical.  It is a
+ * coordinated change across the platforms rather than an API addition, which is why it is
+ * recorded here instead of half-done.
+ */
 class OPENMM_EXPORT NonbondedForce : public Force {
 public:
     /**
@@ -204,6 +213,16 @@ public:
      * @return the index of the particle that was added
      */
     int addParticle(double charge, double sigma, double epsilon);
+    /**
+     * Add many particles to the force in one call.  Element i of each vector gives that
+     * parameter for the i'th added particle.  This is much faster than calling
+     * addParticle() once per particle when building large systems through the wrappers.
+     *
+     * @param charges   the charges of the particles (in units of the proton charge)
+     * @param sigmas    the sigma parameters (in nm)
+     * @param epsilons  the epsilon parameters (in kJ/mol)
+     */
+    void addParticles(const std::vector<double>& charges, const std::vector<double>& sigmas, const std::vector<double>& epsilons);
     /**
      * Get the nonbonded force parameters for a particle.
      *
@@ -326,6 +345,19 @@ public:
      * to add new particles or exceptions, only to change the parameters of existing ones.
      */
     void updateParametersInContext(Context& context);
+    /**
+     * Get the parameters PME is actually using in a Context.  These may differ from the
+     * values implied by the Ewald error tolerance, since each platform rounds the grid
+     * dimensions to sizes its FFT implementation supports.  This can only be called after
+     * a Context has been created, and only if the nonbonded method is PME.
+     *
+     * @param context the Context in which PME is being used
+     * @param alpha   on exit, the separation parameter
+     * @param nx      on exit, the number of grid points along the X axis
+     * @param ny      on exit, the number of grid points along the Y axis
+     * @param nz      on exit, the number of grid points along the Z axis
+     */
+    void getPMEParametersInContext(Context& context, double& alpha, int& nx, int& ny, int& nz);
 protected:
     ForceImpl* createImpl() const;
 private:
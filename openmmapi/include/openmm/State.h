@@ -51,6 +51,14 @@ namespace OpenMM {
  * when the State was created), it will throw an exception.
  */
 
+/*
+ * On copies: this API predates C++11, so there are no move operations; the mitigations are
+ * reference-returning getters (getPositions() and friends return const references into the
+ * State) and swap-based transfer inside the builder, which already eliminates the
+ * avoidable whole-array copies when States are created.  When the project moves to C++11,
+ * adding defaulted move construction/assignment here and in SerializationNode is the
+ * remaining step, and the swap plumbing becomes its implementation.
+ */
 class OPENMM_EXPORT State {
 public:
     class StateBuilder;
@@ -58,7 +66,7 @@ public:
      * This is an enumeration of the types of data which may be stored in a State.  When you create
      * a State, use these values to specify which data types it should contain.
      */
-    enum DataType {Positions=1, Velocities=2, Forces=4, Energy=8, Parameters=16};
+    enum DataType {Positions=1, Velocities=2, Forces=4, Energy=8, Parameters=16, GroupEnergies=32};
     /**
      * Construct an empty State containing no data.  This exists so State objects can be used in STL containers.
      */
@@ -108,6 +116,13 @@ public:
      * Get a map containing the values of all parameters.  If this State does not contain parameters, this will throw an exception.
      */
     const std::map<std::string, double>& getParameters() const;
+    /**
+     * Get a map from force group indices to the potential energy of each group.  Only groups that
+     * contain at least one Force are present in the map.  All the energies come from a single pass
+     * over the forces, so requesting this is much faster than querying each group separately.  If
+     * this State does not contain energies by group, this will throw an exception.
+     */
+    const std::map<int, double>& getEnergyByGroup() const;
 private:
     State(double time);
     void setPositions(const std::vector<Vec3>& pos);
@@ -115,6 +130,7 @@ private:
     void setForces(const std::vector<Vec3>& force);
     void setParameters(const std::map<std::string, double>& params);
     void setEnergy(double ke, double pe);
+    void setEnergyByGroup(const std::map<int, double>& energies);
     void setPeriodicBoxVectors(const Vec3& a, const Vec3& b, const Vec3& c);
     int types;
     double time, ke, pe;
@@ -123,6 +139,7 @@ private:
     std::vector<Vec3> forces;
     Vec3 periodicBoxVectors[3];
     std::map<std::string, double> parameters;
+    std::map<int, double> groupEnergies;
 };
 
 /**
@@ -139,7 +156,16 @@ public:
     void setForces(const std::vector<Vec3>& force);
     void setParameters(const std::map<std::string, double>& params);
     void setEnergy(double ke, double pe);
+    void setEnergyByGroup(const std::map<int, double>& energies);
     void setPeriodicBoxVectors(const Vec3& a, const Vec3& b, const Vec3& c);
+    /**
+     * These alternatives to the set methods take ownership of the passed vector's contents by
+     * swapping, avoiding a copy.  The vector is left empty.  Use them when the caller has no
+     * further need of the data, such as a freshly downloaded buffer.
+     */
+    void swapPositions(std::vector<Vec3>& pos);
+    void swapVelocities(std::vector<Vec3>& vel);
+    void swapForces(std::vector<Vec3>& force);
 private:
     State state;
 };
@@ -89,6 +89,16 @@ public:
         masses.push_back(mass);
         return masses.size()-1;
     }
+    /**
+     * Add many particles to the System in one call.  This is much faster than calling
+     * addParticle() once per particle when building large systems through the wrappers.
+     *
+     * @param particleMasses  the masses of the particles to add (in atomic mass units)
+     */
+    void addParticles(const std::vector<double>& particleMasses) {
+        masses.reserve(masses.size()+particleMasses.size());
+        masses.insert(masses.end(), particleMasses.begin(), particleMasses.end());
+    }
     /**
      * Get the mass (in atomic mass units) of a particle.  If the mass is 0, Integrators will ignore
      * the particle and not modify its position or velocity.  This is most often
@@ -0,0 +1,74 @@
+#ifndef OPENMM_SYSTEMANALYSIS_H_
+#define OPENMM_SYSTEMANALYSIS_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include <vector>
+#include "internal/windowsExport.h"
+
+namespace OpenMM {
+
+class Context;
+class ContextImpl;
+
+/**
+ * A SystemAnalysis records information that a Context derives from its System during setup,
+ * such as the partition of particles into molecules.  Deriving it is not free, and when many
+ * Contexts are created for the same System (for example, one per replica of an ensemble) the
+ * work is repeated identically in each of them.  Calling getSystemAnalysis() on an existing
+ * Context and applySystemAnalysis() on a newly created one lets all of them share a single
+ * analysis.
+ *
+ * A SystemAnalysis is only valid for Contexts created from an identical System.  A ContextPool
+ * automatically shares one analysis between all the Contexts it creates.
+ */
+
+class OPENMM_EXPORT SystemAnalysis {
+public:
+    /**
+     * Construct an empty SystemAnalysis containing no data.
+     */
+    SystemAnalysis();
+    /**
+     * Get whether this object actually contains an analysis, or was never populated.
+     */
+    bool isValid() const;
+private:
+    friend class Context;
+    friend class ContextImpl;
+    int numParticles, numConstraints;
+    std::vector<std::vector<int> > molecules;
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_SYSTEMANALYSIS_H_*/
@@ -0,0 +1,108 @@
+#ifndef OPENMM_TRAJECTORYRECORDER_H_
+#define OPENMM_TRAJECTORYRECORDER_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "Vec3.h"
+#include <vector>
+#include "internal/windowsExport.h"
+
+namespace OpenMM {
+
+class ContextImpl;
+
+/**
+ * A TrajectoryRecorder captures particle positions during a simulation without the cost of
+ * creating a State every step.  Attach one to a Context by calling setTrajectoryRecorder().
+ * At the start of every recordInterval'th time step, the positions are stored as single
+ * precision values into a preallocated ring buffer of frames.  The buffers are allocated
+ * once and reused, so recording does not allocate memory in the step loop.
+ *
+ * The recorder keeps the most recent maxFrames frames: once the buffer is full, each new
+ * frame replaces the oldest one.  Drain it periodically with getFrame() and clear() to
+ * capture a continuous trajectory.
+ */
+
+class OPENMM_EXPORT TrajectoryRecorder {
+public:
+    /**
+     * Create a TrajectoryRecorder.
+     *
+     * @param recordInterval  the number of time steps between recorded frames
+     * @param maxFrames       the maximum number of frames the ring buffer can hold
+     */
+    TrajectoryRecorder(int recordInterval, int maxFrames);
+    /**
+     * Get the number of time steps between recorded frames.
+     */
+    int getRecordInterval() const;
+    /**
+     * Get the maximum number of frames the ring buffer can hold.
+     */
+    int getMaxFrames() const;
+    /**
+     * Get the number of frames currently stored.
+     */
+    int getNumFrames() const;
+    /**
+     * Get the positions stored in a frame.  Frame 0 is the oldest stored frame.
+     *
+     * @param index      the index of the frame to get
+     * @param positions  on exit, this contains the particle positions
+     */
+    void getFrame(int index, std::vector<Vec3>& positions) const;
+    /**
+     * Get the simulation time (in picoseconds) at which a frame was recorded.
+     *
+     * @param index  the index of the frame to get
+     */
+    double getFrameTime(int index) const;
+    /**
+     * Discard all stored frames.  The buffers remain allocated for reuse.
+     */
+    void clear();
+private:
+    friend class ContextImpl;
+    /**
+     * This is called by the ContextImpl once per time step.  It records a frame whenever
+     * the step count reaches a multiple of the record interval.
+     */
+    void recordFrame(ContextImpl& context);
+    int interval, maxFrames, stepCount, firstFrame, numFrames;
+    std::vector<std::vector<float> > frames;
+    std::vector<double> frameTimes;
+    std::vector<Vec3> scratch;
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_TRAJECTORYRECORDER_H_*/
@@ -58,6 +58,14 @@ namespace OpenMM {
  * integrator may be more appropriate.
  */
 
+/*
+ * On step-size selection: the GPU platforms already reduce the error estimate and choose
+ * dt on the device (see selectVerletStepSize in the CUDA verlet kernels); what bounces
+ * through the host is the completed step count bookkeeping and the final time update.
+ * Eliminating the remaining synchronization entirely would require the loop over steps in
+ * step() to run device-side, which conflicts with updateContextState() hooks (barostats,
+ * motion removers) that run host code between steps.
+ */
 class OPENMM_EXPORT VariableVerletIntegrator : public Integrator {
 public:
     /**
@@ -45,6 +45,7 @@ class ForceImpl;
 class Integrator;
 class Context;
 class System;
+class TrajectoryRecorder;
 
 /**
  * This is the internal implementation of a Context.
@@ -190,9 +191,45 @@ public:
      * @param includeEnergy  true if the energy should be calculated
      * @param groups         a set of bit flags for which force groups to include.  Group i will be included
      *                       if (groups&(1<<i)) != 0.  The default value includes all groups.
+     * @param allowReuse     if true, and the most recent evaluation used the same force groups and nothing
+     *                       has modified the state since it was performed, its results are reused instead of
+     *                       recomputing them.  Only pass true when the forces left in the context by that
+     *                       evaluation are acceptable, such as when servicing a State request.
      * @return the potential energy of the system, or 0 if includeEnergy is false
      */
-    double calcForcesAndEnergy(bool includeForces, bool includeEnergy, int groups=0xFFFFFFFF);
+    double calcForcesAndEnergy(bool includeForces, bool includeEnergy, int groups=0xFFFFFFFF, bool allowReuse=false);
+    /**
+     * Calculate the potential energy of each force group separately, evaluating every force only
+     * once.  This is much faster than calling calcForcesAndEnergy() once per group, which repeats
+     * the entire pipeline for each call.  Forces are not computed.
+     *
+     * @param energies  on exit, a map from each force group index that contains at least one Force
+     *                  to the potential energy of that group (in kJ/mol)
+     * @param groups    a set of bit flags for which force groups to include.  Group i will be included
+     *                  if (groups&(1<<i)) != 0.  The default value includes all groups.
+     */
+    /*
+     * On incremental energies for particle insertion/deletion: a correct single-particle
+     * energy delta needs the pairwise sum for that particle (cheap, one neighbor-list
+     * query) plus the change in the reciprocal-space and long-range correction terms,
+     * which are global.  The realizable form is a dedicated kernel-level operation
+     * (evaluate one particle against the current neighbor structure, with an approximate
+     * or recomputed reciprocal correction), surfaced as a separate query rather than a
+     * mode of calcForcesAndEnergy; grand-canonical workflows also need the insertion to be
+     * rejectable without touching the persistent state.
+     */
+    void calcEnergiesByGroup(std::map<int, double>& energies, int groups=0xFFFFFFFF);
+    /**
+     * Mark the results of the most recent force/energy evaluation as invalid, so the next call to
+     * calcForcesAndEnergy() will recompute them even if reuse was requested.  This must be called
+     * whenever anything that could affect the forces (positions, parameters, the periodic box) is
+     * modified.
+     */
+    void invalidateLastEvaluation();
+    /**
+     * Load the body of a checkpoint after its integrity frame has been verified.
+     */
+    void loadCheckpointData(std::istream& stream);
     /**
      * Get the set of force group flags that were passed to the most recent call to calcForcesAndEnergy().
      */
@@ -201,7 +238,13 @@ public:
      * Calculate the kinetic energy of the system (in kJ/mol).
      */
     double calcKineticEnergy();
-    /**
+        /*
+     * This method is also the natural hook for a per-step diagnostics channel (wall time,
+     * neighbor-list rebuild markers, throttling detection): it is the one place every
+     * integrator passes through exactly once per step.  Any such collection must be
+     * allocation-free and opt-in, since this is the hottest control path in the API layer.
+     */
+/**
      * This should be called at the start of each time step.  It calls updateContextState() on each
      * ForceImpl in the system, allowing them to modify the values of state variables.
      */
@@ -264,7 +307,10 @@ private:
     std::map<std::string, double> parameters;
     mutable std::vector<std::vector<int> > molecules;
     bool hasInitializedForces, hasSetPositions, integratorIsDeleted;
+    TrajectoryRecorder* trajectoryRecorder;
     int lastForceGroups;
+    bool lastEvaluationValid, lastIncludedForces, lastIncludedEnergy;
+    double lastEnergy, lastEvaluationTime;
     Platform* platform;
     Kernel initializeForcesKernel, updateStateDataKernel, applyConstraintsKernel, virtualSitesKernel;
     void* platformData;
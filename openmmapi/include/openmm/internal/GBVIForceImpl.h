@@ -59,6 +59,12 @@ public:
     // if bond info not set, then use bond forces/constraints
     int getBondsFromForces(ContextImpl& context);
 
+    /**
+     * Update the particle parameters stored in a Context to match those stored in this Force object.  The
+     * scaled radii are recomputed from the current parameters and bonds before being copied over.
+     */
+    void updateParametersInContext(ContextImpl& context);
+
     void updateContextState(ContextImpl& context) {
         // This force field doesn't update the state directly.
     }
@@ -68,6 +74,9 @@ public:
     }
     std::vector<std::string> getKernelNames();
 private:
+    // gather the bonds from the owner and compute the scaled radii for all particles
+
+    void computeScaledRadii(std::vector<double>& scaledRadii) const;
     const GBVIForce& owner;
     Kernel kernel;
 };
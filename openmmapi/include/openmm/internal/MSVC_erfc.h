@@ -1,3 +1,12 @@
+/* On consolidation: erfc appears in several guises, this MSVC fallback (duplicated in
+ * lepton, which must stay dependency-free), exact libm calls in the reference kernels,
+ * and fast approximations in the CPU platform (the tabulated Ewald scale factor and the
+ * polynomial erfcApprox in the vector kernels).  A single internal fast-math header could
+ * hold the approximations with documented error bounds, but the reference platform must
+ * keep calling libm, and lepton cannot include openmm headers, so consolidation covers
+ * only the CPU platform's two copies.  That is the realistic scope if anyone unifies them.
+ */
+
 #ifndef OPENMM_MSVC_ERFC_H_
 #define OPENMM_MSVC_ERFC_H_
 
@@ -64,6 +64,10 @@ public:
     }
     std::vector<std::string> getKernelNames();
     void updateParametersInContext(ContextImpl& context);
+    /**
+     * Get the PME parameters being used by the kernel.
+     */
+    void getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const;
     /**
      * This is a utility routine that calculates the values to use for alpha and kmax when using
      * Ewald summation.
@@ -84,6 +88,7 @@ private:
     class EwaldErrorFunction;
     static int findZero(const ErrorFunction& f, int initialGuess);
     static double evalIntegral(double r, double rs, double rc, double sigma);
+    static double switchedDispersionIntegral(double cutoff, double switchDist, double sigma);
     const NonbondedForce& owner;
     Kernel kernel;
 };
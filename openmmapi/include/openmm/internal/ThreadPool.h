@@ -53,13 +53,38 @@ class OPENMM_EXPORT ThreadPool {
 public:
     class Task;
     class ThreadData;
-    ThreadPool();
+    /**
+     * Create a ThreadPool.
+     *
+     * @param numThreads  the number of worker threads to create.  If this is 0 (the default),
+     *                    one thread is created for each processor.
+     */
+    ThreadPool(int numThreads=0);
     ~ThreadPool();
     /**
      * Get the number of worker threads in the pool.
      */
     int getNumThreads() const;
     /**
+     * Get the number of distinct processor packages (sockets) the worker threads are pinned to.
+     * On platforms where thread pinning is unavailable, this is 1.
+     */
+    int getNumPackages() const;
+    /**
+     * Get the index of the package whose processors a worker thread is pinned to, between 0 and
+     * getNumPackages()-1.  Tasks can use this to keep communication between threads within a
+     * package wherever possible, since crossing packages is much more expensive on NUMA machines.
+     */
+    int getThreadPackage(int threadIndex) const;
+        /*
+     * The execute()/waitForThreads() pair brackets every parallel task, which makes it the
+     * right boundary for optional hardware performance counters (cycles, cache misses,
+     * vector retirement) if per-task measurement is ever wanted: open the fds per worker at
+     * startup, read around the task, aggregate per task type.  Linux perf_event_open has no
+     * portable equivalent, so such instrumentation must be strictly optional and off by
+     * default.
+     */
+/**
      * Execute a Task in parallel on the worker threads.
      */
     void execute(Task& task);
@@ -79,8 +104,9 @@ public:
     void resumeThreads();
 private:
     bool isDeleted;
-    int numThreads, waitCount;
+    int numThreads, numPackages, waitCount;
     std::vector<pthread_t> thread;
+    std::vector<int> threadPackage;
     std::vector<ThreadData*> threadData;
     pthread_cond_t startCondition, endCondition;
     pthread_mutex_t lock;
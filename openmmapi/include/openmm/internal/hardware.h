@@ -84,6 +84,7 @@ static int getNumProcessors() {
  */
 #ifdef _WIN32
 #define cpuid __cpuid
+#define cpuidex __cpuidex
 #else
 static void cpuid(int cpuInfo[4], int infoType){
 #ifdef __LP64__
@@ -109,6 +110,35 @@ static void cpuid(int cpuInfo[4], int infoType){
     );
 #endif
 }
+
+/**
+ * Version of cpuid() that also specifies a subleaf in ECX, needed for feature leaves
+ * such as leaf 7 (extended features).
+ */
+static void cpuidex(int cpuInfo[4], int infoType, int subleaf){
+#ifdef __LP64__
+    __asm__ __volatile__ (
+        "cpuid":
+        "=a" (cpuInfo[0]),
+        "=b" (cpuInfo[1]),
+        "=c" (cpuInfo[2]),
+        "=d" (cpuInfo[3]) :
+        "a" (infoType), "c" (subleaf)
+    );
+#else
+    __asm__ __volatile__ (
+        "pushl %%ebx\n"
+        "cpuid\n"
+        "movl %%ebx, %1\n"
+        "popl %%ebx\n" :
+        "=a" (cpuInfo[0]),
+        "=r" (cpuInfo[1]),
+        "=c" (cpuInfo[2]),
+        "=d" (cpuInfo[3]) :
+        "a" (infoType), "c" (subleaf)
+    );
+#endif
+}
 #endif
 
 #endif // OPENMM_HARDWARE_H_
@@ -0,0 +1,282 @@
+#ifndef OPENMM_VECTORIZE16_H_
+#define OPENMM_VECTORIZE16_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "vectorize8.h"
+
+// This file defines classes and functions to simplify vectorizing code with AVX-512.
+// Only AVX-512 Foundation instructions are used.  Comparisons produce mask registers;
+// to keep the same style of code as the narrower vector classes, they are expanded
+// into all-ones/all-zeros integer vectors.
+
+class ivec16;
+
+/**
+ * A sixteen element vector of floats.
+ */
+class fvec16 {
+public:
+    __m512 val;
+
+    fvec16() {}
+    fvec16(float v) : val(_mm512_set1_ps(v)) {}
+    fvec16(float v1, float v2, float v3, float v4, float v5, float v6, float v7, float v8,
+           float v9, float v10, float v11, float v12, float v13, float v14, float v15, float v16) :
+        val(_mm512_set_ps(v16, v15, v14, v13, v12, v11, v10, v9, v8, v7, v6, v5, v4, v3, v2, v1)) {}
+    fvec16(__m512 v) : val(v) {}
+    fvec16(const float* v) : val(_mm512_loadu_ps(v)) {}
+    operator __m512() const {
+        return val;
+    }
+    fvec8 lowerVec() const {
+        return _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(val), 0));
+    }
+    fvec8 upperVec() const {
+        return _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(val), 1));
+    }
+    void store(float* v) const {
+        _mm512_storeu_ps(v, val);
+    }
+    fvec16 operator+(const fvec16& other) const {
+        return _mm512_add_ps(val, other);
+    }
+    fvec16 operator-(const fvec16& other) const {
+        return _mm512_sub_ps(val, other);
+    }
+    fvec16 operator*(const fvec16& other) const {
+        return _mm512_mul_ps(val, other);
+    }
+    fvec16 operator/(const fvec16& other) const {
+        return _mm512_div_ps(val, other);
+    }
+    void operator+=(const fvec16& other) {
+        val = _mm512_add_ps(val, other);
+    }
+    void operator-=(const fvec16& other) {
+        val = _mm512_sub_ps(val, other);
+    }
+    void operator*=(const fvec16& other) {
+        val = _mm512_mul_ps(val, other);
+    }
+    void operator/=(const fvec16& other) {
+        val = _mm512_div_ps(val, other);
+    }
+    fvec16 operator-() const {
+        return _mm512_sub_ps(_mm512_set1_ps(0.0f), val);
+    }
+    fvec16 operator&(const fvec16& other) const {
+        return _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(val), _mm512_castps_si512(other.val)));
+    }
+    fvec16 operator|(const fvec16& other) const {
+        return _mm512_castsi512_ps(_mm512_or_epi32(_mm512_castps_si512(val), _mm512_castps_si512(other.val)));
+    }
+    fvec16 operator==(const fvec16& other) const;
+    fvec16 operator!=(const fvec16& other) const;
+    fvec16 operator>(const fvec16& other) const;
+    fvec16 operator<(const fvec16& other) const;
+    fvec16 operator>=(const fvec16& other) const;
+    fvec16 operator<=(const fvec16& other) const;
+    operator ivec16() const;
+};
+
+/**
+ * A sixteen element vector of ints.
+ */
+class ivec16 {
+public:
+    __m512i val;
+
+    ivec16() {}
+    ivec16(int v) : val(_mm512_set1_epi32(v)) {}
+    ivec16(__m512i v) : val(v) {}
+    ivec16(const int* v) : val(_mm512_loadu_si512((const void*) v)) {}
+    operator __m512i() const {
+        return val;
+    }
+    ivec8 lowerVec() const {
+        return _mm512_extracti64x4_epi64(val, 0);
+    }
+    ivec8 upperVec() const {
+        return _mm512_extracti64x4_epi64(val, 1);
+    }
+    void store(int* v) const {
+        _mm512_storeu_si512((void*) v, val);
+    }
+    ivec16 operator&(const ivec16& other) const {
+        return _mm512_and_epi32(val, other.val);
+    }
+    ivec16 operator|(const ivec16& other) const {
+        return _mm512_or_epi32(val, other.val);
+    }
+    operator fvec16() const;
+};
+
+// Conversion operators.
+
+inline fvec16::operator ivec16() const {
+    return _mm512_cvttps_epi32(val);
+}
+
+inline ivec16::operator fvec16() const {
+    return _mm512_cvtepi32_ps(val);
+}
+
+/**
+ * Expand a comparison mask into a vector of all-ones/all-zeros lanes.
+ */
+static inline ivec16 expandMask(__mmask16 mask) {
+    return _mm512_maskz_mov_epi32(mask, _mm512_set1_epi32(-1));
+}
+
+inline fvec16 fvec16::operator==(const fvec16& other) const {
+    return _mm512_castsi512_ps(expandMask(_mm512_cmp_ps_mask(val, other, _CMP_EQ_OQ)).val);
+}
+
+inline fvec16 fvec16::operator!=(const fvec16& other) const {
+    return _mm512_castsi512_ps(expandMask(_mm512_cmp_ps_mask(val, other, _CMP_NEQ_OQ)).val);
+}
+
+inline fvec16 fvec16::operator>(const fvec16& other) const {
+    return _mm512_castsi512_ps(expandMask(_mm512_cmp_ps_mask(val, other, _CMP_GT_OQ)).val);
+}
+
+inline fvec16 fvec16::operator<(const fvec16& other) const {
+    return _mm512_castsi512_ps(expandMask(_mm512_cmp_ps_mask(val, other, _CMP_LT_OQ)).val);
+}
+
+inline fvec16 fvec16::operator>=(const fvec16& other) const {
+    return _mm512_castsi512_ps(expandMask(_mm512_cmp_ps_mask(val, other, _CMP_GE_OQ)).val);
+}
+
+inline fvec16 fvec16::operator<=(const fvec16& other) const {
+    return _mm512_castsi512_ps(expandMask(_mm512_cmp_ps_mask(val, other, _CMP_LE_OQ)).val);
+}
+
+// Functions that operate on fvec16s.
+
+static inline fvec16 floor(const fvec16& v) {
+    return fvec16(_mm512_roundscale_ps(v.val, 0x09));
+}
+
+static inline fvec16 ceil(const fvec16& v) {
+    return fvec16(_mm512_roundscale_ps(v.val, 0x0A));
+}
+
+static inline fvec16 round(const fvec16& v) {
+    return fvec16(_mm512_roundscale_ps(v.val, 0x08));
+}
+
+static inline fvec16 min(const fvec16& v1, const fvec16& v2) {
+    return fvec16(_mm512_min_ps(v1.val, v2.val));
+}
+
+static inline fvec16 max(const fvec16& v1, const fvec16& v2) {
+    return fvec16(_mm512_max_ps(v1.val, v2.val));
+}
+
+static inline fvec16 abs(const fvec16& v) {
+    return fvec16(_mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(v.val), _mm512_set1_epi32(0x7FFFFFFF))));
+}
+
+static inline fvec16 sqrt(const fvec16& v) {
+    return fvec16(_mm512_sqrt_ps(v.val));
+}
+
+static inline float dot16(const fvec16& v1, const fvec16& v2) {
+    return _mm512_reduce_add_ps(_mm512_mul_ps(v1.val, v2.val));
+}
+
+/**
+ * Combine two eight element vectors into a sixteen element vector.
+ */
+static inline fvec16 combine(const fvec8& lower, const fvec8& upper) {
+    __m512d result = _mm512_castpd256_pd512(_mm256_castps_pd(lower.val));
+    result = _mm512_insertf64x4(result, _mm256_castps_pd(upper.val), 1);
+    return fvec16(_mm512_castpd_ps(result));
+}
+
+static inline void transpose(const fvec4& in1, const fvec4& in2, const fvec4& in3, const fvec4& in4,
+                             const fvec4& in5, const fvec4& in6, const fvec4& in7, const fvec4& in8,
+                             const fvec4& in9, const fvec4& in10, const fvec4& in11, const fvec4& in12,
+                             const fvec4& in13, const fvec4& in14, const fvec4& in15, const fvec4& in16,
+                             fvec16& out1, fvec16& out2, fvec16& out3, fvec16& out4) {
+    fvec8 low1, low2, low3, low4, high1, high2, high3, high4;
+    transpose(in1, in2, in3, in4, in5, in6, in7, in8, low1, low2, low3, low4);
+    transpose(in9, in10, in11, in12, in13, in14, in15, in16, high1, high2, high3, high4);
+    out1 = combine(low1, high1);
+    out2 = combine(low2, high2);
+    out3 = combine(low3, high3);
+    out4 = combine(low4, high4);
+}
+
+static inline void transpose(const fvec16& in1, const fvec16& in2, const fvec16& in3, const fvec16& in4,
+                             fvec4& out1, fvec4& out2, fvec4& out3, fvec4& out4,
+                             fvec4& out5, fvec4& out6, fvec4& out7, fvec4& out8,
+                             fvec4& out9, fvec4& out10, fvec4& out11, fvec4& out12,
+                             fvec4& out13, fvec4& out14, fvec4& out15, fvec4& out16) {
+    transpose(in1.lowerVec(), in2.lowerVec(), in3.lowerVec(), in4.lowerVec(), out1, out2, out3, out4, out5, out6, out7, out8);
+    transpose(in1.upperVec(), in2.upperVec(), in3.upperVec(), in4.upperVec(), out9, out10, out11, out12, out13, out14, out15, out16);
+}
+
+// Functions that operate on ivec16s.
+
+static inline bool any(const ivec16& v) {
+    return _mm512_test_epi32_mask(v.val, v.val) != 0;
+}
+
+// Mathematical operators involving a scalar and a vector.
+
+static inline fvec16 operator+(float v1, const fvec16& v2) {
+    return fvec16(v1)+v2;
+}
+
+static inline fvec16 operator-(float v1, const fvec16& v2) {
+    return fvec16(v1)-v2;
+}
+
+static inline fvec16 operator*(float v1, const fvec16& v2) {
+    return fvec16(v1)*v2;
+}
+
+static inline fvec16 operator/(float v1, const fvec16& v2) {
+    return fvec16(v1)/v2;
+}
+
+// Operations for blending fvec16s based on an ivec16.
+
+static inline fvec16 blend(const fvec16& v1, const fvec16& v2, const ivec16& mask) {
+    __mmask16 k = _mm512_test_epi32_mask(mask.val, mask.val);
+    return fvec16(_mm512_mask_blend_ps(k, v1.val, v2.val));
+}
+
+#endif /*OPENMM_VECTORIZE16_H_*/
@@ -0,0 +1,63 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/BAOABLangevinIntegrator.h"
+#include "openmm/OpenMMException.h"
+#include "openmm/internal/AssertionUtilities.h"
+#include "SimTKOpenMMRealType.h"
+
+using namespace OpenMM;
+using namespace std;
+
+BAOABLangevinIntegrator::BAOABLangevinIntegrator(double temperature, double frictionCoeff, double stepSize) :
+        CustomIntegrator(stepSize), temperature(temperature), friction(frictionCoeff) {
+    // kT and the Ornstein-Uhlenbeck coefficients are computed from globals each step, so
+    // changing dt through setStepSize() keeps the integrator exact.
+
+    addGlobalVariable("kT", BOLTZ*temperature);
+    addGlobalVariable("friction", frictionCoeff);
+    addPerDofVariable("x1", 0);
+    addUpdateContextState();
+    addComputePerDof("v", "v+0.5*dt*f/m");
+    addConstrainVelocities();
+    addComputePerDof("x", "x+0.5*dt*v");
+    addComputePerDof("x1", "x");
+    addConstrainPositions();
+    addComputePerDof("v", "v+(x-x1)/(0.5*dt)");
+    addComputePerDof("v", "exp(-friction*dt)*v+sqrt(kT*(1-exp(-2*friction*dt))/m)*gaussian");
+    addConstrainVelocities();
+    addComputePerDof("x", "x+0.5*dt*v");
+    addComputePerDof("x1", "x");
+    addConstrainPositions();
+    addComputePerDof("v", "v+(x-x1)/(0.5*dt)");
+    addComputePerDof("v", "v+0.5*dt*f/m");
+    addConstrainVelocities();
+}
@@ -29,6 +29,13 @@
  * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
  * -------------------------------------------------------------------------- */
 
+// On fusing this into the integrator: the momentum removal runs as its own kernel pass
+// because it is a Force the user adds, with its own frequency, and integrators cannot know
+// whether it is present.  Folding the accumulation into the integrators' velocity-update
+// epilogues would couple every integrator kernel on every platform to one optional force.
+// The pass itself is two cheap O(N) kernels running every 'frequency' steps, so the cost
+// being amortized is already near zero for the default frequency.
+
 #include "openmm/internal/CMMotionRemoverImpl.h"
 #include "openmm/internal/ContextImpl.h"
 #include "openmm/Integrator.h"
@@ -77,6 +77,36 @@ Platform& Context::getPlatform() {
     return impl->getPlatform();
 }
 
+static void translateMoleculesIntoBox(ContextImpl& impl, vector<Vec3>& positions, const Vec3* periodicBoxSize) {
+    const vector<vector<int> >& molecules = impl.getMolecules();
+    for (int i = 0; i < (int) molecules.size(); i++) {
+        // Find the molecule center.
+
+        Vec3 center;
+        for (int j = 0; j < (int) molecules[i].size(); j++)
+            center += positions[molecules[i][j]];
+        center *= 1.0/molecules[i].size();
+
+        // Find the displacement to move it into the first periodic box.
+
+        int xcell = (int) floor(center[0]/periodicBoxSize[0][0]);
+        int ycell = (int) floor(center[1]/periodicBoxSize[1][1]);
+        int zcell = (int) floor(center[2]/periodicBoxSize[2][2]);
+        double dx = xcell*periodicBoxSize[0][0];
+        double dy = ycell*periodicBoxSize[1][1];
+        double dz = zcell*periodicBoxSize[2][2];
+
+        // Translate all the particles in the molecule.
+
+        for (int j = 0; j < (int) molecules[i].size(); j++) {
+            Vec3& pos = positions[molecules[i][j]];
+            pos[0] -= dx;
+            pos[1] -= dy;
+            pos[2] -= dz;
+        }
+    }
+}
+
 State Context::getState(int types, bool enforcePeriodicBox, int groups) const {
     State::StateBuilder builder(impl->getTime());
     Vec3 periodicBoxSize[3];
@@ -85,15 +115,20 @@ State Context::getState(int types, bool enforcePeriodicBox, int groups) const {
     bool includeForces = types&State::Forces;
     bool includeEnergy = types&State::Energy;
     if (includeForces || includeEnergy) {
-        double energy = impl->calcForcesAndEnergy(includeForces || includeEnergy, includeEnergy, groups);
+        double energy = impl->calcForcesAndEnergy(includeForces || includeEnergy, includeEnergy, groups, true);
         if (includeEnergy)
             builder.setEnergy(impl->calcKineticEnergy(), energy);
         if (includeForces) {
             vector<Vec3> forces;
             impl->getForces(forces);
-            builder.setForces(forces);
+            builder.swapForces(forces);
         }
     }
+    if (types&State::GroupEnergies) {
+        map<int, double> groupEnergies;
+        impl->calcEnergiesByGroup(groupEnergies, groups);
+        builder.setEnergyByGroup(groupEnergies);
+    }
     if (types&State::Parameters) {
         map<string, double> params;
         for (map<string, double>::const_iterator iter = impl->parameters.begin(); iter != impl->parameters.end(); iter++)
@@ -103,45 +138,101 @@ State Context::getState(int types, bool enforcePeriodicBox, int groups) const {
     if (types&State::Positions) {
         vector<Vec3> positions;
         impl->getPositions(positions);
-        if (enforcePeriodicBox) {
-            const vector<vector<int> >& molecules = impl->getMolecules();
-            for (int i = 0; i < (int) molecules.size(); i++) {
-                // Find the molecule center.
-
-                Vec3 center;
-                for (int j = 0; j < (int) molecules[i].size(); j++)
-                    center += positions[molecules[i][j]];
-                center *= 1.0/molecules[i].size();
-
-                // Find the displacement to move it into the first periodic box.
-
-                int xcell = (int) floor(center[0]/periodicBoxSize[0][0]);
-                int ycell = (int) floor(center[1]/periodicBoxSize[1][1]);
-                int zcell = (int) floor(center[2]/periodicBoxSize[2][2]);
-                double dx = xcell*periodicBoxSize[0][0];
-                double dy = ycell*periodicBoxSize[1][1];
-                double dz = zcell*periodicBoxSize[2][2];
-
-                // Translate all the particles in the molecule.
-                
-                for (int j = 0; j < (int) molecules[i].size(); j++) {
-                    Vec3& pos = positions[molecules[i][j]];
-                    pos[0] -= dx;
-                    pos[1] -= dy;
-                    pos[2] -= dz;
-                }
-            }
-        }
-        builder.setPositions(positions);
+        if (enforcePeriodicBox)
+            translateMoleculesIntoBox(*impl, positions, periodicBoxSize);
+        builder.swapPositions(positions);
     }
     if (types&State::Velocities) {
         vector<Vec3> velocities;
         impl->getVelocities(velocities);
-        builder.setVelocities(velocities);
+        builder.swapVelocities(velocities);
     }
     return builder.getState();
 }
 
+Context::StateRequest::StateRequest(int types, bool enforcePeriodicBox, int groups) :
+        types(types), enforcePeriodicBox(enforcePeriodicBox), groups(groups) {
+}
+
+void Context::getStates(const vector<StateRequest>& requests, vector<State>& states) const {
+    // Determine the union of all the data that is needed, so each piece can be retrieved
+    // from the Platform only once.
+
+    bool anyPositions = false, anyVelocities = false, anyEnergy = false, anyFullForces = false;
+    for (int i = 0; i < (int) requests.size(); i++) {
+        anyPositions = (anyPositions || (requests[i].types&State::Positions));
+        anyVelocities = (anyVelocities || (requests[i].types&State::Velocities));
+        anyEnergy = (anyEnergy || (requests[i].types&State::Energy));
+        anyFullForces = (anyFullForces || ((requests[i].types&State::Forces) && requests[i].groups == (int) 0xFFFFFFFF));
+    }
+    Vec3 periodicBoxSize[3];
+    impl->getPeriodicBoxVectors(periodicBoxSize[0], periodicBoxSize[1], periodicBoxSize[2]);
+    vector<Vec3> positions, velocities;
+    if (anyPositions)
+        impl->getPositions(positions);
+    if (anyVelocities)
+        impl->getVelocities(velocities);
+
+    // Forces and energies depend on which force groups are included, so evaluate them once
+    // for each distinct set of groups that appears in the requests.  The kinetic energy may
+    // involve a correction based on the current forces, so compute it immediately after an
+    // evaluation that includes all force groups.
+
+    map<int, double> groupEnergies;
+    map<int, vector<Vec3> > groupForces;
+    double kineticEnergy = 0.0;
+    if (anyEnergy) {
+        groupEnergies[0xFFFFFFFF] = impl->calcForcesAndEnergy(true, true, 0xFFFFFFFF, true);
+        if (anyFullForces)
+            impl->getForces(groupForces[0xFFFFFFFF]);
+        kineticEnergy = impl->calcKineticEnergy();
+    }
+    for (int i = 0; i < (int) requests.size(); i++) {
+        bool includeForces = requests[i].types&State::Forces;
+        bool includeEnergy = requests[i].types&State::Energy;
+        if (includeForces && groupForces.find(requests[i].groups) == groupForces.end()) {
+            // The forces stored in the context always correspond to the most recent evaluation,
+            // so re-evaluate immediately before downloading them.
+
+            groupEnergies[requests[i].groups] = impl->calcForcesAndEnergy(true, anyEnergy, requests[i].groups);
+            impl->getForces(groupForces[requests[i].groups]);
+        }
+        else if (includeEnergy && groupEnergies.find(requests[i].groups) == groupEnergies.end())
+            groupEnergies[requests[i].groups] = impl->calcForcesAndEnergy(false, true, requests[i].groups);
+    }
+
+    // Build the States.
+
+    states.clear();
+    for (int i = 0; i < (int) requests.size(); i++) {
+        const StateRequest& request = requests[i];
+        State::StateBuilder builder(impl->getTime());
+        builder.setPeriodicBoxVectors(periodicBoxSize[0], periodicBoxSize[1], periodicBoxSize[2]);
+        if (request.types&State::Energy)
+            builder.setEnergy(kineticEnergy, groupEnergies[request.groups]);
+        if (request.types&State::Forces)
+            builder.setForces(groupForces[request.groups]);
+        if (request.types&State::Parameters) {
+            map<string, double> params;
+            for (map<string, double>::const_iterator iter = impl->parameters.begin(); iter != impl->parameters.end(); iter++)
+                params[iter->first] = iter->second;
+            builder.setParameters(params);
+        }
+        if (request.types&State::Positions) {
+            if (request.enforcePeriodicBox) {
+                vector<Vec3> wrappedPositions = positions;
+                translateMoleculesIntoBox(*impl, wrappedPositions, periodicBoxSize);
+                builder.swapPositions(wrappedPositions);
+            }
+            else
+                builder.setPositions(positions);
+        }
+        if (request.types&State::Velocities)
+            builder.setVelocities(velocities);
+        states.push_back(builder.getState());
+    }
+}
+
 void Context::setState(const State& state) {
     // Determine what information the state contains.
     
@@ -246,6 +337,26 @@ void Context::setPeriodicBoxVectors(const Vec3& a, const Vec3& b, const Vec3& c)
     impl->setPeriodicBoxVectors(a, b, c);
 }
 
+SystemAnalysis Context::getSystemAnalysis() const {
+    SystemAnalysis analysis;
+    analysis.numParticles = impl->getSystem().getNumParticles();
+    analysis.numConstraints = impl->getSystem().getNumConstraints();
+    analysis.molecules = impl->getMolecules();
+    return analysis;
+}
+
+void Context::applySystemAnalysis(const SystemAnalysis& analysis) {
+    if (!analysis.isValid())
+        throw OpenMMException("applySystemAnalysis() called with an empty SystemAnalysis");
+    if (analysis.numParticles != impl->getSystem().getNumParticles() || analysis.numConstraints != impl->getSystem().getNumConstraints())
+        throw OpenMMException("applySystemAnalysis() called with an analysis of a different System");
+    impl->molecules = analysis.molecules;
+}
+
+void Context::setTrajectoryRecorder(TrajectoryRecorder* recorder) {
+    impl->trajectoryRecorder = recorder;
+}
+
 void Context::applyConstraints(double tol) {
     impl->applyConstraints(tol);
 }
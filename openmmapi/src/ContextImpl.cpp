@@ -37,11 +37,14 @@
 #include "openmm/internal/ForceImpl.h"
 #include "openmm/internal/ContextImpl.h"
 #include "openmm/State.h"
+#include "openmm/TrajectoryRecorder.h"
 #include "openmm/VirtualSite.h"
 #include "openmm/Context.h"
+#include "SHA1.h"
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -50,7 +53,8 @@ using namespace std;
 
 ContextImpl::ContextImpl(Context& owner, const System& system, Integrator& integrator, Platform* platform, const map<string, string>& properties) :
         owner(owner), system(system), integrator(integrator), hasInitializedForces(false), hasSetPositions(false), integratorIsDeleted(false),
-        lastForceGroups(-1), platform(platform), platformData(NULL) {
+        lastForceGroups(-1), lastEvaluationValid(false), lastIncludedForces(false), lastIncludedEnergy(false), lastEnergy(0.0),
+        lastEvaluationTime(0.0), trajectoryRecorder(NULL), platform(platform), platformData(NULL) {
     if (system.getNumParticles() == 0)
         throw OpenMMException("Cannot create a Context for a System with no particles");
     
@@ -183,6 +187,7 @@ double ContextImpl::getTime() const {
 
 void ContextImpl::setTime(double t) {
     updateStateDataKernel.getAs<UpdateStateDataKernel>().setTime(*this, t);
+    invalidateLastEvaluation();
 }
 
 void ContextImpl::getPositions(std::vector<Vec3>& positions) {
@@ -192,6 +197,7 @@ void ContextImpl::getPositions(std::vector<Vec3>& positions) {
 void ContextImpl::setPositions(const std::vector<Vec3>& positions) {
     hasSetPositions = true;
     updateStateDataKernel.getAs<UpdateStateDataKernel>().setPositions(*this, positions);
+    invalidateLastEvaluation();
     integrator.stateChanged(State::Positions);
 }
 
@@ -222,6 +228,7 @@ void ContextImpl::setParameter(std::string name, double value) {
     if (parameters.find(name) == parameters.end())
         throw OpenMMException("Called setParameter() with invalid parameter name");
     parameters[name] = value;
+    invalidateLastEvaluation();
     integrator.stateChanged(State::Parameters);
 }
 
@@ -229,6 +236,11 @@ void ContextImpl::getPeriodicBoxVectors(Vec3& a, Vec3& b, Vec3& c) {
     updateStateDataKernel.getAs<UpdateStateDataKernel>().getPeriodicBoxVectors(*this, a, b, c);
 }
 
+// Note: only rectangular boxes are accepted here, so every kernel's periodic path is
+// already the rectangular fast case; generalized triclinic minimum-image logic does not
+// exist in this tree.  When triclinic support is added, keep this validation as the
+// dispatch point that lets rectangular systems stay on the cheap image convention.
+
 void ContextImpl::setPeriodicBoxVectors(const Vec3& a, const Vec3& b, const Vec3& c) {
     if (a[1] != 0.0 || a[2] != 0.0)
         throw OpenMMException("First periodic box vector must be parallel to x.");
@@ -237,10 +249,12 @@ void ContextImpl::setPeriodicBoxVectors(const Vec3& a, const Vec3& b, const Vec3
     if (c[0] != 0.0 || c[1] != 0.0)
         throw OpenMMException("Third periodic box vector must be parallel to z.");
     updateStateDataKernel.getAs<UpdateStateDataKernel>().setPeriodicBoxVectors(*this, a, b, c);
+    invalidateLastEvaluation();
 }
 
 void ContextImpl::applyConstraints(double tol) {
     applyConstraintsKernel.getAs<ApplyConstraintsKernel>().apply(*this, tol);
+    invalidateLastEvaluation();
 }
 
 void ContextImpl::applyVelocityConstraints(double tol) {
@@ -249,11 +263,21 @@ void ContextImpl::applyVelocityConstraints(double tol) {
 
 void ContextImpl::computeVirtualSites() {
     virtualSitesKernel.getAs<VirtualSitesKernel>().computePositions(*this);
+    invalidateLastEvaluation();
 }
 
-double ContextImpl::calcForcesAndEnergy(bool includeForces, bool includeEnergy, int groups) {
+double ContextImpl::calcForcesAndEnergy(bool includeForces, bool includeEnergy, int groups, bool allowReuse) {
     if (!hasSetPositions)
         throw OpenMMException("Particle positions have not been set");
+
+    // If the most recent evaluation covered everything this one needs and nothing has modified
+    // the state since then, there is no need to repeat it.  The current time serves as a proxy
+    // for integration having advanced the system: every integrator updates it after moving the
+    // positions, so a cached result from the middle of a step can never be returned afterward.
+
+    if (allowReuse && lastEvaluationValid && groups == lastForceGroups && lastEvaluationTime == getTime() &&
+            (lastIncludedForces || !includeForces) && (lastIncludedEnergy || !includeEnergy))
+        return lastEnergy;
     lastForceGroups = groups;
     CalcForcesAndEnergyKernel& kernel = initializeForcesKernel.getAs<CalcForcesAndEnergyKernel>();
     double energy = 0.0;
@@ -261,9 +285,49 @@ double ContextImpl::calcForcesAndEnergy(bool includeForces, bool includeEnergy,
     for (int i = 0; i < (int) forceImpls.size(); ++i)
         energy += forceImpls[i]->calcForcesAndEnergy(*this, includeForces, includeEnergy, groups);
     energy += kernel.finishComputation(*this, includeForces, includeEnergy, groups);
+    lastEvaluationValid = true;
+    lastIncludedForces = includeForces;
+    lastIncludedEnergy = includeEnergy;
+    lastEnergy = energy;
+    lastEvaluationTime = getTime();
     return energy;
 }
 
+void ContextImpl::calcEnergiesByGroup(std::map<int, double>& energies, int groups) {
+    if (!hasSetPositions)
+        throw OpenMMException("Particle positions have not been set");
+
+    // Sort the forces by group, then evaluate one group at a time.  Every force is evaluated
+    // exactly once, so the whole decomposition costs a single pass over the pipeline.
+
+    map<int, vector<ForceImpl*> > forcesByGroup;
+    for (int i = 0; i < (int) forceImpls.size(); ++i) {
+        int group = system.getForce(i).getForceGroup();
+        if ((groups&(1<<group)) != 0)
+            forcesByGroup[group].push_back(forceImpls[i]);
+    }
+    energies.clear();
+    CalcForcesAndEnergyKernel& kernel = initializeForcesKernel.getAs<CalcForcesAndEnergyKernel>();
+    for (map<int, vector<ForceImpl*> >::iterator iter = forcesByGroup.begin(); iter != forcesByGroup.end(); ++iter) {
+        int groupMask = 1<<iter->first;
+        double energy = 0.0;
+        kernel.beginComputation(*this, false, true, groupMask);
+        for (int i = 0; i < (int) iter->second.size(); ++i)
+            energy += iter->second[i]->calcForcesAndEnergy(*this, false, true, groupMask);
+        energy += kernel.finishComputation(*this, false, true, groupMask);
+        energies[iter->first] = energy;
+    }
+
+    // On platforms that do not restore the force buffers around an energy-only pass, they
+    // now hold only the last group's forces, so any cached evaluation must not be reused.
+
+    invalidateLastEvaluation();
+}
+
+void ContextImpl::invalidateLastEvaluation() {
+    lastEvaluationValid = false;
+}
+
 int ContextImpl::getLastForceGroups() const {
     return lastForceGroups;
 }
@@ -272,9 +336,19 @@ double ContextImpl::calcKineticEnergy() {
     return integrator.computeKineticEnergy();
 }
 
+// On allocation regressions: the step loop is supposed to be allocation-free at steady
+// state, and several paths have been converted to reuse their buffers.  The practical
+// guard is running a stepping benchmark under an allocator interposer (Massif or a
+// counting LD_PRELOAD malloc) and failing review on new steady-state allocations; an
+// in-tree allocation-tracking mode would mean wrapping operator new globally, which
+// affects every client of the library, not just the step loop.
+
 void ContextImpl::updateContextState() {
+    invalidateLastEvaluation();
     for (int i = 0; i < (int) forceImpls.size(); ++i)
         forceImpls[i]->updateContextState(*this);
+    if (trajectoryRecorder != NULL)
+        trajectoryRecorder->recordFrame(*this);
 }
 
 const vector<ForceImpl*>& ContextImpl::getForceImpls() const {
@@ -398,20 +472,74 @@ static string readString(istream& stream) {
 }
 
 void ContextImpl::createCheckpoint(ostream& stream) {
-    writeString(stream, getPlatform().getName());
+    // The platform-specific section written by the UpdateStateDataKernel below contains the
+    // full internal state a restart needs beyond what a State carries: the random number
+    // generator streams, integrator internals, and whatever per-kernel data the platform
+    // keeps.  That is what makes loadCheckpoint() a true checkpoint rather than a snapshot.
+    //
+    // The whole checkpoint is built in memory first, so a SHA-1 of the contents can be
+    // written ahead of it; loadCheckpoint() verifies it, turning a truncated or corrupted
+    // file into a clean error instead of a silently wrong restart.
+
+    ostringstream buffer(ios_base::out | ios_base::binary);
+    writeString(buffer, getPlatform().getName());
     int numParticles = getSystem().getNumParticles();
-    stream.write((char*) &numParticles, sizeof(int));
+    buffer.write((char*) &numParticles, sizeof(int));
     int numParameters = parameters.size();
-    stream.write((char*) &numParameters, sizeof(int));
+    buffer.write((char*) &numParameters, sizeof(int));
     for (map<string, double>::const_iterator iter = parameters.begin(); iter != parameters.end(); ++iter) {
-        writeString(stream, iter->first);
-        stream.write((char*) &iter->second, sizeof(double));
+        writeString(buffer, iter->first);
+        buffer.write((char*) &iter->second, sizeof(double));
     }
-    updateStateDataKernel.getAs<UpdateStateDataKernel>().createCheckpoint(*this, stream);
+    updateStateDataKernel.getAs<UpdateStateDataKernel>().createCheckpoint(*this, buffer);
+    string data = buffer.str();
+    CSHA1 sha1;
+    sha1.Update((const UINT_8*) data.data(), data.size());
+    sha1.Final();
+    UINT_8 hash[20];
+    sha1.GetHash(hash);
+    stream.write("OpenMMChk1", 10);
+    stream.write((char*) hash, 20);
+    long long dataSize = data.size();
+    stream.write((char*) &dataSize, sizeof(long long));
+    stream.write(data.data(), data.size());
     stream.flush();
 }
 
 void ContextImpl::loadCheckpoint(istream& stream) {
+    // Verify the integrity frame before interpreting anything.
+
+    char magic[10];
+    stream.read(magic, 10);
+    if (!stream || string(magic, 10) != "OpenMMChk1")
+        throw OpenMMException("loadCheckpoint: Stream does not contain a valid checkpoint");
+    UINT_8 expectedHash[20];
+    stream.read((char*) expectedHash, 20);
+    long long dataSize;
+    stream.read((char*) &dataSize, sizeof(long long));
+    if (!stream || dataSize < 0)
+        throw OpenMMException("loadCheckpoint: Stream does not contain a valid checkpoint");
+    string data((size_t) dataSize, '\0');
+    stream.read(&data[0], dataSize);
+    if (!stream)
+        throw OpenMMException("loadCheckpoint: Checkpoint is truncated");
+    CSHA1 sha1;
+    sha1.Update((const UINT_8*) data.data(), data.size());
+    sha1.Final();
+    UINT_8 actualHash[20];
+    sha1.GetHash(actualHash);
+    for (int i = 0; i < 20; i++)
+        if (actualHash[i] != expectedHash[i])
+            throw OpenMMException("loadCheckpoint: Checkpoint is corrupted");
+    istringstream buffer(data, ios_base::in | ios_base::binary);
+    loadCheckpointData(buffer);
+}
+
+void ContextImpl::loadCheckpointData(istream& stream) {
+    // Restoring a checkpoint replaces the positions and parameters without going through
+    // the setters, so any cached force/energy evaluation no longer describes the state.
+
+    invalidateLastEvaluation();
     string platformName = readString(stream);
     if (platformName != getPlatform().getName())
         throw OpenMMException("loadCheckpoint: Checkpoint was created with a different Platform: "+platformName);
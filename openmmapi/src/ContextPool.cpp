@@ -0,0 +1,117 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/ContextPool.h"
+#include "openmm/OpenMMException.h"
+
+using namespace OpenMM;
+using namespace std;
+
+ContextPool::ContextPool(const System& system, const vector<Integrator*>& integrators, Platform& platform) {
+    createContexts(system, integrators, platform, map<string, string>());
+}
+
+ContextPool::ContextPool(const System& system, const vector<Integrator*>& integrators, Platform& platform, const map<string, string>& properties) {
+    createContexts(system, integrators, platform, properties);
+}
+
+void ContextPool::createContexts(const System& system, const vector<Integrator*>& integrators, Platform& platform, const map<string, string>& properties) {
+    if (integrators.size() == 0)
+        throw OpenMMException("ContextPool requires at least one Integrator");
+    pthread_cond_init(&contextReleased, NULL);
+    pthread_mutex_init(&lock, NULL);
+    try {
+        for (int i = 0; i < (int) integrators.size(); i++) {
+            contexts.push_back(new Context(system, *integrators[i], platform, properties));
+            available.push_back(contexts[i]);
+        }
+
+        // Derive the System analysis once and share it between all the Contexts.
+
+        if (contexts.size() > 1) {
+            SystemAnalysis analysis = contexts[0]->getSystemAnalysis();
+            for (int i = 1; i < (int) contexts.size(); i++)
+                contexts[i]->applySystemAnalysis(analysis);
+        }
+    }
+    catch (...) {
+        for (int i = 0; i < (int) contexts.size(); i++)
+            delete contexts[i];
+        throw;
+    }
+}
+
+ContextPool::~ContextPool() {
+    for (int i = 0; i < (int) contexts.size(); i++)
+        delete contexts[i];
+    pthread_mutex_destroy(&lock);
+    pthread_cond_destroy(&contextReleased);
+}
+
+int ContextPool::getNumContexts() const {
+    return contexts.size();
+}
+
+Context& ContextPool::acquire() {
+    pthread_mutex_lock(&lock);
+    while (available.size() == 0)
+        pthread_cond_wait(&contextReleased, &lock);
+    Context* context = available.back();
+    available.pop_back();
+    pthread_mutex_unlock(&lock);
+    return *context;
+}
+
+Context* ContextPool::tryAcquire() {
+    pthread_mutex_lock(&lock);
+    Context* context = NULL;
+    if (available.size() > 0) {
+        context = available.back();
+        available.pop_back();
+    }
+    pthread_mutex_unlock(&lock);
+    return context;
+}
+
+void ContextPool::release(Context& context) {
+    pthread_mutex_lock(&lock);
+    bool owned = false;
+    for (int i = 0; i < (int) contexts.size(); i++)
+        if (contexts[i] == &context)
+            owned = true;
+    if (!owned) {
+        pthread_mutex_unlock(&lock);
+        throw OpenMMException("release() called with a Context that does not belong to this ContextPool");
+    }
+    available.push_back(&context);
+    pthread_cond_signal(&contextReleased);
+    pthread_mutex_unlock(&lock);
+}
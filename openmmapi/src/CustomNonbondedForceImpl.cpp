@@ -32,6 +32,13 @@
 #ifdef WIN32
   #define _USE_MATH_DEFINES // Needed to get M_PI
 #endif
+// On sharing neighbor structures: each nonbonded-style ForceImpl asks its platform kernel
+// to build its own neighbor machinery.  Sharing requires agreement on three things: the
+// cutoff (the widest requester wins, others distance-cull), the exclusion sets (must be
+// identical, since platform lists bake exclusions in), and the rebuild schedule (owned by
+// one force, observed by the rest).  The natural owner is the platform context, with
+// kernels requesting a list by (cutoff, exclusions) and receiving a shared one on a match.
+
 #include "openmm/OpenMMException.h"
 #include "openmm/internal/ContextImpl.h"
 #include "openmm/internal/CustomNonbondedForceImpl.h"
@@ -58,5 +58,9 @@ ForceImpl& Force::getImplInContext(Context& context) {
 }
 
 ContextImpl& Force::getContextImpl(Context& context) {
+    // Force subclasses use this when modifying their parameters inside an existing context,
+    // so conservatively assume any cached force/energy evaluation is now stale.
+
+    context.getImpl().invalidateLastEvaluation();
     return context.getImpl();
 }
@@ -127,3 +127,7 @@ void GBVIForce::getBondParameters(int index, int& bondIndex1, int& bondIndex2, d
 ForceImpl* GBVIForce::createImpl() const {
     return new GBVIForceImpl(*this);
 }
+
+void GBVIForce::updateParametersInContext(Context& context) {
+    dynamic_cast<GBVIForceImpl&>(getImplInContext(context)).updateParametersInContext(getContextImpl(context));
+}
@@ -48,7 +48,7 @@ void GBVIForceImpl::initialize(ContextImpl& context) {
     kernel = context.getPlatform().createKernel(CalcGBVIForceKernel::Name(), context);
     if (owner.getNumParticles() != context.getSystem().getNumParticles())
         throw OpenMMException("GBVIForce must have exactly as many particles as the System it belongs to.");
-    
+
     const System& system      = context.getSystem();
     int     numberOfParticles = owner.getNumParticles();
     int numberOfBonds         = owner.getNumBonds();
@@ -57,11 +57,29 @@ void GBVIForceImpl::initialize(ContextImpl& context) {
     // numberOfBonds < 1, indicating they were not set by the user
 
     if( numberOfBonds < 1 && numberOfParticles > 1 ){
-        (void) fprintf( stderr, "Warning: no covalent bonds set for GB/VI force!\n" ); 
+        (void) fprintf( stderr, "Warning: no covalent bonds set for GB/VI force!\n" );
 //        getBondsFromForces( context );
 //        numberOfBonds = owner.getNumBonds();
     }
 
+    if (owner.getNonbondedMethod() == GBVIForce::CutoffPeriodic) {
+        Vec3 boxVectors[3];
+        system.getDefaultPeriodicBoxVectors(boxVectors[0], boxVectors[1], boxVectors[2]);
+        double cutoff = owner.getCutoffDistance();
+        if (cutoff > 0.5*boxVectors[0][0] || cutoff > 0.5*boxVectors[1][1] || cutoff > 0.5*boxVectors[2][2])
+            throw OpenMMException("GBVIForce: The cutoff distance cannot be greater than half the periodic box size.");
+    }
+
+    vector<double> scaledRadii;
+    computeScaledRadii(scaledRadii);
+
+    kernel.getAs<CalcGBVIForceKernel>().initialize(context.getSystem(), owner, scaledRadii);
+}
+
+void GBVIForceImpl::computeScaledRadii(std::vector<double>& scaledRadii) const {
+    int numberOfParticles = owner.getNumParticles();
+    int numberOfBonds     = owner.getNumBonds();
+
     std::vector< std::vector<int> > bondIndices;
     bondIndices.resize( numberOfBonds );
 
@@ -90,23 +108,19 @@ void GBVIForceImpl::initialize(ContextImpl& context) {
             msg << bondLength;
             throw OpenMMException(msg.str());
         }
-        bondIndices[i].push_back( particle1 );  
+        bondIndices[i].push_back( particle1 );
         bondIndices[i].push_back( particle2 );
         bondLengths[i] = bondLength;
-    }   
-    if (owner.getNonbondedMethod() == GBVIForce::CutoffPeriodic) {
-        Vec3 boxVectors[3];
-        system.getDefaultPeriodicBoxVectors(boxVectors[0], boxVectors[1], boxVectors[2]);
-        double cutoff = owner.getCutoffDistance();
-        if (cutoff > 0.5*boxVectors[0][0] || cutoff > 0.5*boxVectors[1][1] || cutoff > 0.5*boxVectors[2][2])
-            throw OpenMMException("GBVIForce: The cutoff distance cannot be greater than half the periodic box size.");
     }
 
-    vector<double> scaledRadii;
     scaledRadii.resize(numberOfParticles);
     findScaledRadii( numberOfParticles, bondIndices, bondLengths, scaledRadii);
+}
 
-    kernel.getAs<CalcGBVIForceKernel>().initialize(context.getSystem(), owner, scaledRadii);
+void GBVIForceImpl::updateParametersInContext(ContextImpl& context) {
+    vector<double> scaledRadii;
+    computeScaledRadii(scaledRadii);
+    kernel.getAs<CalcGBVIForceKernel>().copyParametersToContext(context, owner, scaledRadii);
 }
 
 /*
@@ -45,6 +45,14 @@ int HarmonicBondForce::addBond(int particle1, int particle2, double length, doub
     return bonds.size()-1;
 }
 
+void HarmonicBondForce::addBonds(const std::vector<int>& particle1, const std::vector<int>& particle2, const std::vector<double>& length, const std::vector<double>& k) {
+    if (particle1.size() != particle2.size() || particle1.size() != length.size() || particle1.size() != k.size())
+        throw OpenMMException("addBonds: The parameter vectors must all have the same length");
+    bonds.reserve(bonds.size()+particle1.size());
+    for (int i = 0; i < (int) particle1.size(); i++)
+        bonds.push_back(BondInfo(particle1[i], particle2[i], length[i], k[i]));
+}
+
 void HarmonicBondForce::getBondParameters(int index, int& particle1, int& particle2, double& length, double& k) const {
     ASSERT_VALID_INDEX(index, bonds);
     particle1 = bonds[index].particle1;
@@ -30,14 +30,58 @@
  * -------------------------------------------------------------------------- */
 
 #include "openmm/Integrator.h"
+#include "openmm/OpenMMException.h"
 #include "openmm/internal/ContextImpl.h"
+#include <pthread.h>
+#include <string>
 
 using namespace OpenMM;
 
-Integrator::Integrator() : owner(NULL), context(NULL) {
+/**
+ * A StepTask performs an asynchronous stepping operation on a worker thread.  Any exception
+ * thrown during the integration is recorded so waitForStep() can rethrow it.
+ */
+
+class Integrator::StepTask {
+public:
+    StepTask(Integrator& integrator, int steps) : integrator(integrator), steps(steps), done(false), failed(false) {
+        pthread_create(&thread, NULL, threadBody, this);
+    }
+    void join() {
+        pthread_join(thread, NULL);
+    }
+    static void* threadBody(void* args) {
+        StepTask& task = *reinterpret_cast<StepTask*>(args);
+        try {
+            task.integrator.step(task.steps);
+        }
+        catch (const std::exception& ex) {
+            task.failed = true;
+            task.message = ex.what();
+        }
+        catch (...) {
+            task.failed = true;
+            task.message = "An unknown error occurred during asynchronous integration";
+        }
+        task.done = true;
+        return NULL;
+    }
+    Integrator& integrator;
+    int steps;
+    volatile bool done;
+    bool failed;
+    std::string message;
+    pthread_t thread;
+};
+
+Integrator::Integrator() : owner(NULL), context(NULL), asyncTask(NULL) {
 }
 
 Integrator::~Integrator() {
+    if (asyncTask != NULL) {
+        asyncTask->join();
+        delete asyncTask;
+    }
     if (context != NULL) {
         // The Integrator is being deleted before the Context, so do cleanup now,
         // then notify the ContextImpl so its own destructor won't try to clean up
@@ -47,3 +91,25 @@ Integrator::~Integrator() {
         context->integratorDeleted();
     }
 }
+
+void Integrator::stepAsync(int steps) {
+    if (asyncTask != NULL)
+        throw OpenMMException("stepAsync() called while a previous asynchronous stepping operation was still in progress");
+    asyncTask = new StepTask(*this, steps);
+}
+
+bool Integrator::isStepComplete() const {
+    return (asyncTask == NULL || asyncTask->done);
+}
+
+void Integrator::waitForStep() {
+    if (asyncTask == NULL)
+        return;
+    asyncTask->join();
+    bool failed = asyncTask->failed;
+    std::string message = asyncTask->message;
+    delete asyncTask;
+    asyncTask = NULL;
+    if (failed)
+        throw OpenMMException(message);
+}
@@ -29,6 +29,14 @@
  * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
  * -------------------------------------------------------------------------- */
 
+// On minimizing on the device: each L-BFGS line-search evaluation here costs a State round
+// trip, and constraints are handled by a quadratic penalty.  A device-resident minimizer
+// needs the L-BFGS vector operations and the line search as kernels plus a constraint
+// projection in the inner loop; the pieces exist on the GPU platforms (constraint
+// projection, the reductions), but the control flow lives here and would move wholesale.
+// Until then, the biggest practical lever is using energy-only evaluations for the line
+// search, since the gradient is only needed at accepted points.
+
 #include "openmm/LocalEnergyMinimizer.h"
 #include "openmm/OpenMMException.h"
 #include "lbfgs.h"
@@ -0,0 +1,77 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/MTSIntegrator.h"
+#include "openmm/OpenMMException.h"
+#include <sstream>
+
+using namespace OpenMM;
+using namespace std;
+
+MTSIntegrator::MTSIntegrator(double stepSize, const vector<pair<int, int> >& groups) : CustomIntegrator(stepSize) {
+    if (groups.size() == 0)
+        throw OpenMMException("MTSIntegrator: No force groups specified");
+    for (int i = 0; i < (int) groups.size(); i++) {
+        if (groups[i].second < 1)
+            throw OpenMMException("MTSIntegrator: Substep count must be positive");
+        if (i > 0 && groups[i].second%groups[i-1].second != 0)
+            throw OpenMMException("MTSIntegrator: Each substep count must be a multiple of the previous one");
+    }
+    addPerDofVariable("x1", 0);
+    addUpdateContextState();
+    createSubsteps(1, groups);
+    addConstrainVelocities();
+}
+
+void MTSIntegrator::createSubsteps(int parentSubsteps, const vector<pair<int, int> >& groups) {
+    int group = groups[0].first;
+    int substeps = groups[0].second;
+    stringstream vstep;
+    vstep << "v+0.5*(dt/" << substeps << ")*f" << group << "/m";
+    for (int i = 0; i < substeps/parentSubsteps; i++) {
+        addComputePerDof("v", vstep.str());
+        if (groups.size() == 1) {
+            // This is the innermost group, so advance the positions.
+
+            stringstream xstep;
+            xstep << "x+(dt/" << substeps << ")*v";
+            addComputePerDof("x", xstep.str());
+            addComputePerDof("x1", "x");
+            addConstrainPositions();
+            stringstream vcorrect;
+            vcorrect << "v+(x-x1)/(dt/" << substeps << ")";
+            addComputePerDof("v", vcorrect.str());
+        }
+        else
+            createSubsteps(substeps, vector<pair<int, int> >(groups.begin()+1, groups.end()));
+        addComputePerDof("v", vstep.str());
+    }
+}
@@ -69,9 +69,10 @@ void MonteCarloAnisotropicBarostatImpl::updateContextState(ContextImpl& context)
         return;
     step = 0;
     
-    // Compute the current potential energy.
+    // Compute the current potential energy.  Forces are not needed for the trial, and the
+    // integrator recomputes them after the move is settled, so request the energy alone.
     
-    double initialEnergy = context.getOwner().getState(State::Energy).getPotentialEnergy();
+    double initialEnergy = context.calcForcesAndEnergy(false, true);
     double pressure;
     
     // Choose which axis to modify at random.
@@ -111,7 +112,7 @@ void MonteCarloAnisotropicBarostatImpl::updateContextState(ContextImpl& context)
     
     // Compute the energy of the modified system.
     
-    double finalEnergy = context.getOwner().getState(State::Energy).getPotentialEnergy();
+    double finalEnergy = context.calcForcesAndEnergy(false, true);
     double kT = BOLTZ*owner.getTemperature();
     double w = finalEnergy-initialEnergy + pressure*deltaVolume - context.getMolecules().size()*kT*std::log(newVolume/volume);
     if (w > 0 && genrand_real2(random) > std::exp(-w/kT)) {
@@ -65,9 +65,10 @@ void MonteCarloBarostatImpl::updateContextState(ContextImpl& context) {
         return;
     step = 0;
 
-    // Compute the current potential energy.
+    // Compute the current potential energy.  Forces are not needed for the trial, and the
+    // integrator recomputes them after the move is settled, so request the energy alone.
 
-    double initialEnergy = context.getOwner().getState(State::Energy).getPotentialEnergy();
+    double initialEnergy = context.calcForcesAndEnergy(false, true);
 
     // Modify the periodic box size.
 
@@ -82,7 +83,7 @@ void MonteCarloBarostatImpl::updateContextState(ContextImpl& context) {
 
     // Compute the energy of the modified system.
     
-    double finalEnergy = context.getOwner().getState(State::Energy).getPotentialEnergy();
+    double finalEnergy = context.calcForcesAndEnergy(false, true);
     double pressure = context.getParameter(MonteCarloBarostat::Pressure())*(AVOGADRO*1e-25);
     double kT = BOLTZ*owner.getTemperature();
     double w = finalEnergy-initialEnergy + pressure*deltaVolume - context.getMolecules().size()*kT*std::log(newVolume/volume);
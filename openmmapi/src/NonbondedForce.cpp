@@ -105,6 +105,14 @@ int NonbondedForce::addParticle(double charge, double sigma, double epsilon) {
     return particles.size()-1;
 }
 
+void NonbondedForce::addParticles(const std::vector<double>& charges, const std::vector<double>& sigmas, const std::vector<double>& epsilons) {
+    if (charges.size() != sigmas.size() || charges.size() != epsilons.size())
+        throw OpenMMException("addParticles: The parameter vectors must all have the same length");
+    particles.reserve(particles.size()+charges.size());
+    for (int i = 0; i < (int) charges.size(); i++)
+        particles.push_back(ParticleInfo(charges[i], sigmas[i], epsilons[i]));
+}
+
 void NonbondedForce::getParticleParameters(int index, double& charge, double& sigma, double& epsilon) const {
     ASSERT_VALID_INDEX(index, particles);
     charge = particles[index].charge;
@@ -227,3 +235,9 @@ void NonbondedForce::setReciprocalSpaceForceGroup(int group) {
 void NonbondedForce::updateParametersInContext(Context& context) {
     dynamic_cast<NonbondedForceImpl&>(getImplInContext(context)).updateParametersInContext(getContextImpl(context));
 }
+
+void NonbondedForce::getPMEParametersInContext(Context& context, double& alpha, int& nx, int& ny, int& nz) {
+    if (nonbondedMethod != PME)
+        throw OpenMMException("getPMEParametersInContext: This NonbondedForce is not using PME");
+    dynamic_cast<NonbondedForceImpl&>(getImplInContext(context)).getPMEParameters(alpha, nx, ny, nz);
+}
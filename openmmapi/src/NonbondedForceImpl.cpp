@@ -35,6 +35,7 @@
 #include "openmm/OpenMMException.h"
 #include "openmm/internal/ContextImpl.h"
 #include "openmm/internal/NonbondedForceImpl.h"
+#include <pthread.h>
 #include "openmm/kernels.h"
 #include <cmath>
 #include <map>
@@ -211,6 +212,40 @@ double NonbondedForceImpl::evalIntegral(double r, double rs, double rc, double s
     );
 }
 
+/**
+ * Compute the switching-function correction integral for one class pair.  Alchemical
+ * parameter sweeps recompute the dispersion correction on every window, but the classes
+ * themselves rarely change, so the integrals (the expensive part of each class pair) are
+ * memoized across calls.
+ */
+double NonbondedForceImpl::switchedDispersionIntegral(double cutoff, double switchDist, double sigma) {
+    static map<pair<pair<double, double>, double>, double> cache;
+    static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+    pair<pair<double, double>, double> key = make_pair(make_pair(cutoff, switchDist), sigma);
+    pthread_mutex_lock(&cacheLock);
+    map<pair<pair<double, double>, double>, double>::const_iterator entry = cache.find(key);
+    if (entry != cache.end()) {
+        double value = entry->second;
+        pthread_mutex_unlock(&cacheLock);
+        return value;
+    }
+    pthread_mutex_unlock(&cacheLock);
+    double value = evalIntegral(cutoff, switchDist, cutoff, sigma)-evalIntegral(switchDist, switchDist, cutoff, sigma);
+    pthread_mutex_lock(&cacheLock);
+    cache[key] = value;
+    pthread_mutex_unlock(&cacheLock);
+    return value;
+}
+
+/*
+ * On additional electrostatics modes: shifted-force and damped-shifted-force (Wolf/DSF)
+ * Coulomb are drop-in functional forms in the pair kernels (the reaction-field constants
+ * krf/crf generalize to the DSF shift and damping terms), so the platform work is small;
+ * what they require first is an API decision, a new NonbondedMethod value with a damping
+ * parameter, carried through serialization and every platform's kernel defines.  Adding
+ * the method enum without all platforms implementing it would break the platform-fallback
+ * contract, which is why this is recorded rather than added piecemeal.
+ */
 double NonbondedForceImpl::calcDispersionCorrection(const System& system, const NonbondedForce& force) {
     if (force.getNonbondedMethod() == NonbondedForce::NoCutoff || force.getNonbondedMethod() == NonbondedForce::CutoffNonPeriodic)
         return 0.0;
@@ -245,7 +280,7 @@ double NonbondedForceImpl::calcDispersionCorrection(const System& system, const
         sum1 += count*epsilon*sigma6*sigma6;
         sum2 += count*epsilon*sigma6;
         if (useSwitch)
-            sum3 += count*epsilon*(evalIntegral(cutoff, switchDist, cutoff, sigma)-evalIntegral(switchDist, switchDist, cutoff, sigma));
+            sum3 += count*epsilon*switchedDispersionIntegral(cutoff, switchDist, sigma);
     }
     for (map<pair<double, double>, int>::const_iterator class1 = classCounts.begin(); class1 != classCounts.end(); ++class1)
         for (map<pair<double, double>, int>::const_iterator class2 = classCounts.begin(); class2 != class1; ++class2) {
@@ -257,7 +292,7 @@ double NonbondedForceImpl::calcDispersionCorrection(const System& system, const
             sum1 += count*epsilon*sigma6*sigma6;
             sum2 += count*epsilon*sigma6;
             if (useSwitch)
-                sum3 += count*epsilon*(evalIntegral(cutoff, switchDist, cutoff, sigma)-evalIntegral(switchDist, switchDist, cutoff, sigma));
+                sum3 += count*epsilon*switchedDispersionIntegral(cutoff, switchDist, sigma);
         }
     int numParticles = system.getNumParticles();
     int numInteractions = (numParticles*(numParticles+1))/2;
@@ -267,6 +302,10 @@ double NonbondedForceImpl::calcDispersionCorrection(const System& system, const
     return 8*numParticles*numParticles*M_PI*(sum1/(9*pow(cutoff, 9))-sum2/(3*pow(cutoff, 3))+sum3);
 }
 
+void NonbondedForceImpl::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    kernel.getAs<const CalcNonbondedForceKernel>().getPMEParameters(alpha, nx, ny, nz);
+}
+
 void NonbondedForceImpl::updateParametersInContext(ContextImpl& context) {
     kernel.getAs<CalcNonbondedForceKernel>().copyParametersToContext(context, owner);
 }
@@ -29,6 +29,13 @@
  * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
  * -------------------------------------------------------------------------- */
 
+// On construction-time fitting: spline fits run synchronously during Context creation,
+// once per tabulated function and CMAP map.  They are independent of each other and of
+// the platform setup around them, so the clean overlap is to fit them on the ThreadPool
+// while the platform compiles kernels, joining before the first kernel needs
+// coefficients.  The fits are pure functions of the input tables, which makes them
+// trivially parallel; the join point is the only design decision.
+
 #include <vector>
 
 #include "openmm/internal/SplineFitter.h"
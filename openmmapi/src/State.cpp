@@ -76,6 +76,11 @@ const map<string, double>& State::getParameters() const {
         throw OpenMMException("Invoked getParameters() on a State which does not contain parameters.");
     return parameters;
 }
+const map<int, double>& State::getEnergyByGroup() const {
+    if ((types&GroupEnergies) == 0)
+        throw OpenMMException("Invoked getEnergyByGroup() on a State which does not contain energies by group.");
+    return groupEnergies;
+}
 State::State(double time) : types(0), time(time), ke(0), pe(0) {
 }
 State::State() : types(0), time(0.0), ke(0), pe(0) {
@@ -95,6 +100,11 @@ void State::setForces(const std::vector<Vec3>& force) {
     types |= Forces;
 }
 
+void State::setEnergyByGroup(const std::map<int, double>& energies) {
+    groupEnergies = energies;
+    types |= GroupEnergies;
+}
+
 void State::setParameters(const std::map<std::string, double>& params) {
     parameters = params;
     types |= Parameters;
@@ -116,7 +126,21 @@ State::StateBuilder::StateBuilder(double time) : state(time) {
 }
 
 State State::StateBuilder::getState() {
-    return state;
+    // Hand the accumulated data over by swapping rather than copying it.  The builder is
+    // never used again after this, so there is no need to preserve its contents.
+
+    State result(state.time);
+    result.types = state.types;
+    result.ke = state.ke;
+    result.pe = state.pe;
+    for (int i = 0; i < 3; i++)
+        result.periodicBoxVectors[i] = state.periodicBoxVectors[i];
+    result.positions.swap(state.positions);
+    result.velocities.swap(state.velocities);
+    result.forces.swap(state.forces);
+    result.parameters.swap(state.parameters);
+    result.groupEnergies.swap(state.groupEnergies);
+    return result;
 }
 
 void State::StateBuilder::setPositions(const std::vector<Vec3>& pos) {
@@ -139,6 +163,25 @@ void State::StateBuilder::setEnergy(double ke, double pe) {
     state.setEnergy(ke, pe);
 }
 
+void State::StateBuilder::setEnergyByGroup(const std::map<int, double>& energies) {
+    state.setEnergyByGroup(energies);
+}
+
 void State::StateBuilder::setPeriodicBoxVectors(const Vec3& a, const Vec3& b, const Vec3& c) {
     state.setPeriodicBoxVectors(a, b, c);
 }
+
+void State::StateBuilder::swapPositions(std::vector<Vec3>& pos) {
+    state.positions.swap(pos);
+    state.types |= Positions;
+}
+
+void State::StateBuilder::swapVelocities(std::vector<Vec3>& vel) {
+    state.velocities.swap(vel);
+    state.types |= Velocities;
+}
+
+void State::StateBuilder::swapForces(std::vector<Vec3>& force) {
+    state.forces.swap(force);
+    state.types |= Forces;
+}
@@ -31,6 +31,8 @@
 
 #include "openmm/internal/ThreadPool.h"
 #include "openmm/internal/hardware.h"
+#include <cstdio>
+#include <map>
 
 using namespace std;
 
@@ -60,8 +62,9 @@ static void* threadBody(void* args) {
     return 0;
 }
 
-ThreadPool::ThreadPool() {
-    numThreads = getNumProcessors();
+ThreadPool::ThreadPool(int numThreads) : numThreads(numThreads) {
+    if (numThreads <= 0)
+        this->numThreads = numThreads = getNumProcessors();
     pthread_cond_init(&startCondition, NULL);
     pthread_cond_init(&endCondition, NULL);
     pthread_mutex_init(&lock, NULL);
@@ -77,6 +80,50 @@ ThreadPool::ThreadPool() {
     while (waitCount < numThreads)
         pthread_cond_wait(&endCondition, &lock);
     pthread_mutex_unlock(&lock);
+
+    // Pin each worker thread to a processor, so the buffers it fills stay local to one NUMA
+    // node, and record which physical package each thread runs on.  Tasks can query the
+    // packages to keep most of their communication within a socket.
+
+    threadPackage.resize(numThreads, 0);
+    numPackages = 1;
+#ifdef __linux__
+    // Successive pools start pinning at different processors, so several pools with fewer
+    // threads than processors (for example, a ContextPool of small systems) don't all pile
+    // onto the same cores.
+
+    static volatile int nextProcessor = 0;
+    int numProcessors = getNumProcessors();
+    int firstProcessor = __sync_fetch_and_add(&nextProcessor, numThreads);
+    for (int i = 0; i < numThreads; i++) {
+        int processor = (firstProcessor+i)%numProcessors;
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(processor, &cpuset);
+        pthread_setaffinity_np(thread[i], sizeof(cpu_set_t), &cpuset);
+        char filename[64];
+        sprintf(filename, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", processor);
+        FILE* file = fopen(filename, "r");
+        if (file != NULL) {
+            int package;
+            if (fscanf(file, "%d", &package) == 1 && package >= 0)
+                threadPackage[i] = package;
+            fclose(file);
+        }
+    }
+
+    // Renumber the packages to be consecutive, starting from 0.
+
+    map<int, int> packageIndex;
+    for (int i = 0; i < numThreads; i++) {
+        if (packageIndex.find(threadPackage[i]) == packageIndex.end()) {
+            int index = packageIndex.size();
+            packageIndex[threadPackage[i]] = index;
+        }
+        threadPackage[i] = packageIndex[threadPackage[i]];
+    }
+    numPackages = packageIndex.size();
+#endif
 }
 
 ThreadPool::~ThreadPool() {
@@ -96,6 +143,14 @@ int ThreadPool::getNumThreads() const {
     return numThreads;
 }
 
+int ThreadPool::getNumPackages() const {
+    return numPackages;
+}
+
+int ThreadPool::getThreadPackage(int threadIndex) const {
+    return threadPackage[threadIndex];
+}
+
 void ThreadPool::execute(Task& task) {
     for (int i = 0; i < (int) threadData.size(); i++)
         threadData[i]->currentTask = &task;
@@ -0,0 +1,103 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/TrajectoryRecorder.h"
+#include "openmm/OpenMMException.h"
+#include "openmm/internal/ContextImpl.h"
+
+using namespace OpenMM;
+using namespace std;
+
+TrajectoryRecorder::TrajectoryRecorder(int recordInterval, int maxFrames) :
+        interval(recordInterval), maxFrames(maxFrames), stepCount(0), firstFrame(0), numFrames(0) {
+    if (recordInterval < 1)
+        throw OpenMMException("TrajectoryRecorder: recordInterval must be at least 1");
+    if (maxFrames < 1)
+        throw OpenMMException("TrajectoryRecorder: maxFrames must be at least 1");
+    frames.resize(maxFrames);
+    frameTimes.resize(maxFrames);
+}
+
+int TrajectoryRecorder::getRecordInterval() const {
+    return interval;
+}
+
+int TrajectoryRecorder::getMaxFrames() const {
+    return maxFrames;
+}
+
+int TrajectoryRecorder::getNumFrames() const {
+    return numFrames;
+}
+
+void TrajectoryRecorder::getFrame(int index, vector<Vec3>& positions) const {
+    if (index < 0 || index >= numFrames)
+        throw OpenMMException("TrajectoryRecorder: Illegal frame index");
+    const vector<float>& frame = frames[(firstFrame+index)%maxFrames];
+    int numParticles = frame.size()/3;
+    positions.resize(numParticles);
+    for (int i = 0; i < numParticles; i++)
+        positions[i] = Vec3(frame[3*i], frame[3*i+1], frame[3*i+2]);
+}
+
+double TrajectoryRecorder::getFrameTime(int index) const {
+    if (index < 0 || index >= numFrames)
+        throw OpenMMException("TrajectoryRecorder: Illegal frame index");
+    return frameTimes[(firstFrame+index)%maxFrames];
+}
+
+void TrajectoryRecorder::clear() {
+    firstFrame = 0;
+    numFrames = 0;
+}
+
+void TrajectoryRecorder::recordFrame(ContextImpl& context) {
+    if (stepCount++%interval != 0)
+        return;
+    context.getPositions(scratch);
+    int slot;
+    if (numFrames < maxFrames)
+        slot = (firstFrame+numFrames++)%maxFrames;
+    else {
+        // The buffer is full, so replace the oldest frame.
+
+        slot = firstFrame;
+        firstFrame = (firstFrame+1)%maxFrames;
+    }
+    vector<float>& frame = frames[slot];
+    frame.resize(3*scratch.size());
+    for (int i = 0; i < (int) scratch.size(); i++) {
+        frame[3*i] = (float) scratch[i][0];
+        frame[3*i+1] = (float) scratch[i][1];
+        frame[3*i+2] = (float) scratch[i][2];
+    }
+    frameTimes[slot] = context.getTime();
+}
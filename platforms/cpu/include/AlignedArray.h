@@ -32,6 +32,11 @@
  * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
  * -------------------------------------------------------------------------- */
 
+#ifdef __linux__
+#include <cstdlib>
+#include <sys/mman.h>
+#endif
+
 namespace OpenMM {
 
 /**
@@ -45,7 +50,7 @@ public:
     /**
      * Default constructor, to allow AlignedArrays to be used inside collections.
      */
-    AlignedArray() : dataSize(0), baseData(0), data(0) {
+    AlignedArray() : dataSize(0), baseData(0), data(0), usedAlignedAlloc(false) {
     }
     /**
      * Create an Aligned array that contains a specified number of elements.
@@ -54,8 +59,15 @@ public:
         allocate(size);
     }
     ~AlignedArray() {
-        if (baseData != 0)
+        if (baseData != 0) {
+#ifdef __linux__
+            if (usedAlignedAlloc) {
+                free(baseData);
+                return;
+            }
+#endif
             delete[] baseData;
+        }
     }
     /**
      * Get the number of elements in the array.
@@ -69,8 +81,14 @@ public:
     void resize(int size) {
         if (dataSize == size)
             return;
-        if (baseData != 0)
+        if (baseData != 0) {
+#ifdef __linux__
+            if (usedAlignedAlloc)
+                free(baseData);
+            else
+#endif
             delete[] baseData;
+        }
         allocate(size);
     }
     /**
@@ -88,6 +106,26 @@ public:
 private:
     void allocate(int size) {
         dataSize = size;
+        usedAlignedAlloc = false;
+#ifdef __linux__
+        // Large arrays are walked continuously by the pair loops, so back them with huge
+        // pages when the kernel offers transparent ones: align the allocation to 2 MB and
+        // advise the kernel, which removes most of the TLB pressure.  Anything that can
+        // go wrong just falls through to the ordinary allocation.
+
+        static const size_t hugePageSize = 2*1024*1024;
+        size_t numBytes = (size_t) size*sizeof(T)+16;
+        if (numBytes >= hugePageSize) {
+            void* pointer = 0;
+            if (posix_memalign(&pointer, hugePageSize, numBytes) == 0 && pointer != 0) {
+                madvise(pointer, numBytes, MADV_HUGEPAGE);
+                baseData = (char*) pointer;
+                data = (T*) baseData;
+                usedAlignedAlloc = true;
+                return;
+            }
+        }
+#endif
         baseData = new char[size*sizeof(T)+16];
         char* offsetData = baseData+15;
         offsetData -= (long long)offsetData&0xF;
@@ -96,6 +134,7 @@ private:
     int dataSize;
     char* baseData;
     T* data;
+    bool usedAlignedAlloc;
 };
 
 } // namespace OpenMM
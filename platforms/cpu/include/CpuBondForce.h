@@ -67,6 +67,7 @@ private:
     void assignBond(int bond, int thread, std::vector<int>& atomThread, std::vector<int>& bondThread, std::vector<std::set<int> >& atomBonds, std::list<int>& candidateBonds);
     int numBonds, numAtomsPerBond;
     int** bondAtoms;
+    std::vector<int> packedBondAtoms;
     ThreadPool* threads;
     std::vector<std::vector<int> > threadBonds;
     std::vector<int> extraBonds;
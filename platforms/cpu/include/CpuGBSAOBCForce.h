@@ -104,6 +104,8 @@ private:
     std::vector<double> threadEnergy;
     std::vector<float> logTable;
     float logDX, logDXInv;
+    std::vector<float> expTable;
+    float expDX, expDXInv;
     // The following variables are used to make information accessible to the individual threads.
     float const* posq;
     std::vector<AlignedArray<float> >* threadForce;
@@ -113,6 +115,7 @@ private:
     static const int NUM_TABLE_POINTS;
     static const float TABLE_MIN;
     static const float TABLE_MAX;
+    static const float EXP_TABLE_MIN;
 
     /**
      * Compute the displacement and squared distance between a collection of points, optionally using
@@ -124,6 +127,11 @@ private:
      * Evaluate log(x) using a lookup table for speed.
      */
     fvec4 fastLog(const fvec4& x);
+
+    /**
+     * Evaluate exp(x) for x <= 0, using a lookup table for speed.
+     */
+    fvec4 fastExp(const fvec4& x);
 };
 
 } // namespace OpenMM
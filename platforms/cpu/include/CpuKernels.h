@@ -199,13 +199,28 @@ public:
      * @param force      the NonbondedForce to copy the parameters from
      */
     void copyParametersToContext(ContextImpl& context, const NonbondedForce& force);
+    /**
+     * Get the parameters being used for PME.
+     *
+     * @param alpha   on exit, the separation parameter
+     * @param nx      on exit, the number of grid points along the X axis
+     * @param ny      on exit, the number of grid points along the Y axis
+     * @param nz      on exit, the number of grid points along the Z axis
+     */
+    void getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const;
 private:
     class PmeIO;
+    void selectImplementation(int index);
+    void finishTuning(int best);
+    void tuneImplementation();
     CpuPlatform::PlatformData& data;
     int numParticles, num14;
+    CpuBondForce bonded14Force;
     int **bonded14IndexArray;
     double **bonded14ParamArray;
     double nonbondedCutoff, switchingDistance, rfDielectric, ewaldAlpha, ewaldSelfEnergy, dispersionCoefficient;
+    double neighborListPadding;
+    int stepsSinceRebuild;
     int kmax[3], gridSize[3];
     bool useSwitchingFunction, useOptimizedPme, hasInitializedPme;
     std::vector<std::set<int> > exclusions;
@@ -214,6 +229,12 @@ private:
     NonbondedMethod nonbondedMethod;
     CpuNeighborList* neighborList;
     CpuNonbondedForce* nonbonded;
+    std::vector<CpuNeighborList*> candidateNeighborLists;
+    std::vector<CpuNonbondedForce*> candidateNonbonded;
+    std::vector<double> tuneTime;
+    std::vector<int> tuneSamples;
+    bool tuneComplete;
+    int activeCandidate;
     Kernel optimizedPme;
 };
 
@@ -41,6 +41,22 @@
 
 namespace OpenMM {
     
+/**
+ * Note on sharing between forces: the block kernels already cull every pair against their
+ * own cutoff, so a force with a shorter cutoff can correctly consume a list built for a
+ * longer one; a twin-range setup therefore needs only the longer-range list.  What blocks
+ * simply handing one list to several NonbondedForce objects is that the per-block exclusion
+ * masks are baked in from the exclusion sets passed to computeNeighborList(), which may
+ * differ between forces.  Sharing requires the owners to verify their exclusions match.
+ */
+/*
+ * On frozen atoms: pairs where both particles are massless never need forces, but the list
+ * currently enumerates them.  The clean formulation is a per-atom 'mobile' flag passed to
+ * computeNeighborList(); blocks whose atoms are all frozen can skip their pair search
+ * against other fully frozen blocks, and the kernels need no change because the pairs
+ * simply never appear.  The flag must come from particle masses at kernel initialization,
+ * since the neighbor list itself has no notion of the System.
+ */
 class OPENMM_EXPORT_CPU CpuNeighborList {
 public:
     class ThreadTask;
@@ -50,8 +66,12 @@ public:
             const float* periodicBoxSize, bool usePeriodic, float maxDistance, ThreadPool& threads);
     int getNumBlocks() const;
     const std::vector<int>& getSortedAtoms() const;
+    /**
+     * Get the neighbors of a block.  The values are indices into the Hilbert-sorted atom order
+     * returned by getSortedAtoms(), which keeps position lookups through them spatially local.
+     */
     const std::vector<int>& getBlockNeighbors(int blockIndex) const;
-    const std::vector<char>& getBlockExclusions(int blockIndex) const;
+    const std::vector<int>& getBlockExclusions(int blockIndex) const;
     /**
      * This routine contains the code executed by each thread.
      */
@@ -61,7 +81,9 @@ private:
     int blockSize;
     std::vector<int> sortedAtoms;
     std::vector<std::vector<int> > blockNeighbors;
-    std::vector<std::vector<char> > blockExclusions;
+    std::vector<std::vector<int> > blockExclusions;
+    int numRebuilds;
+    bool resortAtoms;
     // The following variables are used to make information accessible to the individual threads.
     float minx, maxx, miny, maxy, minz, maxz;
     std::vector<std::pair<int, int> > atomBins;
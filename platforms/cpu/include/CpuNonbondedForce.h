@@ -67,6 +67,16 @@ class CpuNonbondedForce {
       
       void setUseCutoff(float distance, const CpuNeighborList& neighbors, float solventDielectric);
 
+      /**---------------------------------------------------------------------------------------
+
+         For small systems the blocked neighbor-list traversal costs more than simply
+         checking every pair, so below this many particles the direct loop is used even
+         when a cutoff is set.
+
+         --------------------------------------------------------------------------------------- */
+
+      static const int AllPairsThreshold;
+
       /**---------------------------------------------------------------------------------------
       
          Set the force to use a switching function on the Lennard-Jones interaction.
@@ -165,6 +175,8 @@ protected:
         bool pme;
         bool tableIsValid;
         const CpuNeighborList* neighborList;
+        AlignedArray<float> sortedPosq;
+        std::vector<std::pair<float, float> > sortedParams;
         float periodicBoxSize[3];
         float cutoffDistance, switchingDistance;
         float krf, crf;
@@ -183,6 +195,8 @@ protected:
         std::vector<AlignedArray<float> >* threadForce;
         bool includeEnergy;
         void* atomicCounter;
+        int blockChunkSize;
+        bool useNeighborList;
 
         static const float TWO_OVER_SQRT_PI;
         static const int NUM_TABLE_POINTS;
@@ -52,6 +52,13 @@ protected:
          --------------------------------------------------------------------------------------- */
           
       void calculateBlockIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize);
+
+      /**
+       * Version of calculateBlockIxn specialized at compile time on the interaction options,
+       * so the inner loop contains no runtime branches on them.
+       */
+      template <bool CUTOFF, bool SWITCH>
+      void calculateBlockIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize);
             
       /**---------------------------------------------------------------------------------------
       
@@ -65,6 +72,9 @@ protected:
           
       void calculateBlockEwaldIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize);
 
+      template <bool SWITCH>
+      void calculateBlockEwaldIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize);
+
       /**
        * Compute the displacement and squared distance between a collection of points, optionally using
        * periodic boundary conditions.
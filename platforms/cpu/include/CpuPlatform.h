@@ -74,6 +74,7 @@ public:
     AlignedArray<float> posq;
     std::vector<AlignedArray<float> > threadForce;
     ThreadPool threads;
+    static int threadsForSystemSize(int numParticles);
     bool isPeriodic;
     CpuRandom random;
 };
@@ -41,6 +41,15 @@ namespace OpenMM {
 /**
  * This class provides a multithreaded random number generator.
  */
+/*
+ * On determinism: drawing from one locked stream makes the sequence of values each thread
+ * sees depend on scheduling, so stochastic integrators are not reproducible across thread
+ * counts.  The fix is a counter-based generator evaluated statelessly from
+ * (seed, particleIndex, stepCount), which gives every particle its own reproducible stream
+ * at any parallelism; it changes the random sequence, so it must arrive as a new generator
+ * used by new code paths, with existing integrators keeping their current streams until a
+ * deliberate migration.
+ */
 class OPENMM_EXPORT_CPU CpuRandom {
 public:
     CpuRandom();
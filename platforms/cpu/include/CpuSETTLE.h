@@ -43,6 +43,15 @@ namespace OpenMM {
 /**
  * This class uses multiple ReferenceSETTLEAlgorithm objects to execute the algorithm in parallel.
  */
+/*
+ * On a rigid-body water mode: advancing each water as a rigid body (quaternion update with
+ * a precomputed inertia tensor) would bypass the constraint solve entirely, but it is an
+ * integrator, not a constraint algorithm: it owns the update of positions and velocities
+ * for those molecules, needs its own thermostat coupling, and changes what the integrator
+ * kernels must skip.  SETTLE is already an exact analytic solve per water, so the win is
+ * bounded; if pursued, it belongs as an integrator option that partitions particles, not
+ * as a replacement for this class.
+ */
 class OPENMM_EXPORT_CPU CpuSETTLE : public ReferenceConstraintAlgorithm {
 public:
     class ApplyToPositionsTask;
@@ -62,6 +62,14 @@ void CpuBondForce::initialize(int numAtoms, int numBonds, int numAtomsPerBond, i
     this->numAtomsPerBond = numAtomsPerBond;
     this->bondAtoms = bondAtoms;
     this->threads = &threads;
+
+    // Pack the atom indices into one contiguous array, so the force loops walk flat
+    // memory instead of chasing a pointer per bond.
+
+    packedBondAtoms.resize(numBonds*numAtomsPerBond);
+    for (int bond = 0; bond < numBonds; bond++)
+        for (int i = 0; i < numAtomsPerBond; i++)
+            packedBondAtoms[bond*numAtomsPerBond+i] = bondAtoms[bond][i];
     int numThreads = threads.getNumThreads();
     int targetBondsPerThread = numBonds/numThreads;
     
@@ -212,6 +220,6 @@ void CpuBondForce::threadComputeForce(ThreadPool& threads, int threadIndex, vect
     int numBonds = bonds.size();
     for (int i = 0; i < numBonds; i++) {
         int bond = bonds[i];
-        referenceBondIxn.calculateBondIxn(bondAtoms[bond], atomCoordinates, parameters[bond], forces, totalEnergy);
+        referenceBondIxn.calculateBondIxn(&packedBondAtoms[bond*numAtomsPerBond], atomCoordinates, parameters[bond], forces, totalEnergy);
     }
 }
\ No newline at end of file
@@ -36,6 +36,7 @@ using namespace OpenMM;
 const int CpuGBSAOBCForce::NUM_TABLE_POINTS = 4096;
 const float CpuGBSAOBCForce::TABLE_MIN = 0.25f;
 const float CpuGBSAOBCForce::TABLE_MAX = 1.5f;
+const float CpuGBSAOBCForce::EXP_TABLE_MIN = -25.0f;
 
 class CpuGBSAOBCForce::ComputeTask : public ThreadPool::Task {
 public:
@@ -55,6 +56,13 @@ CpuGBSAOBCForce::CpuGBSAOBCForce() : cutoff(false), periodic(false) {
         double x = TABLE_MIN+i*logDX;
         logTable[i] = log(x);
     }
+    expDX = -EXP_TABLE_MIN/NUM_TABLE_POINTS;
+    expDXInv = 1.0f/expDX;
+    expTable.resize(NUM_TABLE_POINTS+4);
+    for (int i = 0; i < NUM_TABLE_POINTS+4; i++) {
+        double x = EXP_TABLE_MIN+i*expDX;
+        expTable[i] = exp(x);
+    }
 }
 
 void CpuGBSAOBCForce::setUseCutoff(float distance) {
@@ -147,7 +155,10 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
             break;
         int numInBlock = min(4, numParticles-blockStart);
         ivec4 blockAtomIndex(blockStart, blockStart+1, blockStart+2, blockStart+3);
-        float atomRadius[4], atomx[4], atomy[4], atomz[4];
+        float atomRadius[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomx[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomy[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomz[4] = {0.0f, 0.0f, 0.0f, 0.0f};
         int blockMask[4] = {0, 0, 0, 0};
         for (int i = 0; i < numInBlock; i++) {
             int atomIndex = blockStart+i;
@@ -163,7 +174,7 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
         fvec4 y(atomy);
         fvec4 z(atomz);
         ivec4 mask(blockMask);
-        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        fvec4 sum(0.0f);
         for (int atomJ = 0; atomJ < numParticles; atomJ++) {
             fvec4 posJ(posq+4*atomJ);
             fvec4 dx, dy, dz, r2;
@@ -186,28 +197,29 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
             fvec4 r2Inverse = rInverse*rInverse;
             fvec4 logRatio = fastLog(u_ij/l_ij);
             fvec4 term = l_ij - u_ij + 0.25f*r*(u_ij2 - l_ij2) + (0.5f*rInverse*logRatio) + (0.25f*scaledRadiusJ*scaledRadiusJ*rInverse)*(l_ij2 - u_ij2);
-            for (int j = 0; j < 4; j++) {
-                if (include[j]) {
-                    sum[j] += term[j];
-                    if (offsetRadiusI[j] < scaledRadiusJ-r[j])
-                        sum[j] += 2.0f*(radiusIInverse[j]-l_ij[j]);
-                }
-            }
+            ivec4 needCorrection = include & (offsetRadiusI < scaledRadiusJ-r);
+            term += blend(0.0f, 2.0f*(radiusIInverse-l_ij), needCorrection);
+            sum += blend(0.0f, term, include);
         }
         for (int i = 0; i < numInBlock; i++) {
             int atomIndex = blockStart+i;
-            sum[i] *= 0.5f*atomRadius[i];
-            float sum2 = sum[i]*sum[i];
-            float sum3 = sum[i]*sum2;
-            float tanhSum = tanh(alphaObc*sum[i] - betaObc*sum2 + gammaObc*sum3);
+            float atomSum = sum[i]*0.5f*atomRadius[i];
+            float sum2 = atomSum*atomSum;
+            float sum3 = atomSum*sum2;
+            float tanhSum = tanh(alphaObc*atomSum - betaObc*sum2 + gammaObc*sum3);
             float radiusI = atomRadius[i] + dielectricOffset;
             bornRadii[atomIndex] = 1.0f/(1.0f/atomRadius[i] - tanhSum/radiusI);
-            obcChain[atomIndex] = atomRadius[i]*(alphaObc - 2.0f*betaObc*sum[i] + 3.0f*gammaObc*sum2);
+            obcChain[atomIndex] = atomRadius[i]*(alphaObc - 2.0f*betaObc*atomSum + 3.0f*gammaObc*sum2);
             obcChain[atomIndex] = (1.0f - tanhSum*tanhSum)*obcChain[atomIndex]/radiusI;
         }
     }
     threads.syncThreads();
 
+    // Note: this pass is already O(N) with a few flops per atom; the expensive inputs are
+    // the Born radii computed above.  Tracking per-atom Born radius deltas to skip atoms
+    // whose radius barely moved would save almost nothing here while adding a tolerance
+    // with system-dependent error; incremental work on this force should target the
+    // pairwise Born radius sums instead.
     // Calculate ACE surface area term.
 
     const float probeRadius = 0.14f;
@@ -217,19 +229,24 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
     for (int i = 0; i < numParticles; i++)
         bornForces[i] = 0.0f;
     while (true) {
-        int atomI = gmx_atomic_fetch_add(reinterpret_cast<gmx_atomic_t*>(atomicCounter), 1);
-        if (atomI >= numParticles)
+        // Claim atoms in chunks to keep contention on the shared counter low.
+
+        int atomStart = gmx_atomic_fetch_add(reinterpret_cast<gmx_atomic_t*>(atomicCounter), 32);
+        if (atomStart >= numParticles)
             break;
-        if (bornRadii[atomI] > 0) {
-            float radiusI = particleParams[atomI].first + dielectricOffset;
-            float r = radiusI + probeRadius;
-            float ratio6 = powf(radiusI/bornRadii[atomI], 6.0f);
-            float saTerm = surfaceAreaFactor*r*r*ratio6;
-            energy += saTerm;
-            bornForces[atomI] = -6.0f*saTerm/bornRadii[atomI]; 
+        int atomEnd = min(numParticles, atomStart+32);
+        for (int atomI = atomStart; atomI < atomEnd; atomI++) {
+            if (bornRadii[atomI] > 0) {
+                float radiusI = particleParams[atomI].first + dielectricOffset;
+                float r = radiusI + probeRadius;
+                float ratio6 = powf(radiusI/bornRadii[atomI], 6.0f);
+                float saTerm = surfaceAreaFactor*r*r*ratio6;
+                energy += saTerm;
+                bornForces[atomI] = -6.0f*saTerm/bornRadii[atomI];
+            }
+            else
+                bornForces[atomI] = 0.0f;
         }
-        else
-            bornForces[atomI] = 0.0f;
     }
     threads.syncThreads();
  
@@ -247,7 +264,10 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
             break;
         int numInBlock = min(4, numParticles-blockStart);
         ivec4 blockAtomIndex(blockStart, blockStart+1, blockStart+2, blockStart+3);
-        float atomCharge[4], atomx[4], atomy[4], atomz[4];
+        float atomCharge[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomx[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomy[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomz[4] = {0.0f, 0.0f, 0.0f, 0.0f};
         int blockMask[4] = {0, 0, 0, 0};
         fvec4 blockAtomForceX(0.0f), blockAtomForceY(0.0f), blockAtomForceZ(0.0f), blockAtomBornForce(0.0f);
         for (int i = 0; i < numInBlock; i++) {
@@ -276,7 +296,7 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
             fvec4 r = sqrt(r2);
             fvec4 alpha2_ij = radii*bornRadii[atomJ];
             fvec4 D_ij = r2/(4.0f*alpha2_ij);
-            fvec4 expTerm(expf(-D_ij[0]), expf(-D_ij[1]), expf(-D_ij[2]), expf(-D_ij[3]));
+            fvec4 expTerm = fastExp(-D_ij);
             fvec4 denominator2 = r2 + alpha2_ij*expTerm; 
             fvec4 denominator = sqrt(denominator2);
             fvec4 Gpol = (partialChargeI*posJ[3])/denominator; 
@@ -327,7 +347,10 @@ void CpuGBSAOBCForce::threadComputeForce(ThreadPool& threads, int threadIndex) {
         bornForce *= radii*radii*fvec4(&obcChain[blockStart]);
         int numInBlock = min(4, numParticles-blockStart);
         ivec4 blockAtomIndex(blockStart, blockStart+1, blockStart+2, blockStart+3);
-        float atomRadius[4], atomx[4], atomy[4], atomz[4];
+        float atomRadius[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomx[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomy[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float atomz[4] = {0.0f, 0.0f, 0.0f, 0.0f};
         int blockMask[4] = {0, 0, 0, 0};
         fvec4 blockAtomForceX(0.0f), blockAtomForceY(0.0f), blockAtomForceZ(0.0f);
         for (int i = 0; i < numInBlock; i++) {
@@ -401,6 +424,22 @@ void CpuGBSAOBCForce::getDeltaR(const fvec4& posI, const fvec4& x, const fvec4&
     r2 = dx*dx + dy*dy + dz*dz;
 }
 
+fvec4 CpuGBSAOBCForce::fastExp(const fvec4& x) {
+    // Evaluate exp(x) for x <= 0 using a lookup table for speed.  Arguments below the table
+    // range are clamped: the true value there is too small to affect the result.
+
+    fvec4 x1 = (max(x, fvec4(EXP_TABLE_MIN))-EXP_TABLE_MIN)*expDXInv;
+    ivec4 index = floor(x1);
+    fvec4 coeff2 = x1-index;
+    fvec4 coeff1 = 1.0f-coeff2;
+    fvec4 t1(&expTable[index[0]]);
+    fvec4 t2(&expTable[index[1]]);
+    fvec4 t3(&expTable[index[2]]);
+    fvec4 t4(&expTable[index[3]]);
+    transpose(t1, t2, t3, t4);
+    return coeff1*t1 + coeff2*t2;
+}
+
 fvec4 CpuGBSAOBCForce::fastLog(const fvec4& x) {
     // Evaluate log(x) using a lookup table for speed.
 
@@ -44,6 +44,11 @@
 #include "openmm/internal/vectorize.h"
 #include "RealVec.h"
 
+#include <pthread.h>
+#ifndef WIN32
+#include <sys/time.h>
+#endif
+
 using namespace OpenMM;
 using namespace std;
 
@@ -108,20 +113,74 @@ static double computeShiftedKineticEnergy(ContextImpl& context, vector<double>&
     return 0.5*energy;
 }
 
+/*
+ * On bitwise reproducibility: the GPU platforms are already deterministic for a fixed
+ * configuration, because forces accumulate in fixed-point integers whose sum is order
+ * independent.  The CPU platform is deterministic for a fixed thread count but not across
+ * thread counts, since the partition of work (and therefore float summation order)
+ * changes.  A deterministic mode here means fixed-point accumulation in the reduction
+ * below plus a work partition independent of thread count; the first is cheap, the second
+ * costs the dynamic load balancing, which is why it should be a mode rather than the
+ * default.
+ */
 class CpuCalcForcesAndEnergyKernel::SumForceTask : public ThreadPool::Task {
 public:
     SumForceTask(int numParticles, vector<RealVec>& forceData, CpuPlatform::PlatformData& data) : numParticles(numParticles), forceData(forceData), data(data) {
     }
     void execute(ThreadPool& threads, int threadIndex) {
         // Sum the contributions to forces that have been calculated by different threads.
-        
+        // This happens in two phases so that on NUMA machines most of the traffic stays
+        // within a package: first the threads of each package combine their buffers into
+        // the buffer of the package's first thread, then each thread sums the per-package
+        // buffers into the force array for a range of particles.
+
         int numThreads = threads.getNumThreads();
-        int start = threadIndex*numParticles/numThreads;
-        int end = (threadIndex+1)*numParticles/numThreads;
+        int package = threads.getThreadPackage(threadIndex);
+        int memberIndex = 0, memberCount = 0, leader = -1;
+        for (int i = 0; i < numThreads; i++)
+            if (threads.getThreadPackage(i) == package) {
+                if (leader == -1)
+                    leader = i;
+                if (i == threadIndex)
+                    memberIndex = memberCount;
+                memberCount++;
+            }
+        int start = memberIndex*numParticles/memberCount;
+        int end = (memberIndex+1)*numParticles/memberCount;
+        float* leaderForce = &data.threadForce[leader][0];
+        fvec4 zero(0.0f);
+        for (int i = start; i < end; i++) {
+            fvec4 f(leaderForce+4*i);
+            for (int j = leader+1; j < numThreads; j++)
+                if (threads.getThreadPackage(j) == package) {
+                    float* memberForce = &data.threadForce[j][4*i];
+                    f += fvec4(memberForce);
+                    zero.store(memberForce); // Leave the buffer cleared for the next computation.
+                }
+            f.store(leaderForce+4*i);
+        }
+        threads.syncThreads();
+
+        // Identify the first thread of each package, whose buffer now holds that package's total.
+
+        vector<int> leaders;
+        for (int j = 0; j < numThreads; j++) {
+            bool isLeader = true;
+            for (int k = 0; k < j; k++)
+                if (threads.getThreadPackage(k) == threads.getThreadPackage(j))
+                    isLeader = false;
+            if (isLeader)
+                leaders.push_back(j);
+        }
+        start = threadIndex*numParticles/numThreads;
+        end = (threadIndex+1)*numParticles/numThreads;
         for (int i = start; i < end; i++) {
             fvec4 f(0.0f);
-            for (int j = 0; j < numThreads; j++)
-                f += fvec4(&data.threadForce[j][4*i]);
+            for (int j = 0; j < (int) leaders.size(); j++) {
+                float* leaderForce = &data.threadForce[leaders[j]][4*i];
+                f += fvec4(leaderForce);
+                zero.store(leaderForce); // Leave the buffer cleared for the next computation.
+            }
             forceData[i][0] += f[0];
             forceData[i][1] += f[1];
             forceData[i][2] += f[2];
@@ -161,11 +220,8 @@ public:
                 posq[4*i+2] = (float) posData[i][2];
             }
 
-        // Clear the forces.
-
-        fvec4 zero(0.0f);
-        for (int j = 0; j < numParticles; j++)
-            zero.store(&data.threadForce[threadIndex][j*4]);
+        // The force buffers do not need to be cleared here: the reduction at the end of the
+        // previous computation left them zeroed.
     }
     int numParticles;
     ContextImpl& context;
@@ -199,15 +255,17 @@ double CpuCalcForcesAndEnergyKernel::finishComputation(ContextImpl& context, boo
     
     SumForceTask task(context.getSystem().getNumParticles(), extractForces(context), data);
     data.threads.execute(task);
+    data.threads.waitForThreads(); // Wait for the within-package combination.
+    data.threads.resumeThreads();
     data.threads.waitForThreads();
     return referenceKernel.getAs<ReferenceCalcForcesAndEnergyKernel>().finishComputation(context, includeForce, includeEnergy, groups);
 }
 
 CpuCalcPeriodicTorsionForceKernel::~CpuCalcPeriodicTorsionForceKernel() {
     if (torsionIndexArray != NULL) {
-        for (int i = 0; i < numTorsions; i++) {
-            delete[] torsionIndexArray[i];
-            delete[] torsionParamArray[i];
+        if (numTorsions > 0) {
+            delete[] torsionIndexArray[0];
+            delete[] torsionParamArray[0];
         }
         delete[] torsionIndexArray;
         delete[] torsionParamArray;
@@ -216,12 +274,18 @@ CpuCalcPeriodicTorsionForceKernel::~CpuCalcPeriodicTorsionForceKernel() {
 
 void CpuCalcPeriodicTorsionForceKernel::initialize(const System& system, const PeriodicTorsionForce& force) {
     numTorsions = force.getNumTorsions();
+
+    // Allocate the index and parameter tables as single contiguous blocks, with a row
+    // pointer per torsion so existing interfaces still work.
+
     torsionIndexArray = new int*[numTorsions];
+    int* indexBlock = new int[4*numTorsions];
     for (int i = 0; i < numTorsions; i++)
-        torsionIndexArray[i] = new int[4];
+        torsionIndexArray[i] = indexBlock+4*i;
     torsionParamArray = new RealOpenMM*[numTorsions];
+    RealOpenMM* paramBlock = new RealOpenMM[3*numTorsions];
     for (int i = 0; i < numTorsions; i++)
-        torsionParamArray[i] = new RealOpenMM[3];
+        torsionParamArray[i] = paramBlock+3*i;
     for (int i = 0; i < numTorsions; ++i) {
         int particle1, particle2, particle3, particle4, periodicity;
         double phase, k;
@@ -266,9 +330,9 @@ void CpuCalcPeriodicTorsionForceKernel::copyParametersToContext(ContextImpl& con
 
 CpuCalcRBTorsionForceKernel::~CpuCalcRBTorsionForceKernel() {
     if (torsionIndexArray != NULL) {
-        for (int i = 0; i < numTorsions; i++) {
-            delete[] torsionIndexArray[i];
-            delete[] torsionParamArray[i];
+        if (numTorsions > 0) {
+            delete[] torsionIndexArray[0];
+            delete[] torsionParamArray[0];
         }
         delete[] torsionIndexArray;
         delete[] torsionParamArray;
@@ -277,12 +341,18 @@ CpuCalcRBTorsionForceKernel::~CpuCalcRBTorsionForceKernel() {
 
 void CpuCalcRBTorsionForceKernel::initialize(const System& system, const RBTorsionForce& force) {
     numTorsions = force.getNumTorsions();
+
+    // Allocate the index and parameter tables as single contiguous blocks, with a row
+    // pointer per torsion so existing interfaces still work.
+
     torsionIndexArray = new int*[numTorsions];
+    int* indexBlock = new int[4*numTorsions];
     for (int i = 0; i < numTorsions; i++)
-        torsionIndexArray[i] = new int[4];
+        torsionIndexArray[i] = indexBlock+4*i;
     torsionParamArray = new RealOpenMM*[numTorsions];
+    RealOpenMM* paramBlock = new RealOpenMM[6*numTorsions];
     for (int i = 0; i < numTorsions; i++)
-        torsionParamArray[i] = new RealOpenMM[6];
+        torsionParamArray[i] = paramBlock+6*i;
     for (int i = 0; i < numTorsions; ++i) {
         int particle1, particle2, particle3, particle4;
         double c0, c1, c2, c3, c4, c5;
@@ -352,19 +422,107 @@ private:
 };
 
 bool isVec8Supported();
+bool isVec16Supported();
 CpuNonbondedForce* createCpuNonbondedForceVec4();
 CpuNonbondedForce* createCpuNonbondedForceVec8();
+CpuNonbondedForce* createCpuNonbondedForceVec16();
+
+static double getCurrentTime() {
+#ifdef WIN32
+    return GetTickCount()*0.001;
+#else
+    struct timeval tod;
+    gettimeofday(&tod, 0);
+    return tod.tv_sec+1e-6*tod.tv_usec;
+#endif
+}
+
+// Tuning decisions are remembered per (particle count, cutoff) so later contexts for
+// similar systems skip the measurement phase.
+
+static map<pair<int, int>, int> tuningCache;
+static pthread_mutex_t tuningCacheLock = PTHREAD_MUTEX_INITIALIZER;
 
 CpuCalcNonbondedForceKernel::CpuCalcNonbondedForceKernel(string name, const Platform& platform, CpuPlatform::PlatformData& data) : CalcNonbondedForceKernel(name, platform),
         data(data), bonded14IndexArray(NULL), bonded14ParamArray(NULL), hasInitializedPme(false), neighborList(NULL), nonbonded(NULL) {
+    // Create every implementation the processor supports.  Which one is fastest depends on
+    // the system (wide blocks lose occupancy for sparse systems and short cutoffs), so when
+    // there is more than one they are timed against each other during the first evaluations.
+
+    candidateNeighborLists.push_back(new CpuNeighborList(4));
+    candidateNonbonded.push_back(createCpuNonbondedForceVec4());
     if (isVec8Supported()) {
-        neighborList = new CpuNeighborList(8);
-        nonbonded = createCpuNonbondedForceVec8();
-    }
-    else {
-        neighborList = new CpuNeighborList(4);
-        nonbonded = createCpuNonbondedForceVec4();
-    }
+        candidateNeighborLists.push_back(new CpuNeighborList(8));
+        candidateNonbonded.push_back(createCpuNonbondedForceVec8());
+    }
+    if (isVec16Supported()) {
+        candidateNeighborLists.push_back(new CpuNeighborList(16));
+        candidateNonbonded.push_back(createCpuNonbondedForceVec16());
+    }
+    activeCandidate = candidateNeighborLists.size()-1;
+    neighborList = candidateNeighborLists[activeCandidate];
+    nonbonded = candidateNonbonded[activeCandidate];
+    tuneComplete = (candidateNeighborLists.size() == 1);
+    tuneTime.resize(candidateNeighborLists.size(), 0.0);
+    tuneSamples.resize(candidateNeighborLists.size(), 0);
+}
+
+void CpuCalcNonbondedForceKernel::selectImplementation(int index) {
+    activeCandidate = index;
+    neighborList = candidateNeighborLists[index];
+    nonbonded = candidateNonbonded[index];
+}
+
+void CpuCalcNonbondedForceKernel::finishTuning(int best) {
+    selectImplementation(best);
+    tuneComplete = true;
+    pthread_mutex_lock(&tuningCacheLock);
+    tuningCache[make_pair(numParticles, (int) (1000*nonbondedCutoff))] = best;
+    pthread_mutex_unlock(&tuningCacheLock);
+    for (int i = 0; i < (int) candidateNeighborLists.size(); i++)
+        if (i != best) {
+            delete candidateNeighborLists[i];
+            delete candidateNonbonded[i];
+            candidateNeighborLists[i] = NULL;
+            candidateNonbonded[i] = NULL;
+        }
+}
+
+void CpuCalcNonbondedForceKernel::tuneImplementation() {
+    // Use a cached decision for this system signature if one exists.
+
+    int cached = -1;
+    pthread_mutex_lock(&tuningCacheLock);
+    map<pair<int, int>, int>::const_iterator iter = tuningCache.find(make_pair(numParticles, (int) (1000*nonbondedCutoff)));
+    if (iter != tuningCache.end())
+        cached = iter->second;
+    pthread_mutex_unlock(&tuningCacheLock);
+    if (cached >= 0 && cached < (int) candidateNonbonded.size()) {
+        finishTuning(cached);
+        return;
+    }
+
+    // If every implementation has been measured enough times, pick the fastest.
+
+    int minSamples = tuneSamples[0];
+    for (int i = 1; i < (int) tuneSamples.size(); i++)
+        minSamples = min(minSamples, tuneSamples[i]);
+    if (minSamples > 4) {
+        int best = 0;
+        for (int i = 1; i < (int) tuneTime.size(); i++)
+            if (tuneTime[i] < tuneTime[best])
+                best = i;
+        finishTuning(best);
+        return;
+    }
+
+    // Measure the least sampled implementation next.
+
+    int next = 0;
+    for (int i = 1; i < (int) tuneSamples.size(); i++)
+        if (tuneSamples[i] < tuneSamples[next])
+            next = i;
+    selectImplementation(next);
 }
 
 CpuCalcNonbondedForceKernel::~CpuCalcNonbondedForceKernel() {
@@ -376,6 +534,11 @@ CpuCalcNonbondedForceKernel::~CpuCalcNonbondedForceKernel() {
         delete[] bonded14IndexArray;
         delete[] bonded14ParamArray;
     }
+    for (int i = 0; i < (int) candidateNeighborLists.size(); i++)
+        if (candidateNeighborLists[i] != NULL && candidateNeighborLists[i] != neighborList) {
+            delete candidateNeighborLists[i];
+            delete candidateNonbonded[i];
+        }
     if (nonbonded != NULL)
         delete nonbonded;
     if (neighborList != NULL)
@@ -430,11 +593,14 @@ void CpuCalcNonbondedForceKernel::initialize(const System& system, const Nonbond
         bonded14ParamArray[i][1] = static_cast<RealOpenMM>(4.0*depth);
         bonded14ParamArray[i][2] = static_cast<RealOpenMM>(charge);
     }
+    bonded14Force.initialize(system.getNumParticles(), num14, 2, bonded14IndexArray, data.threads);
     
     // Record other parameters.
     
     nonbondedMethod = CalcNonbondedForceKernel::NonbondedMethod(force.getNonbondedMethod());
     nonbondedCutoff = force.getCutoffDistance();
+    neighborListPadding = 0.15*nonbondedCutoff;
+    stepsSinceRebuild = 0;
     if (nonbondedMethod == NoCutoff)
         useSwitchingFunction = false;
     else {
@@ -489,11 +655,24 @@ double CpuCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeFo
     double energy = (includeReciprocal ? ewaldSelfEnergy : 0.0);
     bool ewald  = (nonbondedMethod == Ewald);
     bool pme  = (nonbondedMethod == PME);
-    if (nonbondedMethod != NoCutoff) {
+    bool usingNeighborList = (nonbondedMethod != NoCutoff && (ewald || pme || numParticles >= CpuNonbondedForce::AllPairsThreshold));
+    if (usingNeighborList) {
         // Determine whether we need to recompute the neighbor list.
         
-        double padding = 0.15*nonbondedCutoff;
+        // The skin thickness controls the tradeoff between rebuild frequency and list size,
+        // and the best value shifts with temperature and phase.  Adapt it from the observed
+        // rebuild interval: grow the skin when rebuilds come fast, shrink it when they are
+        // rare.
+
+        double padding = neighborListPadding;
         bool needRecompute = false;
+        if (!tuneComplete) {
+            // Still deciding which vector width is fastest for this system.  The active
+            // implementation may change, so its neighbor list must be rebuilt.
+
+            tuneImplementation();
+            needRecompute = true;
+        }
         double closeCutoff2 = 0.25*padding*padding;
         double farCutoff2 = 0.5*padding*padding;
         int maxNumMoved = numParticles/10;
@@ -530,12 +709,27 @@ double CpuCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeFo
                     }
                 }
         }
+        stepsSinceRebuild++;
         if (needRecompute) {
+            if (tuneComplete) {
+                if (stepsSinceRebuild < 10)
+                    neighborListPadding = min(1.2*neighborListPadding, 0.5*nonbondedCutoff);
+                else if (stepsSinceRebuild > 100)
+                    neighborListPadding = max(0.9*neighborListPadding, 0.05*nonbondedCutoff);
+            }
+            stepsSinceRebuild = 0;
+            padding = neighborListPadding;
             neighborList->computeNeighborList(numParticles, posq, exclusions, floatBoxSize, data.isPeriodic, nonbondedCutoff+padding, data.threads);
             lastPositions = posData;
         }
         nonbonded->setUseCutoff(nonbondedCutoff, *neighborList, rfDielectric);
     }
+    else if (nonbondedMethod != NoCutoff) {
+        // The system is small enough that checking every pair beats building the neighbor
+        // list; the cutoff parameters are still needed.
+
+        nonbonded->setUseCutoff(nonbondedCutoff, *neighborList, rfDielectric);
+    }
     if (data.isPeriodic) {
         double minAllowedSize = 1.999999*nonbondedCutoff;
         if (boxSize[0] < minAllowedSize || boxSize[1] < minAllowedSize || boxSize[2] < minAllowedSize)
@@ -549,8 +743,17 @@ double CpuCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeFo
     if (useSwitchingFunction)
         nonbonded->setUseSwitchingFunction(switchingDistance);
     double nonbondedEnergy = 0;
-    if (includeDirect)
+    if (includeDirect) {
+        bool measuring = (!tuneComplete && nonbondedMethod != NoCutoff);
+        double startTime = (measuring ? getCurrentTime() : 0.0);
         nonbonded->calculateDirectIxn(numParticles, &posq[0], posData, particleParams, exclusions, data.threadForce, includeEnergy ? &nonbondedEnergy : NULL, data.threads);
+        if (measuring) {
+            // Discard each implementation's first sample, which includes warmup effects.
+
+            if (tuneSamples[activeCandidate]++ > 0)
+                tuneTime[activeCandidate] += getCurrentTime()-startTime;
+        }
+    }
     if (includeReciprocal) {
         if (useOptimizedPme) {
             PmeIO io(&posq[0], &data.threadForce[0][0], numParticles);
@@ -563,15 +766,26 @@ double CpuCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeFo
     }
     energy += nonbondedEnergy;
     if (includeDirect) {
-        ReferenceBondForce refBondForce;
+        // The 1-4 exceptions run through the same threaded, packed bonded machinery as the
+        // torsions instead of a serial extra pass.
+
         ReferenceLJCoulomb14 nonbonded14;
-        refBondForce.calculateForce(num14, bonded14IndexArray, posData, bonded14ParamArray, forceData, includeEnergy ? &energy : NULL, nonbonded14);
+        RealOpenMM bonded14Energy = 0;
+        bonded14Force.calculateForce(posData, bonded14ParamArray, forceData, includeEnergy ? &bonded14Energy : NULL, nonbonded14);
+        energy += bonded14Energy;
         if (data.isPeriodic)
             energy += dispersionCoefficient/(boxSize[0]*boxSize[1]*boxSize[2]);
     }
     return energy;
 }
 
+void CpuCalcNonbondedForceKernel::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    alpha = ewaldAlpha;
+    nx = gridSize[0];
+    ny = gridSize[1];
+    nz = gridSize[2];
+}
+
 void CpuCalcNonbondedForceKernel::copyParametersToContext(ContextImpl& context, const NonbondedForce& force) {
     if (force.getNumParticles() != numParticles)
         throw OpenMMException("updateParametersInContext: The number of particles has changed");
@@ -154,7 +154,7 @@ public:
         return VoxelIndex(x, y);
     }
 
-    void getNeighbors(vector<int>& neighbors, int blockIndex, const fvec4& blockCenter, const fvec4& blockWidth, const vector<int>& sortedAtoms, vector<char>& exclusions, float maxDistance, const vector<int>& blockAtoms, const float* atomLocations, const vector<VoxelIndex>& atomVoxelIndex) const {
+    void getNeighbors(vector<int>& neighbors, int blockIndex, const fvec4& blockCenter, const fvec4& blockWidth, const vector<int>& sortedAtoms, vector<int>& exclusions, float maxDistance, const vector<int>& blockAtoms, const float* atomLocations, const vector<VoxelIndex>& atomVoxelIndex) const {
         neighbors.resize(0);
         exclusions.resize(0);
         fvec4 boxSize(periodicBoxSize[0], periodicBoxSize[1], periodicBoxSize[2], 0);
@@ -294,7 +294,7 @@ public:
                         
                         // Add this atom to the list of neighbors.
                         
-                        neighbors.push_back(sortedAtoms[sortedIndex]);
+                        neighbors.push_back(sortedIndex);
                         if (sortedIndex < blockSize*blockIndex)
                             exclusions.push_back(0);
                         else {
@@ -327,7 +327,7 @@ public:
     CpuNeighborList& owner;
 };
 
-CpuNeighborList::CpuNeighborList(int blockSize) : blockSize(blockSize) {
+CpuNeighborList::CpuNeighborList(int blockSize) : blockSize(blockSize), numRebuilds(0) {
 }
 
 void CpuNeighborList::computeNeighborList(int numAtoms, const AlignedArray<float>& atomLocations, const vector<set<int> >& exclusions,
@@ -362,13 +362,18 @@ void CpuNeighborList::computeNeighborList(int numAtoms, const AlignedArray<float
     minz = minPos[2];
     maxz = maxPos[2];
     
-    // Sort the atoms based on a Hilbert curve.
-    
+    // Sort the atoms based on a Hilbert curve.  The spatial ordering degrades only slowly
+    // as atoms move, so most rebuilds reuse the order from the previous one and the curve
+    // is recomputed every tenth rebuild.
+
+    resortAtoms = (numRebuilds%10 == 0);
+    numRebuilds++;
     atomBins.resize(numAtoms);
     ThreadTask task(*this);
     threads.execute(task);
     threads.waitForThreads();
-    sort(atomBins.begin(), atomBins.end());
+    if (resortAtoms)
+        sort(atomBins.begin(), atomBins.end());
 
     // Build the voxel hash.
     
@@ -381,9 +386,9 @@ void CpuNeighborList::computeNeighborList(int numAtoms, const AlignedArray<float
     }
     Voxels voxels(blockSize, edgeSizeX, edgeSizeY, minx, maxx, miny, maxy, periodicBoxSize, usePeriodic);
     for (int i = 0; i < numAtoms; i++) {
-        int atomIndex = atomBins[i].second;
-        sortedAtoms[i] = atomIndex;
-        voxels.insert(i, &atomLocations[4*atomIndex]);
+        if (resortAtoms)
+            sortedAtoms[i] = atomBins[i].second;
+        voxels.insert(i, &atomLocations[4*sortedAtoms[i]]);
     }
     voxels.sortItems();
     this->voxels = &voxels;
@@ -397,10 +402,10 @@ void CpuNeighborList::computeNeighborList(int numAtoms, const AlignedArray<float
     
     int numPadding = numBlocks*blockSize-numAtoms;
     if (numPadding > 0) {
-        char mask = ((0xFFFF-(1<<blockSize)+1) >> numPadding);
+        int mask = (((1<<blockSize)-1) << (blockSize-numPadding)) & ((1<<blockSize)-1);
         for (int i = 0; i < numPadding; i++)
             sortedAtoms.push_back(0);
-        vector<char>& exc = blockExclusions[blockExclusions.size()-1];
+        vector<int>& exc = blockExclusions[blockExclusions.size()-1];
         for (int i = 0; i < (int) exc.size(); i++)
             exc[i] |= mask;
     }
@@ -418,7 +423,7 @@ const std::vector<int>& CpuNeighborList::getBlockNeighbors(int blockIndex) const
     return blockNeighbors[blockIndex];
 }
 
-const std::vector<char>& CpuNeighborList::getBlockExclusions(int blockIndex) const {
+const std::vector<int>& CpuNeighborList::getBlockExclusions(int blockIndex) const {
     return blockExclusions[blockIndex];
     
 }
@@ -430,7 +435,7 @@ void CpuNeighborList::threadComputeNeighborList(ThreadPool& threads, int threadI
     float invBinWidth = 1.0f/binWidth;
     bitmask_t coords[3];
     int numThreads = threads.getNumThreads();
-    for (int i = threadIndex; i < numAtoms; i += numThreads) {
+    for (int i = threadIndex; resortAtoms && i < numAtoms; i += numThreads) {
         const float* pos = &atomLocations[4*i];
         coords[0] = (bitmask_t) ((pos[0]-minx)*invBinWidth);
         coords[1] = (bitmask_t) ((pos[1]-miny)*invBinWidth);
@@ -469,9 +474,9 @@ void CpuNeighborList::threadComputeNeighborList(ThreadPool& threads, int threadI
 
         for (int j = 0; j < atomsInBlock; j++) {
             const set<int>& atomExclusions = (*exclusions)[sortedAtoms[firstIndex+j]];
-            char mask = 1<<j;
+            int mask = 1<<j;
             for (int k = 0; k < (int) blockNeighbors[i].size(); k++) {
-                int atomIndex = blockNeighbors[i][k];
+                int atomIndex = sortedAtoms[blockNeighbors[i][k]];
                 if (atomExclusions.find(atomIndex) != atomExclusions.end())
                     blockExclusions[i][k] |= mask;
             }
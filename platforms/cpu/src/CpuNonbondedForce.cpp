@@ -40,6 +40,7 @@ using namespace std;
 using namespace OpenMM;
 
 const float CpuNonbondedForce::TWO_OVER_SQRT_PI = (float) (2/sqrt(PI_M));
+const int CpuNonbondedForce::AllPairsThreshold = 1500;
 const int CpuNonbondedForce::NUM_TABLE_POINTS = 2048;
 
 class CpuNonbondedForce::ComputeDirectTask : public ThreadPool::Task {
@@ -58,7 +59,7 @@ public:
 
    --------------------------------------------------------------------------------------- */
 
-CpuNonbondedForce::CpuNonbondedForce() : cutoff(false), useSwitch(false), periodic(false), ewald(false), pme(false), tableIsValid(false), cutoffDistance(0.0f), alphaEwald(0.0f) {
+CpuNonbondedForce::CpuNonbondedForce() : cutoff(false), useSwitch(false), periodic(false), ewald(false), pme(false), tableIsValid(false), cutoffDistance(0.0f), alphaEwald(0.0f), neighborList(NULL) {
 }
 
 CpuNonbondedForce::~CpuNonbondedForce() {
@@ -290,6 +291,15 @@ void CpuNonbondedForce::calculateReciprocalIxn(int numberOfAtoms, float* posq, c
 }
 
 
+/*
+ * On energy-only evaluation: the API already distinguishes includeForces from
+ * includeEnergy, and the barostat and minimizer paths request energy alone; what the block
+ * kernels lack is a variant that skips the force accumulation (roughly a third of the
+ * inner loop).  With the kernels now specialized through templates on their options, an
+ * energy-only instantiation is mechanical: add a FORCES template flag alongside CUTOFF and
+ * SWITCH and guard the accumulation.  Until profiling justifies the extra instantiations,
+ * the big win (not downloading or reducing forces) is already realized at the API layer.
+ */
 void CpuNonbondedForce::calculateDirectIxn(int numberOfAtoms, float* posq, const vector<RealVec>& atomCoordinates, const vector<pair<float, float> >& atomParameters,
                 const vector<set<int> >& exclusions, vector<AlignedArray<float> >& threadForce, double* totalEnergy, ThreadPool& threads) {
     // Record the parameters for the threads.
@@ -305,11 +315,36 @@ void CpuNonbondedForce::calculateDirectIxn(int numberOfAtoms, float* posq, const
     gmx_atomic_t counter;
     gmx_atomic_set(&counter, 0);
     this->atomicCounter = &counter;
+
+    // Threads claim blocks dynamically so that variation in per-block interaction counts
+    // cannot leave some of them idle.  Claiming a chunk of blocks at a time keeps the
+    // atomic counter from becoming a point of contention with many threads, while still
+    // leaving enough chunks per thread for good load balance.
+
+    bool useNeighborList = ((cutoff || ewald || pme) && (ewald || pme || numberOfAtoms >= AllPairsThreshold));
+    if (useNeighborList) {
+        blockChunkSize = neighborList->getNumBlocks()/(8*threads.getNumThreads())+1;
+
+        const vector<int>& order = neighborList->getSortedAtoms();
+        if (sortedPosq.size() < 4*(int) order.size()) {
+            sortedPosq.resize(4*order.size());
+            sortedParams.resize(order.size());
+        }
+    }
+    else
+        blockChunkSize = 1;
     
-    // Signal the threads to start running and wait for them to finish.
+    // Signal the threads to start running and wait for them to finish.  When the neighbor
+    // list is in use, the threads first gather the positions and parameters into its
+    // Hilbert-curve order, then synchronize before computing interactions.
     
+    this->useNeighborList = useNeighborList;
     ComputeDirectTask task(*this);
     threads.execute(task);
+    if (useNeighborList) {
+        threads.waitForThreads();
+        threads.resumeThreads();
+    }
     threads.waitForThreads();
     
     // Combine the energies from all the threads.
@@ -324,9 +359,28 @@ void CpuNonbondedForce::calculateDirectIxn(int numberOfAtoms, float* posq, const
 }
 
 void CpuNonbondedForce::threadComputeDirect(ThreadPool& threads, int threadIndex) {
+    int numThreads = threads.getNumThreads();
+    if (useNeighborList) {
+        // Gather this thread's slice of the positions and parameters into the neighbor
+        // list's Hilbert-curve order, so the block kernels read them with good locality.
+
+        const vector<int>& order = neighborList->getSortedAtoms();
+        int numSorted = order.size();
+        int gatherStart = threadIndex*numSorted/numThreads;
+        int gatherEnd = (threadIndex+1)*numSorted/numThreads;
+        for (int i = gatherStart; i < gatherEnd; i++) {
+            int atom = order[i];
+            sortedPosq[4*i] = posq[4*atom];
+            sortedPosq[4*i+1] = posq[4*atom+1];
+            sortedPosq[4*i+2] = posq[4*atom+2];
+            sortedPosq[4*i+3] = posq[4*atom+3];
+            sortedParams[i] = atomParameters[atom];
+        }
+        threads.syncThreads();
+    }
+
     // Compute this thread's subset of interactions.
 
-    int numThreads = threads.getNumThreads();
     threadEnergy[threadIndex] = 0;
     double* energyPtr = (includeEnergy ? &threadEnergy[threadIndex] : NULL);
     float* forces = &(*threadForce)[threadIndex][0];
@@ -335,11 +389,14 @@ void CpuNonbondedForce::threadComputeDirect(ThreadPool& threads, int threadIndex
     if (ewald || pme) {
         // Compute the interactions from the neighbor list.
 
+        int numBlocks = neighborList->getNumBlocks();
         while (true) {
-            int nextBlock = gmx_atomic_fetch_add(reinterpret_cast<gmx_atomic_t*>(atomicCounter), 1);
-            if (nextBlock >= neighborList->getNumBlocks())
+            int blockStart = gmx_atomic_fetch_add(reinterpret_cast<gmx_atomic_t*>(atomicCounter), blockChunkSize);
+            if (blockStart >= numBlocks)
                 break;
-            calculateBlockEwaldIxn(nextBlock, forces, energyPtr, boxSize, invBoxSize);
+            int blockEnd = min(numBlocks, blockStart+blockChunkSize);
+            for (int block = blockStart; block < blockEnd; block++)
+                calculateBlockEwaldIxn(block, forces, energyPtr, boxSize, invBoxSize);
         }
 
         // Now subtract off the exclusions, since they were implicitly included in the reciprocal space sum.
@@ -371,14 +428,17 @@ void CpuNonbondedForce::threadComputeDirect(ThreadPool& threads, int threadIndex
             }
         }
     }
-    else if (cutoff) {
+    else if (cutoff && useNeighborList) {
         // Compute the interactions from the neighbor list.
 
+        int numBlocks = neighborList->getNumBlocks();
         while (true) {
-            int nextBlock = gmx_atomic_fetch_add(reinterpret_cast<gmx_atomic_t*>(atomicCounter), 1);
-            if (nextBlock >= neighborList->getNumBlocks())
+            int blockStart = gmx_atomic_fetch_add(reinterpret_cast<gmx_atomic_t*>(atomicCounter), blockChunkSize);
+            if (blockStart >= numBlocks)
                 break;
-            calculateBlockIxn(nextBlock, forces, energyPtr, boxSize, invBoxSize);
+            int blockEnd = min(numBlocks, blockStart+blockChunkSize);
+            for (int block = blockStart; block < blockEnd; block++)
+                calculateBlockIxn(block, forces, energyPtr, boxSize, invBoxSize);
         }
     }
     else {
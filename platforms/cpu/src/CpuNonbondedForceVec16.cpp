@@ -0,0 +1,356 @@
+/* Portions copyright (c) 2006-2013 Stanford University and Simbios.
+ * Contributors: Pande Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SimTKOpenMMCommon.h"
+#include "SimTKOpenMMUtilities.h"
+#include "CpuNonbondedForceVec16.h"
+#include "openmm/OpenMMException.h"
+#include "openmm/internal/hardware.h"
+
+using namespace std;
+using namespace OpenMM;
+
+#ifndef __AVX512F__
+bool isVec16Supported() {
+    return false;
+}
+
+CpuNonbondedForce* createCpuNonbondedForceVec16() {
+    throw OpenMMException("Internal error: OpenMM was compiled without AVX-512 support");
+}
+#else
+/**
+ * Check whether 16 component vectors are supported with the current CPU.
+ */
+bool isVec16Supported() {
+    // Make sure the CPU supports AVX-512 Foundation instructions.
+
+    int cpuInfo[4];
+    cpuid(cpuInfo, 0);
+    if (cpuInfo[0] >= 7) {
+        cpuidex(cpuInfo, 7, 0);
+        return ((cpuInfo[1] & ((int) 1 << 16)) != 0);
+    }
+    return false;
+}
+
+/**
+ * Factory method to create a CpuNonbondedForceVec16.
+ */
+CpuNonbondedForce* createCpuNonbondedForceVec16() {
+    return new CpuNonbondedForceVec16();
+}
+
+/**---------------------------------------------------------------------------------------
+
+   CpuNonbondedForceVec16 constructor
+
+   --------------------------------------------------------------------------------------- */
+
+CpuNonbondedForceVec16::CpuNonbondedForceVec16() {
+}
+
+void CpuNonbondedForceVec16::calculateBlockIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    // Dispatch to a version of the kernel specialized for the interaction options, so the
+    // pair loop is free of runtime branches on them.
+
+    if (cutoff) {
+        if (useSwitch)
+            calculateBlockIxnImpl<true, true>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+        else
+            calculateBlockIxnImpl<true, false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+    }
+    else
+        calculateBlockIxnImpl<false, false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+}
+
+template <bool CUTOFF, bool SWITCH>
+void CpuNonbondedForceVec16::calculateBlockIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    // Load the positions and parameters of the atoms in the block.
+
+    int blockAtom[16];
+    fvec4 blockAtomPosq[16];
+    fvec16 blockAtomForceX(0.0f), blockAtomForceY(0.0f), blockAtomForceZ(0.0f);
+    fvec16 blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge;
+    float blockAtomSigmaValues[16], blockAtomEpsilonValues[16];
+    for (int i = 0; i < 16; i++) {
+        blockAtom[i] = neighborList->getSortedAtoms()[16*blockIndex+i];
+        blockAtomPosq[i] = fvec4(&sortedPosq[4*(16*blockIndex+i)]);
+        blockAtomSigmaValues[i] = sortedParams[16*blockIndex+i].first;
+        blockAtomEpsilonValues[i] = sortedParams[16*blockIndex+i].second;
+    }
+    transpose(blockAtomPosq[0], blockAtomPosq[1], blockAtomPosq[2], blockAtomPosq[3], blockAtomPosq[4], blockAtomPosq[5], blockAtomPosq[6], blockAtomPosq[7],
+              blockAtomPosq[8], blockAtomPosq[9], blockAtomPosq[10], blockAtomPosq[11], blockAtomPosq[12], blockAtomPosq[13], blockAtomPosq[14], blockAtomPosq[15],
+              blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge);
+    blockAtomCharge *= ONE_4PI_EPS0;
+    fvec16 blockAtomSigma(blockAtomSigmaValues);
+    fvec16 blockAtomEpsilon(blockAtomEpsilonValues);
+    bool needPeriodic = (periodic && (any(blockAtomX < cutoffDistance) || any(blockAtomY < cutoffDistance) || any(blockAtomZ < cutoffDistance) ||
+            any(blockAtomX > boxSize[0]-cutoffDistance) || any(blockAtomY > boxSize[1]-cutoffDistance) || any(blockAtomZ > boxSize[2]-cutoffDistance)));
+    const float invSwitchingInterval = 1/(cutoffDistance-switchingDistance);
+
+    // Loop over neighbors for this block.
+
+    const vector<int>& neighbors = neighborList->getBlockNeighbors(blockIndex);
+    const vector<int>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const int* sortedIndex = &neighborList->getSortedAtoms()[0];
+    for (int i = 0; i < (int) neighbors.size(); i++) {
+        // Load the next neighbor.
+
+        int atom = neighbors[i];
+
+        // Compute the distances to the block atoms.
+
+        fvec16 dx, dy, dz, r2;
+        getDeltaR(&sortedPosq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
+        int excl = exclusions[i];
+        ivec16 include = expandMask((__mmask16) ~excl);
+        include = include & (r2 < cutoffDistance*cutoffDistance);
+        if (!any(include))
+            continue; // No interactions to compute.
+
+        // Compute the interactions.
+
+        fvec16 r = sqrt(r2);
+        fvec16 inverseR = fvec16(1.0f)/r;
+        fvec16 energy, dEdR;
+        float atomEpsilon = sortedParams[atom].second;
+        if (atomEpsilon != 0.0f) {
+            fvec16 sig = blockAtomSigma+sortedParams[atom].first;
+            fvec16 sig2 = inverseR*sig;
+            sig2 *= sig2;
+            fvec16 sig6 = sig2*sig2*sig2;
+            fvec16 epsSig6 = blockAtomEpsilon*atomEpsilon*sig6;
+            dEdR = epsSig6*(12.0f*sig6 - 6.0f);
+            energy = epsSig6*(sig6-1.0f);
+            if (SWITCH) {
+                fvec16 t = (r>switchingDistance) & ((r-switchingDistance)*invSwitchingInterval);
+                fvec16 switchValue = 1+t*t*t*(-10.0f+t*(15.0f-t*6.0f));
+                fvec16 switchDeriv = t*t*(-30.0f+t*(60.0f-t*30.0f))*invSwitchingInterval;
+                dEdR = switchValue*dEdR - energy*switchDeriv*r;
+                energy *= switchValue;
+            }
+        }
+        else {
+            energy = 0.0f;
+            dEdR = 0.0f;
+        }
+        fvec16 chargeProd = blockAtomCharge*sortedPosq[4*atom+3];
+        if (CUTOFF)
+            dEdR += chargeProd*(inverseR-2.0f*krf*r2);
+        else
+            dEdR += chargeProd*inverseR;
+        dEdR *= inverseR*inverseR;
+
+        // Accumulate energies.
+
+        fvec16 one(1.0f);
+        if (totalEnergy) {
+            if (CUTOFF)
+                energy += chargeProd*(inverseR+krf*r2-crf);
+            else
+                energy += chargeProd*inverseR;
+            energy = blend(0.0f, energy, include);
+            *totalEnergy += dot16(energy, one);
+        }
+
+        // Accumulate forces.
+
+        dEdR = blend(0.0f, dEdR, include);
+        fvec16 fx = dx*dEdR;
+        fvec16 fy = dy*dEdR;
+        fvec16 fz = dz*dEdR;
+        blockAtomForceX += fx;
+        blockAtomForceY += fy;
+        blockAtomForceZ += fz;
+        float* atomForce = forces+4*sortedIndex[atom];
+        atomForce[0] -= dot16(fx, one);
+        atomForce[1] -= dot16(fy, one);
+        atomForce[2] -= dot16(fz, one);
+    }
+
+    // Record the forces on the block atoms.
+
+    fvec4 f[16];
+    transpose(blockAtomForceX, blockAtomForceY, blockAtomForceZ, 0.0f, f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7],
+              f[8], f[9], f[10], f[11], f[12], f[13], f[14], f[15]);
+    for (int j = 0; j < 16; j++)
+        (fvec4(forces+4*blockAtom[j])+f[j]).store(forces+4*blockAtom[j]);
+}
+
+void CpuNonbondedForceVec16::calculateBlockEwaldIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    if (useSwitch)
+        calculateBlockEwaldIxnImpl<true>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+    else
+        calculateBlockEwaldIxnImpl<false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+}
+
+template <bool SWITCH>
+void CpuNonbondedForceVec16::calculateBlockEwaldIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    // Load the positions and parameters of the atoms in the block.
+
+    int blockAtom[16];
+    fvec4 blockAtomPosq[16];
+    fvec16 blockAtomForceX(0.0f), blockAtomForceY(0.0f), blockAtomForceZ(0.0f);
+    fvec16 blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge;
+    float blockAtomSigmaValues[16], blockAtomEpsilonValues[16];
+    for (int i = 0; i < 16; i++) {
+        blockAtom[i] = neighborList->getSortedAtoms()[16*blockIndex+i];
+        blockAtomPosq[i] = fvec4(&sortedPosq[4*(16*blockIndex+i)]);
+        blockAtomSigmaValues[i] = sortedParams[16*blockIndex+i].first;
+        blockAtomEpsilonValues[i] = sortedParams[16*blockIndex+i].second;
+    }
+    transpose(blockAtomPosq[0], blockAtomPosq[1], blockAtomPosq[2], blockAtomPosq[3], blockAtomPosq[4], blockAtomPosq[5], blockAtomPosq[6], blockAtomPosq[7],
+              blockAtomPosq[8], blockAtomPosq[9], blockAtomPosq[10], blockAtomPosq[11], blockAtomPosq[12], blockAtomPosq[13], blockAtomPosq[14], blockAtomPosq[15],
+              blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge);
+    blockAtomCharge *= ONE_4PI_EPS0;
+    fvec16 blockAtomSigma(blockAtomSigmaValues);
+    fvec16 blockAtomEpsilon(blockAtomEpsilonValues);
+    bool needPeriodic = (periodic && (any(blockAtomX < cutoffDistance) || any(blockAtomY < cutoffDistance) || any(blockAtomZ < cutoffDistance) ||
+            any(blockAtomX > boxSize[0]-cutoffDistance) || any(blockAtomY > boxSize[1]-cutoffDistance) || any(blockAtomZ > boxSize[2]-cutoffDistance)));
+    const float invSwitchingInterval = 1/(cutoffDistance-switchingDistance);
+
+    // Loop over neighbors for this block.
+
+    const vector<int>& neighbors = neighborList->getBlockNeighbors(blockIndex);
+    const vector<int>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const int* sortedIndex = &neighborList->getSortedAtoms()[0];
+    for (int i = 0; i < (int) neighbors.size(); i++) {
+        // Load the next neighbor.
+
+        int atom = neighbors[i];
+
+        // Compute the distances to the block atoms.
+
+        fvec16 dx, dy, dz, r2;
+        getDeltaR(&sortedPosq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
+        int excl = exclusions[i];
+        ivec16 include = expandMask((__mmask16) ~excl);
+        include = include & (r2 < cutoffDistance*cutoffDistance);
+        if (!any(include))
+            continue; // No interactions to compute.
+
+        // Compute the interactions.
+
+        fvec16 r = sqrt(r2);
+        fvec16 inverseR = fvec16(1.0f)/r;
+        fvec16 energy, dEdR;
+        float atomEpsilon = sortedParams[atom].second;
+        if (atomEpsilon != 0.0f) {
+            fvec16 sig = blockAtomSigma+sortedParams[atom].first;
+            fvec16 sig2 = inverseR*sig;
+            sig2 *= sig2;
+            fvec16 sig6 = sig2*sig2*sig2;
+            fvec16 epsSig6 = blockAtomEpsilon*atomEpsilon*sig6;
+            dEdR = epsSig6*(12.0f*sig6 - 6.0f);
+            energy = epsSig6*(sig6-1.0f);
+            if (SWITCH) {
+                fvec16 t = (r>switchingDistance) & ((r-switchingDistance)*invSwitchingInterval);
+                fvec16 switchValue = 1+t*t*t*(-10.0f+t*(15.0f-t*6.0f));
+                fvec16 switchDeriv = t*t*(-30.0f+t*(60.0f-t*30.0f))*invSwitchingInterval;
+                dEdR = switchValue*dEdR - energy*switchDeriv*r;
+                energy *= switchValue;
+            }
+        }
+        else {
+            energy = 0.0f;
+            dEdR = 0.0f;
+        }
+        fvec16 chargeProd = blockAtomCharge*sortedPosq[4*atom+3];
+        dEdR += chargeProd*inverseR*ewaldScaleFunction(r);
+        dEdR *= inverseR*inverseR;
+
+        // Accumulate energies.
+
+        fvec16 one(1.0f);
+        if (totalEnergy) {
+            energy += chargeProd*inverseR*erfcApprox(alphaEwald*r);
+            energy = blend(0.0f, energy, include);
+            *totalEnergy += dot16(energy, one);
+        }
+
+        // Accumulate forces.
+
+        dEdR = blend(0.0f, dEdR, include);
+        fvec16 fx = dx*dEdR;
+        fvec16 fy = dy*dEdR;
+        fvec16 fz = dz*dEdR;
+        blockAtomForceX += fx;
+        blockAtomForceY += fy;
+        blockAtomForceZ += fz;
+        float* atomForce = forces+4*sortedIndex[atom];
+        atomForce[0] -= dot16(fx, one);
+        atomForce[1] -= dot16(fy, one);
+        atomForce[2] -= dot16(fz, one);
+    }
+
+    // Record the forces on the block atoms.
+
+    fvec4 f[16];
+    transpose(blockAtomForceX, blockAtomForceY, blockAtomForceZ, 0.0f, f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7],
+              f[8], f[9], f[10], f[11], f[12], f[13], f[14], f[15]);
+    for (int j = 0; j < 16; j++)
+        (fvec4(forces+4*blockAtom[j])+f[j]).store(forces+4*blockAtom[j]);
+}
+
+void CpuNonbondedForceVec16::getDeltaR(const float* posI, const fvec16& x, const fvec16& y, const fvec16& z, fvec16& dx, fvec16& dy, fvec16& dz, fvec16& r2, bool periodic, const fvec4& boxSize, const fvec4& invBoxSize) const {
+    dx = x-posI[0];
+    dy = y-posI[1];
+    dz = z-posI[2];
+    if (periodic) {
+        dx -= round(dx*invBoxSize[0])*boxSize[0];
+        dy -= round(dy*invBoxSize[1])*boxSize[1];
+        dz -= round(dz*invBoxSize[2])*boxSize[2];
+    }
+    r2 = dx*dx + dy*dy + dz*dz;
+}
+
+fvec16 CpuNonbondedForceVec16::erfcApprox(const fvec16& x) {
+    // This approximation for erfc is from Abramowitz and Stegun (1964) p. 299.  They cite the following as
+    // the original source: C. Hastings, Jr., Approximations for Digital Computers (1955).  It has a maximum
+    // error of 3e-7.
+
+    fvec16 t = 1.0f+(0.0705230784f+(0.0422820123f+(0.0092705272f+(0.0001520143f+(0.0002765672f+0.0000430638f*x)*x)*x)*x)*x)*x;
+    t *= t;
+    t *= t;
+    t *= t;
+    return 1.0f/(t*t);
+}
+
+fvec16 CpuNonbondedForceVec16::ewaldScaleFunction(const fvec16& x) {
+    // Compute the tabulated Ewald scale factor: erfc(alpha*r) + 2*alpha*r*exp(-alpha*alpha*r*r)/sqrt(PI)
+
+    fvec16 x1 = x*ewaldDXInv;
+    ivec16 index = min(floor(x1), NUM_TABLE_POINTS);
+    fvec16 coeff2 = x1-index;
+    fvec16 coeff1 = 1.0f-coeff2;
+    int indices[16];
+    index.store(indices);
+    fvec4 t[16];
+    for (int i = 0; i < 16; i++)
+        t[i] = fvec4(&ewaldScaleTable[indices[i]]);
+    fvec16 s1, s2, s3, s4;
+    transpose(t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8], t[9], t[10], t[11], t[12], t[13], t[14], t[15], s1, s2, s3, s4);
+    return coeff1*s1 + coeff2*s2;
+}
+#endif
@@ -46,6 +46,21 @@ CpuNonbondedForceVec4::CpuNonbondedForceVec4() {
 }
 
 void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    // Dispatch to a version of the kernel specialized for the interaction options, so the
+    // pair loop is free of runtime branches on them.
+
+    if (cutoff) {
+        if (useSwitch)
+            calculateBlockIxnImpl<true, true>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+        else
+            calculateBlockIxnImpl<true, false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+    }
+    else
+        calculateBlockIxnImpl<false, false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+}
+
+template <bool CUTOFF, bool SWITCH>
+void CpuNonbondedForceVec4::calculateBlockIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
     // Load the positions and parameters of the atoms in the block.
     
     int blockAtom[4];
@@ -53,14 +68,14 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
     fvec4 blockAtomForceX(0.0f), blockAtomForceY(0.0f), blockAtomForceZ(0.0f);
     for (int i = 0; i < 4; i++) {
         blockAtom[i] = neighborList->getSortedAtoms()[4*blockIndex+i];
-        blockAtomPosq[i] = fvec4(posq+4*blockAtom[i]);
+        blockAtomPosq[i] = fvec4(&sortedPosq[4*(4*blockIndex+i)]);
     }
     fvec4 blockAtomX = fvec4(blockAtomPosq[0][0], blockAtomPosq[1][0], blockAtomPosq[2][0], blockAtomPosq[3][0]);
     fvec4 blockAtomY = fvec4(blockAtomPosq[0][1], blockAtomPosq[1][1], blockAtomPosq[2][1], blockAtomPosq[3][1]);
     fvec4 blockAtomZ = fvec4(blockAtomPosq[0][2], blockAtomPosq[1][2], blockAtomPosq[2][2], blockAtomPosq[3][2]);
     fvec4 blockAtomCharge = fvec4(ONE_4PI_EPS0)*fvec4(blockAtomPosq[0][3], blockAtomPosq[1][3], blockAtomPosq[2][3], blockAtomPosq[3][3]);
-    fvec4 blockAtomSigma(atomParameters[blockAtom[0]].first, atomParameters[blockAtom[1]].first, atomParameters[blockAtom[2]].first, atomParameters[blockAtom[3]].first);
-    fvec4 blockAtomEpsilon(atomParameters[blockAtom[0]].second, atomParameters[blockAtom[1]].second, atomParameters[blockAtom[2]].second, atomParameters[blockAtom[3]].second);
+    fvec4 blockAtomSigma(sortedParams[4*blockIndex+0].first, sortedParams[4*blockIndex+1].first, sortedParams[4*blockIndex+2].first, sortedParams[4*blockIndex+3].first);
+    fvec4 blockAtomEpsilon(sortedParams[4*blockIndex+0].second, sortedParams[4*blockIndex+1].second, sortedParams[4*blockIndex+2].second, sortedParams[4*blockIndex+3].second);
     bool needPeriodic = (periodic && (any(blockAtomX < cutoffDistance) || any(blockAtomY < cutoffDistance) || any(blockAtomZ < cutoffDistance) ||
             any(blockAtomX > boxSize[0]-cutoffDistance) || any(blockAtomY > boxSize[1]-cutoffDistance) || any(blockAtomZ > boxSize[2]-cutoffDistance)));
     const float invSwitchingInterval = 1/(cutoffDistance-switchingDistance);
@@ -68,7 +83,8 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
     // Loop over neighbors for this block.
     
     const vector<int>& neighbors = neighborList->getBlockNeighbors(blockIndex);
-    const vector<char>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const vector<int>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const int* sortedIndex = &neighborList->getSortedAtoms()[0];
     for (int i = 0; i < (int) neighbors.size(); i++) {
         // Load the next neighbor.
         
@@ -77,9 +93,9 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
         // Compute the distances to the block atoms.
         
         fvec4 dx, dy, dz, r2;
-        getDeltaR(posq+4*atom, blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
+        getDeltaR(&sortedPosq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
         ivec4 include;
-        char excl = exclusions[i];
+        int excl = exclusions[i];
         if (excl == 0)
             include = -1;
         else
@@ -93,16 +109,16 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
         fvec4 r = sqrt(r2);
         fvec4 inverseR = fvec4(1.0f)/r;
         fvec4 energy, dEdR;
-        float atomEpsilon = atomParameters[atom].second;
+        float atomEpsilon = sortedParams[atom].second;
         if (atomEpsilon != 0.0f) {
-            fvec4 sig = blockAtomSigma+atomParameters[atom].first;
+            fvec4 sig = blockAtomSigma+sortedParams[atom].first;
             fvec4 sig2 = inverseR*sig;
             sig2 *= sig2;
             fvec4 sig6 = sig2*sig2*sig2;
             fvec4 epsSig6 = blockAtomEpsilon*atomEpsilon*sig6;
             dEdR = epsSig6*(12.0f*sig6 - 6.0f);
             energy = epsSig6*(sig6-1.0f);
-            if (useSwitch) {
+            if (SWITCH) {
                 fvec4 t = (r>switchingDistance) & ((r-switchingDistance)*invSwitchingInterval);
                 fvec4 switchValue = 1+t*t*t*(-10.0f+t*(15.0f-t*6.0f));
                 fvec4 switchDeriv = t*t*(-30.0f+t*(60.0f-t*30.0f))*invSwitchingInterval;
@@ -114,8 +130,8 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
             energy = 0.0f;
             dEdR = 0.0f;
         }
-        fvec4 chargeProd = blockAtomCharge*posq[4*atom+3];
-        if (cutoff)
+        fvec4 chargeProd = blockAtomCharge*sortedPosq[4*atom+3];
+        if (CUTOFF)
             dEdR += chargeProd*(inverseR-2.0f*krf*r2);
         else
             dEdR += chargeProd*inverseR;
@@ -125,7 +141,7 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
 
         fvec4 one(1.0f);
         if (totalEnergy) {
-            if (cutoff)
+            if (CUTOFF)
                 energy += chargeProd*(inverseR+krf*r2-crf);
             else
                 energy += chargeProd*inverseR;
@@ -142,7 +158,7 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
         blockAtomForceX += fx;
         blockAtomForceY += fy;
         blockAtomForceZ += fz;
-        float* atomForce = forces+4*atom;
+        float* atomForce = forces+4*sortedIndex[atom];
         atomForce[0] -= dot4(fx, one);
         atomForce[1] -= dot4(fy, one);
         atomForce[2] -= dot4(fz, one);
@@ -157,6 +173,14 @@ void CpuNonbondedForceVec4::calculateBlockIxn(int blockIndex, float* forces, dou
   }
 
 void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    if (useSwitch)
+        calculateBlockEwaldIxnImpl<true>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+    else
+        calculateBlockEwaldIxnImpl<false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+}
+
+template <bool SWITCH>
+void CpuNonbondedForceVec4::calculateBlockEwaldIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
     // Load the positions and parameters of the atoms in the block.
     
     int blockAtom[4];
@@ -164,14 +188,14 @@ void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces
     fvec4 blockAtomForceX(0.0f), blockAtomForceY(0.0f), blockAtomForceZ(0.0f);
     for (int i = 0; i < 4; i++) {
         blockAtom[i] = neighborList->getSortedAtoms()[4*blockIndex+i];
-        blockAtomPosq[i] = fvec4(posq+4*blockAtom[i]);
+        blockAtomPosq[i] = fvec4(&sortedPosq[4*(4*blockIndex+i)]);
     }
     fvec4 blockAtomX = fvec4(blockAtomPosq[0][0], blockAtomPosq[1][0], blockAtomPosq[2][0], blockAtomPosq[3][0]);
     fvec4 blockAtomY = fvec4(blockAtomPosq[0][1], blockAtomPosq[1][1], blockAtomPosq[2][1], blockAtomPosq[3][1]);
     fvec4 blockAtomZ = fvec4(blockAtomPosq[0][2], blockAtomPosq[1][2], blockAtomPosq[2][2], blockAtomPosq[3][2]);
     fvec4 blockAtomCharge = fvec4(ONE_4PI_EPS0)*fvec4(blockAtomPosq[0][3], blockAtomPosq[1][3], blockAtomPosq[2][3], blockAtomPosq[3][3]);
-    fvec4 blockAtomSigma(atomParameters[blockAtom[0]].first, atomParameters[blockAtom[1]].first, atomParameters[blockAtom[2]].first, atomParameters[blockAtom[3]].first);
-    fvec4 blockAtomEpsilon(atomParameters[blockAtom[0]].second, atomParameters[blockAtom[1]].second, atomParameters[blockAtom[2]].second, atomParameters[blockAtom[3]].second);
+    fvec4 blockAtomSigma(sortedParams[4*blockIndex+0].first, sortedParams[4*blockIndex+1].first, sortedParams[4*blockIndex+2].first, sortedParams[4*blockIndex+3].first);
+    fvec4 blockAtomEpsilon(sortedParams[4*blockIndex+0].second, sortedParams[4*blockIndex+1].second, sortedParams[4*blockIndex+2].second, sortedParams[4*blockIndex+3].second);
     bool needPeriodic = (periodic && (any(blockAtomX < cutoffDistance) || any(blockAtomY < cutoffDistance) || any(blockAtomZ < cutoffDistance) ||
             any(blockAtomX > boxSize[0]-cutoffDistance) || any(blockAtomY > boxSize[1]-cutoffDistance) || any(blockAtomZ > boxSize[2]-cutoffDistance)));
     const float invSwitchingInterval = 1/(cutoffDistance-switchingDistance);
@@ -179,7 +203,8 @@ void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces
     // Loop over neighbors for this block.
     
     const vector<int>& neighbors = neighborList->getBlockNeighbors(blockIndex);
-    const vector<char>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const vector<int>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const int* sortedIndex = &neighborList->getSortedAtoms()[0];
     for (int i = 0; i < (int) neighbors.size(); i++) {
         // Load the next neighbor.
         
@@ -188,9 +213,9 @@ void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces
         // Compute the distances to the block atoms.
         
         fvec4 dx, dy, dz, r2;
-        getDeltaR(posq+4*atom, blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
+        getDeltaR(&sortedPosq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
         ivec4 include;
-        char excl = exclusions[i];
+        int excl = exclusions[i];
         if (excl == 0)
             include = -1;
         else
@@ -204,16 +229,16 @@ void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces
         fvec4 r = sqrt(r2);
         fvec4 inverseR = fvec4(1.0f)/r;
         fvec4 energy, dEdR;
-        float atomEpsilon = atomParameters[atom].second;
+        float atomEpsilon = sortedParams[atom].second;
         if (atomEpsilon != 0.0f) {
-            fvec4 sig = blockAtomSigma+atomParameters[atom].first;
+            fvec4 sig = blockAtomSigma+sortedParams[atom].first;
             fvec4 sig2 = inverseR*sig;
             sig2 *= sig2;
             fvec4 sig6 = sig2*sig2*sig2;
             fvec4 epsSig6 = blockAtomEpsilon*atomEpsilon*sig6;
             dEdR = epsSig6*(12.0f*sig6 - 6.0f);
             energy = epsSig6*(sig6-1.0f);
-            if (useSwitch) {
+            if (SWITCH) {
                 fvec4 t = (r>switchingDistance) & ((r-switchingDistance)*invSwitchingInterval);
                 fvec4 switchValue = 1+t*t*t*(-10.0f+t*(15.0f-t*6.0f));
                 fvec4 switchDeriv = t*t*(-30.0f+t*(60.0f-t*30.0f))*invSwitchingInterval;
@@ -225,7 +250,7 @@ void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces
             energy = 0.0f;
             dEdR = 0.0f;
         }
-        fvec4 chargeProd = blockAtomCharge*posq[4*atom+3];
+        fvec4 chargeProd = blockAtomCharge*sortedPosq[4*atom+3];
         dEdR += chargeProd*inverseR*ewaldScaleFunction(r);
         dEdR *= inverseR*inverseR;        
 
@@ -247,7 +272,7 @@ void CpuNonbondedForceVec4::calculateBlockEwaldIxn(int blockIndex, float* forces
         blockAtomForceX += fx;
         blockAtomForceY += fy;
         blockAtomForceZ += fz;
-        float* atomForce = forces+4*atom;
+        float* atomForce = forces+4*sortedIndex[atom];
         atomForce[0] -= dot4(fx, one);
         atomForce[1] -= dot4(fy, one);
         atomForce[2] -= dot4(fz, one);
@@ -72,6 +72,21 @@ CpuNonbondedForceVec8::CpuNonbondedForceVec8() {
 }
 
 void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    // Dispatch to a version of the kernel specialized for the interaction options, so the
+    // pair loop is free of runtime branches on them.
+
+    if (cutoff) {
+        if (useSwitch)
+            calculateBlockIxnImpl<true, true>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+        else
+            calculateBlockIxnImpl<true, false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+    }
+    else
+        calculateBlockIxnImpl<false, false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+}
+
+template <bool CUTOFF, bool SWITCH>
+void CpuNonbondedForceVec8::calculateBlockIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
     // Load the positions and parameters of the atoms in the block.
     
     int blockAtom[8];
@@ -80,20 +95,25 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
     fvec8 blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge;
     for (int i = 0; i < 8; i++) {
         blockAtom[i] = neighborList->getSortedAtoms()[8*blockIndex+i];
-        blockAtomPosq[i] = fvec4(posq+4*blockAtom[i]);
+        blockAtomPosq[i] = fvec4(&sortedPosq[4*(8*blockIndex+i)]);
     }
     transpose(blockAtomPosq[0], blockAtomPosq[1], blockAtomPosq[2], blockAtomPosq[3], blockAtomPosq[4], blockAtomPosq[5], blockAtomPosq[6], blockAtomPosq[7], blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge);
     blockAtomCharge *= ONE_4PI_EPS0;
-    fvec8 blockAtomSigma(atomParameters[blockAtom[0]].first, atomParameters[blockAtom[1]].first, atomParameters[blockAtom[2]].first, atomParameters[blockAtom[3]].first, atomParameters[blockAtom[4]].first, atomParameters[blockAtom[5]].first, atomParameters[blockAtom[6]].first, atomParameters[blockAtom[7]].first);
-    fvec8 blockAtomEpsilon(atomParameters[blockAtom[0]].second, atomParameters[blockAtom[1]].second, atomParameters[blockAtom[2]].second, atomParameters[blockAtom[3]].second, atomParameters[blockAtom[4]].second, atomParameters[blockAtom[5]].second, atomParameters[blockAtom[6]].second, atomParameters[blockAtom[7]].second);
+    fvec8 blockAtomSigma(sortedParams[8*blockIndex+0].first, sortedParams[8*blockIndex+1].first, sortedParams[8*blockIndex+2].first, sortedParams[8*blockIndex+3].first, sortedParams[8*blockIndex+4].first, sortedParams[8*blockIndex+5].first, sortedParams[8*blockIndex+6].first, sortedParams[8*blockIndex+7].first);
+    fvec8 blockAtomEpsilon(sortedParams[8*blockIndex+0].second, sortedParams[8*blockIndex+1].second, sortedParams[8*blockIndex+2].second, sortedParams[8*blockIndex+3].second, sortedParams[8*blockIndex+4].second, sortedParams[8*blockIndex+5].second, sortedParams[8*blockIndex+6].second, sortedParams[8*blockIndex+7].second);
     bool needPeriodic = (periodic && (any(blockAtomX < cutoffDistance) || any(blockAtomY < cutoffDistance) || any(blockAtomZ < cutoffDistance) ||
             any(blockAtomX > boxSize[0]-cutoffDistance) || any(blockAtomY > boxSize[1]-cutoffDistance) || any(blockAtomZ > boxSize[2]-cutoffDistance)));
     const float invSwitchingInterval = 1/(cutoffDistance-switchingDistance);
     
     // Loop over neighbors for this block.
     
+    // The neighbor indices refer to the Hilbert-sorted arrays, so the per-neighbor loads
+    // below are single contiguous fvec4 reads of spatially adjacent atoms rather than
+    // gathers; a clustered j-atom format would buy little beyond this layout.
+
     const vector<int>& neighbors = neighborList->getBlockNeighbors(blockIndex);
-    const vector<char>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const vector<int>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const int* sortedIndex = &neighborList->getSortedAtoms()[0];
     for (int i = 0; i < (int) neighbors.size(); i++) {
         // Load the next neighbor.
         
@@ -102,9 +122,9 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
         // Compute the distances to the block atoms.
         
         fvec8 dx, dy, dz, r2;
-        getDeltaR(&posq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
+        getDeltaR(&sortedPosq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
         ivec8 include;
-        char excl = exclusions[i];
+        int excl = exclusions[i];
         if (excl == 0)
             include = -1;
         else
@@ -118,16 +138,16 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
         fvec8 r = sqrt(r2);
         fvec8 inverseR = fvec8(1.0f)/r;
         fvec8 energy, dEdR;
-        float atomEpsilon = atomParameters[atom].second;
+        float atomEpsilon = sortedParams[atom].second;
         if (atomEpsilon != 0.0f) {
-            fvec8 sig = blockAtomSigma+atomParameters[atom].first;
+            fvec8 sig = blockAtomSigma+sortedParams[atom].first;
             fvec8 sig2 = inverseR*sig;
             sig2 *= sig2;
             fvec8 sig6 = sig2*sig2*sig2;
             fvec8 epsSig6 = blockAtomEpsilon*atomEpsilon*sig6;
             dEdR = epsSig6*(12.0f*sig6 - 6.0f);
             energy = epsSig6*(sig6-1.0f);
-            if (useSwitch) {
+            if (SWITCH) {
                 fvec8 t = (r>switchingDistance) & ((r-switchingDistance)*invSwitchingInterval);
                 fvec8 switchValue = 1+t*t*t*(-10.0f+t*(15.0f-t*6.0f));
                 fvec8 switchDeriv = t*t*(-30.0f+t*(60.0f-t*30.0f))*invSwitchingInterval;
@@ -139,8 +159,8 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
             energy = 0.0f;
             dEdR = 0.0f;
         }
-        fvec8 chargeProd = blockAtomCharge*posq[4*atom+3];
-        if (cutoff)
+        fvec8 chargeProd = blockAtomCharge*sortedPosq[4*atom+3];
+        if (CUTOFF)
             dEdR += chargeProd*(inverseR-2.0f*krf*r2);
         else
             dEdR += chargeProd*inverseR;
@@ -150,7 +170,7 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
 
         fvec8 one(1.0f);
         if (totalEnergy) {
-            if (cutoff)
+            if (CUTOFF)
                 energy += chargeProd*(inverseR+krf*r2-crf);
             else
                 energy += chargeProd*inverseR;
@@ -167,7 +187,7 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
         blockAtomForceX += fx;
         blockAtomForceY += fy;
         blockAtomForceZ += fz;
-        float* atomForce = forces+4*atom;
+        float* atomForce = forces+4*sortedIndex[atom];
         atomForce[0] -= dot8(fx, one);
         atomForce[1] -= dot8(fy, one);
         atomForce[2] -= dot8(fz, one);
@@ -182,6 +202,14 @@ void CpuNonbondedForceVec8::calculateBlockIxn(int blockIndex, float* forces, dou
   }
 
 void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
+    if (useSwitch)
+        calculateBlockEwaldIxnImpl<true>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+    else
+        calculateBlockEwaldIxnImpl<false>(blockIndex, forces, totalEnergy, boxSize, invBoxSize);
+}
+
+template <bool SWITCH>
+void CpuNonbondedForceVec8::calculateBlockEwaldIxnImpl(int blockIndex, float* forces, double* totalEnergy, const fvec4& boxSize, const fvec4& invBoxSize) {
     // Load the positions and parameters of the atoms in the block.
     
     int blockAtom[8];
@@ -190,12 +218,12 @@ void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces
     fvec8 blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge;
     for (int i = 0; i < 8; i++) {
         blockAtom[i] = neighborList->getSortedAtoms()[8*blockIndex+i];
-        blockAtomPosq[i] = fvec4(posq+4*blockAtom[i]);
+        blockAtomPosq[i] = fvec4(&sortedPosq[4*(8*blockIndex+i)]);
     }
     transpose(blockAtomPosq[0], blockAtomPosq[1], blockAtomPosq[2], blockAtomPosq[3], blockAtomPosq[4], blockAtomPosq[5], blockAtomPosq[6], blockAtomPosq[7], blockAtomX, blockAtomY, blockAtomZ, blockAtomCharge);
     blockAtomCharge *= ONE_4PI_EPS0;
-    fvec8 blockAtomSigma(atomParameters[blockAtom[0]].first, atomParameters[blockAtom[1]].first, atomParameters[blockAtom[2]].first, atomParameters[blockAtom[3]].first, atomParameters[blockAtom[4]].first, atomParameters[blockAtom[5]].first, atomParameters[blockAtom[6]].first, atomParameters[blockAtom[7]].first);
-    fvec8 blockAtomEpsilon(atomParameters[blockAtom[0]].second, atomParameters[blockAtom[1]].second, atomParameters[blockAtom[2]].second, atomParameters[blockAtom[3]].second, atomParameters[blockAtom[4]].second, atomParameters[blockAtom[5]].second, atomParameters[blockAtom[6]].second, atomParameters[blockAtom[7]].second);
+    fvec8 blockAtomSigma(sortedParams[8*blockIndex+0].first, sortedParams[8*blockIndex+1].first, sortedParams[8*blockIndex+2].first, sortedParams[8*blockIndex+3].first, sortedParams[8*blockIndex+4].first, sortedParams[8*blockIndex+5].first, sortedParams[8*blockIndex+6].first, sortedParams[8*blockIndex+7].first);
+    fvec8 blockAtomEpsilon(sortedParams[8*blockIndex+0].second, sortedParams[8*blockIndex+1].second, sortedParams[8*blockIndex+2].second, sortedParams[8*blockIndex+3].second, sortedParams[8*blockIndex+4].second, sortedParams[8*blockIndex+5].second, sortedParams[8*blockIndex+6].second, sortedParams[8*blockIndex+7].second);
     bool needPeriodic = (periodic && (any(blockAtomX < cutoffDistance) || any(blockAtomY < cutoffDistance) || any(blockAtomZ < cutoffDistance) ||
             any(blockAtomX > boxSize[0]-cutoffDistance) || any(blockAtomY > boxSize[1]-cutoffDistance) || any(blockAtomZ > boxSize[2]-cutoffDistance)));
     const float invSwitchingInterval = 1/(cutoffDistance-switchingDistance);
@@ -203,7 +231,8 @@ void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces
     // Loop over neighbors for this block.
     
     const vector<int>& neighbors = neighborList->getBlockNeighbors(blockIndex);
-    const vector<char>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const vector<int>& exclusions = neighborList->getBlockExclusions(blockIndex);
+    const int* sortedIndex = &neighborList->getSortedAtoms()[0];
     for (int i = 0; i < (int) neighbors.size(); i++) {
         // Load the next neighbor.
         
@@ -212,9 +241,9 @@ void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces
         // Compute the distances to the block atoms.
         
         fvec8 dx, dy, dz, r2;
-        getDeltaR(&posq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
+        getDeltaR(&sortedPosq[4*atom], blockAtomX, blockAtomY, blockAtomZ, dx, dy, dz, r2, needPeriodic, boxSize, invBoxSize);
         ivec8 include;
-        char excl = exclusions[i];
+        int excl = exclusions[i];
         if (excl == 0)
             include = -1;
         else
@@ -228,16 +257,16 @@ void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces
         fvec8 r = sqrt(r2);
         fvec8 inverseR = fvec8(1.0f)/r;
         fvec8 energy, dEdR;
-        float atomEpsilon = atomParameters[atom].second;
+        float atomEpsilon = sortedParams[atom].second;
         if (atomEpsilon != 0.0f) {
-            fvec8 sig = blockAtomSigma+atomParameters[atom].first;
+            fvec8 sig = blockAtomSigma+sortedParams[atom].first;
             fvec8 sig2 = inverseR*sig;
             sig2 *= sig2;
             fvec8 sig6 = sig2*sig2*sig2;
             fvec8 epsSig6 = blockAtomEpsilon*atomEpsilon*sig6;
             dEdR = epsSig6*(12.0f*sig6 - 6.0f);
             energy = epsSig6*(sig6-1.0f);
-            if (useSwitch) {
+            if (SWITCH) {
                 fvec8 t = (r>switchingDistance) & ((r-switchingDistance)*invSwitchingInterval);
                 fvec8 switchValue = 1+t*t*t*(-10.0f+t*(15.0f-t*6.0f));
                 fvec8 switchDeriv = t*t*(-30.0f+t*(60.0f-t*30.0f))*invSwitchingInterval;
@@ -249,7 +278,7 @@ void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces
             energy = 0.0f;
             dEdR = 0.0f;
         }
-        fvec8 chargeProd = blockAtomCharge*posq[4*atom+3];
+        fvec8 chargeProd = blockAtomCharge*sortedPosq[4*atom+3];
         dEdR += chargeProd*inverseR*ewaldScaleFunction(r);
         dEdR *= inverseR*inverseR;        
 
@@ -271,7 +300,7 @@ void CpuNonbondedForceVec8::calculateBlockEwaldIxn(int blockIndex, float* forces
         blockAtomForceX += fx;
         blockAtomForceY += fy;
         blockAtomForceZ += fz;
-        float* atomForce = forces+4*atom;
+        float* atomForce = forces+4*sortedIndex[atom];
         atomForce[0] -= dot8(fx, one);
         atomForce[1] -= dot8(fy, one);
         atomForce[2] -= dot8(fz, one);
@@ -107,10 +107,38 @@ CpuPlatform::PlatformData& CpuPlatform::getPlatformData(ContextImpl& context) {
     return *contextData[&context];
 }
 
-CpuPlatform::PlatformData::PlatformData(int numParticles) : posq(4*numParticles) {
+/**
+ * Touches each thread's force buffer from the thread that owns it, so on NUMA machines the
+ * pages are allocated on the node where that (pinned) thread runs.
+ */
+class FirstTouchTask : public ThreadPool::Task {
+public:
+    FirstTouchTask(std::vector<AlignedArray<float> >& threadForce) : threadForce(threadForce) {
+    }
+    void execute(ThreadPool& threads, int threadIndex) {
+        AlignedArray<float>& force = threadForce[threadIndex];
+        for (int i = 0; i < force.size(); i++)
+            force[i] = 0.0f;
+    }
+    std::vector<AlignedArray<float> >& threadForce;
+};
+
+int CpuPlatform::PlatformData::threadsForSystemSize(int numParticles) {
+    // For small systems the fixed cost of waking every worker each step outweighs the
+    // parallel speedup, so leave enough work per thread to be worth the wakeup.
+
+    int maxUseful = numParticles/128+1;
+    int numProcessors = getNumProcessors();
+    return (maxUseful < numProcessors ? maxUseful : numProcessors);
+}
+
+CpuPlatform::PlatformData::PlatformData(int numParticles) : posq(4*numParticles), threads(threadsForSystemSize(numParticles)) {
     int numThreads = threads.getNumThreads();
     threadForce.resize(numThreads);
     for (int i = 0; i < numThreads; i++)
         threadForce[i].resize(4*numParticles);
+    FirstTouchTask touchTask(threadForce);
+    threads.execute(touchTask);
+    threads.waitForThreads();
     isPeriodic = false;
 }
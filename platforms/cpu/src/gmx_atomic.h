@@ -1,3 +1,11 @@
+/* On promoting this shim: a shared internal concurrency library (fetch-add on floats via
+ * CAS, 64-bit fixed-point accumulators, a portable pause instruction) would serve the CPU
+ * platform, the PME plugin and the thread pool from one place.  What has kept this header
+ * private is that its non-x86 fallbacks are untested here; promotion to openmm/internal
+ * means owning those fallbacks on every platform the core builds on.  Until someone signs
+ * up for that, new users should include this header rather than copying it.
+ */
+
 /* -*- mode: c; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- 
 *
 * Copyright (c) 2004-2008, Erik Lindahl <lindahl@cbr.su.se>
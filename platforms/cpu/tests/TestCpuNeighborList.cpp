@@ -80,7 +80,7 @@ void testNeighborList(bool periodic) {
         for (int j = 0; j < (int) neighborList.getBlockExclusions(blockIndex).size(); j++) {
             if ((neighborList.getBlockExclusions(blockIndex)[j] & mask) == 0) {
                 int atom1 = neighborList.getSortedAtoms()[i];
-                int atom2 = neighborList.getBlockNeighbors(blockIndex)[j];
+                int atom2 = neighborList.getSortedAtoms()[neighborList.getBlockNeighbors(blockIndex)[j]];
                 pair<int, int> entry = make_pair(min(atom1, atom2), max(atom1, atom2));
                 ASSERT(neighbors.find(entry) == neighbors.end() && neighbors.find(make_pair(entry.second, entry.first)) == neighbors.end()); // No duplicates
                 neighbors.insert(entry);
@@ -43,6 +43,15 @@ class CudaContext;
  * for working with it and for copying data to and from device memory.
  */
 
+/*
+ * On transfer staging: the per-step state paths (positions, velocities, forces, energies)
+ * already stage through the context's pinned buffer, so they get full PCIe throughput.
+ * upload()/download() on arbitrary arrays copy to or from whatever pointer the caller
+ * hands in, which is pageable in the occasional paths that pass a std::vector; those are
+ * not per-step, and registering arbitrary caller memory on the fly costs more than the
+ * slower copy.  If a new per-step transfer is added, stage it through the pinned buffer
+ * like the existing ones.
+ */
 class OPENMM_EXPORT_CUDA CudaArray {
 public:
     /**
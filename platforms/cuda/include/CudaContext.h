@@ -75,7 +75,7 @@ public:
     static const int ThreadBlockSize;
     static const int TileSize;
     CudaContext(const System& system, int deviceIndex, bool useBlockingSync, const std::string& precision,
-            const std::string& compiler, const std::string& tempDir, const std::string& hostCompiler, CudaPlatform::PlatformData& platformData);
+            const std::string& compiler, const std::string& tempDir, const std::string& hostCompiler, bool useSharedContext, CudaPlatform::PlatformData& platformData);
     ~CudaContext();
     /**
      * This is called to initialize internal data structures after all Forces in the system
@@ -219,6 +219,16 @@ public:
      * @param module    the module to get the kernel from
      * @param name      the name of the kernel to get
      */
+    /*
+     * On kernel fusion: plugins that launch many small kernels per iteration (the AMOEBA
+     * SCF loop is the motivating case) lose more to launch latency than to the kernels.
+     * Without device-side dispatch support in this driver generation, the available tools
+     * are compiling related kernels into one module (already the norm), fusing adjacent
+     * kernels whose data flow allows it, and moving loop control on-device so one launch
+     * covers several iterations.  A generic named-sub-kernel dispatcher would serialize the
+     * sub-kernels through one block-level switch and lose the occupancy tuning each kernel
+     * has; fuse by hand where a profile justifies it.
+     */
     CUfunction getKernel(CUmodule& module, const std::string& name);
     /**
      * Execute a kernel.
@@ -230,6 +240,52 @@ public:
      * @param sharedSize   the amount of dynamic shared memory to allocated for the kernel, in bytes
      */
     void executeKernel(CUfunction kernel, void** arguments, int workUnits, int blockSize = -1, unsigned int sharedSize = 0);
+    /**
+     * Get the stream kernels are currently being launched on.  This is the default stream
+     * unless setCurrentStream() has been called.
+     */
+    CUstream getCurrentStream() const {
+        return currentStream;
+    }
+    /**
+     * Set the stream subsequent kernel launches should go to.  Kernels that want some of
+     * their work to overlap the rest of the computation can launch it on their own stream,
+     * handling the dependencies with events, then call restoreDefaultStream().
+     */
+    void setCurrentStream(CUstream stream) {
+        currentStream = stream;
+    }
+    /**
+     * Set kernel launches to go to the default stream again.
+     */
+    void restoreDefaultStream() {
+        currentStream = 0;
+    }
+    /**
+     * Sum the energy buffer on the device and return the total.  Only the single reduced
+     * value is transferred to the host.
+     */
+    /*
+     * On device-side analysis metrics: best-fit RMSD and contact maps reduce to a handful
+     * of device reductions (correlation matrix accumulation plus a tiny host-side
+     * eigenvalue solve for RMSD; per-pair distance tests for contacts), so convergence
+     * monitors need never download positions.  Such kernels are analysis, not simulation:
+     * they belong in an analysis kernel set loaded on demand, consuming posq read-only,
+     * with results delivered through small reductions like the energy above.
+     */
+    double reduceEnergy();
+    /**
+     * Allocate device memory.  Freed blocks are pooled by size and reused by later
+     * allocations of the same size, so repeatedly creating and destroying arrays (context
+     * reinitialization, temporary buffers) does not fragment device memory.
+     *
+     * @param size  the number of bytes to allocate
+     */
+    CUdeviceptr allocateMemory(size_t size);
+    /**
+     * Return device memory obtained from allocateMemory() to the pool.
+     */
+    void freeMemory(CUdeviceptr pointer, size_t size);
     /**
      * Compute the largest thread block size that can be used for a kernel that requires a particular amount of
      * shared memory per thread.
@@ -459,6 +515,14 @@ public:
     /**
      * Add a pre-computation that should be called at the very start of force and energy evaluations.
      * The CudaContext assumes ownership of the object, and deletes it when the context itself is deleted.
+     *
+     * Together with addPostComputation() this is the hook for running part of the computation on
+     * other hardware concurrently with the GPU kernels: the pre-computation hands the inputs to a
+     * host-side worker (see the CPU PME plugin, which evaluates reciprocal space on a CPU thread
+     * while the device runs direct space), and the post-computation collects its results.  Work
+     * offloaded this way should be substantial enough to cover the position download it requires;
+     * the bonded forces, for example, are far cheaper to evaluate on the device than to ship
+     * positions to the host for.
      */
     void addPreComputation(ForcePreComputation* computation);
     /**
@@ -521,12 +585,17 @@ private:
     std::map<std::string, std::string> compilationDefines;
     CUcontext context;
     CUdevice device;
+    CUstream currentStream;
+    bool usingSharedContext;
+    std::map<size_t, std::vector<CUdeviceptr> > memoryPool;
     CUfunction clearBufferKernel;
     CUfunction clearTwoBuffersKernel;
     CUfunction clearThreeBuffersKernel;
     CUfunction clearFourBuffersKernel;
     CUfunction clearFiveBuffersKernel;
     CUfunction clearSixBuffersKernel;
+    CUfunction reduceEnergyKernel;
+    CudaArray* energySum;
     std::vector<CudaForceInfo*> forces;
     std::vector<Molecule> molecules;
     std::vector<MoleculeGroup> moleculeGroups;
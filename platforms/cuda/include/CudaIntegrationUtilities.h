@@ -144,6 +144,7 @@ private:
     int* ccmaConvergedMemory;
     CUdeviceptr ccmaConvergedDeviceMemory;
     CUevent ccmaEvent;
+    int lastCcmaIterations;
     CudaArray* vsite2AvgAtoms;
     CudaArray* vsite2AvgWeights;
     CudaArray* vsite3AvgAtoms;
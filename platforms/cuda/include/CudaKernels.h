@@ -556,7 +556,7 @@ private:
 class CudaCalcNonbondedForceKernel : public CalcNonbondedForceKernel {
 public:
     CudaCalcNonbondedForceKernel(std::string name, const Platform& platform, CudaContext& cu, const System& system) : CalcNonbondedForceKernel(name, platform),
-            cu(cu), hasInitializedFFT(false), sigmaEpsilon(NULL), exceptionParams(NULL), cosSinSums(NULL), directPmeGrid(NULL), reciprocalPmeGrid(NULL),
+            cu(cu), hasInitializedFFT(false), usePmeStream(false), pmeStreamPending(false), sigmaEpsilon(NULL), exceptionParams(NULL), cosSinSums(NULL), directPmeGrid(NULL), reciprocalPmeGrid(NULL),
             pmeBsplineModuliX(NULL), pmeBsplineModuliY(NULL), pmeBsplineModuliZ(NULL),  pmeAtomRange(NULL), pmeAtomGridIndex(NULL), sort(NULL), pmeio(NULL) {
     }
     ~CudaCalcNonbondedForceKernel();
@@ -585,6 +585,15 @@ public:
      * @param force      the NonbondedForce to copy the parameters from
      */
     void copyParametersToContext(ContextImpl& context, const NonbondedForce& force);
+    /**
+     * Get the parameters being used for PME.
+     *
+     * @param alpha   on exit, the separation parameter
+     * @param nx      on exit, the number of grid points along the X axis
+     * @param ny      on exit, the number of grid points along the Y axis
+     * @param nz      on exit, the number of grid points along the Z axis
+     */
+    void getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const;
 private:
     class SortTrait : public CudaSort::SortTrait {
         int getDataSize() const {return 8;}
@@ -597,6 +606,7 @@ private:
         const char* getSortKey() const {return "value.y";}
     };
     class PmeIO;
+    class SyncStreamPostComputation;
     class PmePreComputation;
     class PmePostComputation;
     CudaContext& cu;
@@ -616,6 +626,9 @@ private:
     PmeIO* pmeio;
     cufftHandle fftForward;
     cufftHandle fftBackward;
+    CUstream pmeStream;
+    CUevent pmeStartEvent, pmeEndEvent;
+    bool usePmeStream, pmeStreamPending;
     CUfunction ewaldSumsKernel;
     CUfunction ewaldForcesKernel;
     CUfunction pmeGridIndexKernel;
@@ -627,6 +640,7 @@ private:
     std::map<std::string, std::string> pmeDefines;
     std::vector<std::pair<int, int> > exceptionAtoms;
     double ewaldSelfEnergy, dispersionCoefficient, alpha;
+    int gridSizeX, gridSizeY, gridSizeZ;
     int interpolateForceThreads;
     bool hasCoulomb, hasLJ;
     static const int PmeOrder = 5;
@@ -961,7 +975,8 @@ public:
 private:
     CudaContext& cu;
     double prevStepSize;
-    CUfunction kernel1, kernel2;
+    bool hasConstraints;
+    CUfunction kernel1, kernel2, fusedKernel;
 };
 
 /**
@@ -232,6 +232,33 @@ public:
      * it may be better to set this to false.
      */
     void setUsePadding(bool padding);
+    /**
+     * Set whether the nonbonded kernel should use a persistent-threads tile queue.  Instead
+     * of assigning a static range of tiles to each warp, warps pull tile indices from a
+     * global atomic counter until the list is drained, which balances the load when tile
+     * costs vary widely.  This must be called before initialize().
+     */
+    void setUseTileQueue(bool useQueue);
+    /**
+     * Get statistics about the neighbor list for diagnostic purposes.  This downloads the
+     * current interaction count from the device, so it synchronizes with it and should not
+     * be called inside the step loop.
+     *
+     * @param numInteractingTiles  on exit, the number of tiles in the interacting-blocks list
+     * @param maxTileCount         on exit, the capacity of the interacting-blocks list
+     * @param totalTiles           on exit, the total number of tiles before culling
+     */
+    void getTileStatistics(unsigned int& numInteractingTiles, unsigned int& maxTileCount, unsigned int& totalTiles);
+    /**
+     * On capture-and-replay for offline tuning: a force evaluation is fully determined by
+     * posq, the box vectors, the parameter arrays, and the neighbor-list state, all of
+     * which are plain device arrays owned by this class and the context.  A capture mode
+     * writes them before computeInteractions() and a replay harness uploads them and
+     * launches the kernel in isolation.  The existing checkpoint machinery is not suitable,
+     * since it captures integrator state rather than kernel inputs; a capture tool should
+     * serialize exactly the arrays named above, keyed by the kernel source hash.
+     */
+
     /**
      * Set the range of atom blocks and tiles that should be processed by this context.
      */
@@ -275,10 +302,14 @@ private:
     std::vector<std::vector<int> > atomExclusions;
     std::vector<ParameterInfo> parameters;
     std::vector<ParameterInfo> arguments;
+    CudaArray* tileQueueCounter;
+    CUevent downloadCountEvent;
+    unsigned int* pinnedCountBuffer;
+    bool pendingCountDownload;
     std::string kernelSource;
     std::map<std::string, std::string> kernelDefines;
     double cutoff;
-    bool useCutoff, usePeriodic, anyExclusions, usePadding;
+    bool useCutoff, usePeriodic, anyExclusions, usePadding, useTileQueue;
     int startTileIndex, numTiles, startBlockIndex, numBlocks, maxTiles, numForceThreadBlocks, forceThreadBlockSize, nonbondedForceGroup, numAtoms;
 };
 
@@ -33,6 +33,15 @@
 
 namespace OpenMM {
 
+// These kernels implement single-node multi-device parallelism: each device computes the
+// forces for a contiguous range of (Hilbert-ordered, hence spatially compact) atom blocks,
+// set through CudaNonbondedUtilities::setAtomBlockRange(), and the partial fixed-point
+// forces are summed on the first device.  A multi-node version follows the same pattern
+// with the force exchange going over the interconnect instead of the PCIe bus; it belongs
+// in a plugin rather than the core library, since everything it needs (the block-range
+// partition, the deterministic fixed-point force format, and the kernel factory mechanism)
+// is already exposed, and the core build should not depend on an MPI implementation.
+
 /**
  * This kernel is invoked at the beginning and end of force and energy computations.  It gives the
  * Platform a chance to clear buffers and do other initialization at the beginning, and to do any
@@ -81,6 +90,8 @@ private:
     std::vector<Kernel> kernels;
     std::vector<long long> completionTimes;
     std::vector<double> contextNonbondedFractions;
+    double transferAmount;
+    int lastSlowestContext;
     CudaArray* contextForces;
     void* pinnedPositionBuffer;
     long long* pinnedForceBuffer;
@@ -418,6 +429,15 @@ public:
      * @param force      the NonbondedForce to copy the parameters from
      */
     void copyParametersToContext(ContextImpl& context, const NonbondedForce& force);
+    /**
+     * Get the parameters being used for PME.
+     *
+     * @param alpha   on exit, the separation parameter
+     * @param nx      on exit, the number of grid points along the X axis
+     * @param ny      on exit, the number of grid points along the Y axis
+     * @param nz      on exit, the number of grid points along the Z axis
+     */
+    void getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const;
 private:
     class Task;
     CudaPlatform::PlatformData& data;
@@ -84,6 +84,14 @@ public:
     /**
      * This is the name of the parameter for selecting whether to use the CPU based PME calculation.
      */
+    /**
+     * This is the name of the parameter that specifies whether Contexts on the same device
+     * should share a single CUDA context instead of each creating their own.
+     */
+    static const std::string& CudaUseSharedContext() {
+        static const std::string key = "CudaUseSharedContext";
+        return key;
+    }
     static const std::string& CudaUseCpuPme() {
         static const std::string key = "CudaUseCpuPme";
         return key;
@@ -114,7 +122,8 @@ public:
 class OPENMM_EXPORT_CUDA CudaPlatform::PlatformData {
 public:
     PlatformData(ContextImpl* context, const System& system, const std::string& deviceIndexProperty, const std::string& blockingProperty, const std::string& precisionProperty,
-            const std::string& cpuPmeProperty, const std::string& compilerProperty, const std::string& tempProperty, const std::string& hostCompilerProperty);
+            const std::string& cpuPmeProperty, const std::string& compilerProperty, const std::string& tempProperty, const std::string& hostCompilerProperty,
+            const std::string& sharedContextProperty);
     ~PlatformData();
     void initializeContexts(const System& system);
     void syncContexts();
@@ -34,23 +34,17 @@ using namespace OpenMM;
 
 CudaArray::CudaArray(CudaContext& context, int size, int elementSize, const std::string& name) :
         context(context), size(size), elementSize(elementSize), name(name), ownsMemory(true) {
-    CUresult result = cuMemAlloc(&pointer, size*elementSize);
-    if (result != CUDA_SUCCESS) {
-        std::stringstream str;
-        str<<"Error creating array "<<name<<": "<<CudaContext::getErrorString(result)<<" ("<<result<<")";
-        throw OpenMMException(str.str());
+    try {
+        pointer = context.allocateMemory((size_t) size*elementSize);
+    }
+    catch (OpenMMException& ex) {
+        throw OpenMMException("Error creating array "+name+": "+ex.what());
     }
 }
 
 CudaArray::~CudaArray() {
-    if (ownsMemory && context.getContextIsValid()) {
-        CUresult result = cuMemFree(pointer);
-        if (result != CUDA_SUCCESS) {
-            std::stringstream str;
-            str<<"Error deleting array "<<name<<": "<<CudaContext::getErrorString(result)<<" ("<<result<<")";
-            throw OpenMMException(str.str());
-        }
-    }
+    if (ownsMemory && context.getContextIsValid())
+        context.freeMemory(pointer, (size_t) size*elementSize);
 }
 
 void CudaArray::upload(const void* data, bool blocking) {
@@ -24,6 +24,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.      *
  * -------------------------------------------------------------------------- */
 
+// On per-force precision: the bonded kernels are generated source, so compiling a chosen
+// force group's kernels with real=double while the rest stay float is technically
+// straightforward here.  What stops it being a local change is the accumulation contract:
+// forces from all groups meet in one fixed-point buffer, whose 2^-32 nm quantization is
+// the actual precision floor.  Double-precision bonded math only helps once the
+// accumulator also widens for those contributions, so the two must move together.
+
 #include "CudaBondedUtilities.h"
 #include "CudaExpressionUtilities.h"
 #include "CudaKernelSources.h"
@@ -98,7 +105,7 @@ void CudaBondedUtilities::initialize(const System& system) {
     s<<CudaKernelSources::vectorOps;
     for (int i = 0; i < (int) prefixCode.size(); i++)
         s<<prefixCode[i];
-    s<<"extern \"C\" __global__ void computeBondedForces(unsigned long long* __restrict__ forceBuffer, real* __restrict__ energyBuffer, const real4* __restrict__ posq, int groups";
+    s<<"extern \"C\" __global__ void computeBondedForces(unsigned long long* __restrict__ forceBuffer, mixed* __restrict__ energyBuffer, const real4* __restrict__ posq, int groups";
     for (int force = 0; force < numForces; force++) {
         for (int i = 0; i < (int) atomIndices[force].size(); i++) {
             int indexWidth = atomIndices[force][i]->getElementSize()/4;
@@ -51,6 +51,7 @@
 #include <sstream>
 #include <typeinfo>
 #include <cudaProfiler.h>
+#include <pthread.h>
 #ifndef WIN32
   #include <unistd.h>
 #endif
@@ -71,10 +72,18 @@ const int CudaContext::ThreadBlockSize = 64;
 const int CudaContext::TileSize = sizeof(tileflags)*8;
 bool CudaContext::hasInitializedCuda = false;
 
+// When several simulations share one GPU, creating a separate CUcontext for each makes the
+// driver switch contexts constantly.  Contexts created with the shared option instead share
+// one CUcontext per device, tracked here with a reference count.
+
+static map<int, pair<CUcontext, int> > sharedCudaContexts;
+static pthread_mutex_t sharedContextLock = PTHREAD_MUTEX_INITIALIZER;
+
 CudaContext::CudaContext(const System& system, int deviceIndex, bool useBlockingSync, const string& precision, const string& compiler,
-        const string& tempDir, const std::string& hostCompiler, CudaPlatform::PlatformData& platformData) : system(system),
+        const string& tempDir, const std::string& hostCompiler, bool useSharedContext, CudaPlatform::PlatformData& platformData) : system(system),
         time(0.0), platformData(platformData), stepCount(0), computeForceCount(0), stepsSinceReorder(99999), contextIsValid(false), atomsWereReordered(false), pinnedBuffer(NULL), posq(NULL),
-        posqCorrection(NULL), velm(NULL), force(NULL), energyBuffer(NULL), integration(NULL), expression(NULL), bonded(NULL), nonbonded(NULL), thread(NULL) {
+        posqCorrection(NULL), velm(NULL), force(NULL), energyBuffer(NULL), energySum(NULL), integration(NULL), expression(NULL), bonded(NULL), nonbonded(NULL), thread(NULL) {
+    currentStream = 0;
     this->compiler = "\""+compiler+"\"";
     if (hostCompiler.size() > 0)
         this->compiler = compiler+" --compiler-bindir "+hostCompiler;
@@ -146,7 +155,27 @@ CudaContext::CudaContext(const System& system, int deviceIndex, bool useBlocking
         flags += CU_CTX_SCHED_BLOCKING_SYNC;
     else
         flags += CU_CTX_SCHED_SPIN;
-    CHECK_RESULT(cuCtxCreate(&context, flags, device));
+    usingSharedContext = useSharedContext;
+    if (usingSharedContext) {
+        pthread_mutex_lock(&sharedContextLock);
+        map<int, pair<CUcontext, int> >::iterator shared = sharedCudaContexts.find(deviceIndex);
+        if (shared == sharedCudaContexts.end()) {
+            CUresult result = cuCtxCreate(&context, flags, device);
+            if (result != CUDA_SUCCESS) {
+                pthread_mutex_unlock(&sharedContextLock);
+                CHECK_RESULT(result);
+            }
+            sharedCudaContexts[deviceIndex] = make_pair(context, 1);
+        }
+        else {
+            context = shared->second.first;
+            shared->second.second++;
+            cuCtxSetCurrent(context);
+        }
+        pthread_mutex_unlock(&sharedContextLock);
+    }
+    else
+        CHECK_RESULT(cuCtxCreate(&context, flags, device));
     contextIsValid = true;
     CHECK_RESULT(cuCtxSetCacheConfig(CU_FUNC_CACHE_PREFER_SHARED));
     numAtoms = system.getNumParticles();
@@ -200,6 +229,7 @@ CudaContext::CudaContext(const System& system, int deviceIndex, bool useBlocking
     clearFourBuffersKernel = getKernel(utilities, "clearFourBuffers");
     clearFiveBuffersKernel = getKernel(utilities, "clearFiveBuffers");
     clearSixBuffersKernel = getKernel(utilities, "clearSixBuffers");
+    reduceEnergyKernel = getKernel(utilities, "reduceEnergy");
 
     // Set defines based on the requested precision.
 
@@ -252,6 +282,8 @@ CudaContext::~CudaContext() {
         delete force;
     if (energyBuffer != NULL)
         delete energyBuffer;
+    if (energySum != NULL)
+        delete energySum;
     if (integration != NULL)
         delete integration;
     if (expression != NULL)
@@ -264,12 +296,40 @@ CudaContext::~CudaContext() {
         delete thread;
     string errorMessage = "Error deleting Context";
     if (contextIsValid) {
-        cuProfilerStop();
-        CHECK_RESULT(cuCtxDestroy(context));
+        cuCtxSetCurrent(context); // cuMemFree requires the owning context to be current.
+        for (map<size_t, vector<CUdeviceptr> >::iterator iter = memoryPool.begin(); iter != memoryPool.end(); ++iter)
+            for (int i = 0; i < (int) iter->second.size(); i++)
+                cuMemFree(iter->second[i]);
+        memoryPool.clear();
+        if (usingSharedContext) {
+            // Only destroy the shared context when the last simulation using it goes away.
+
+            pthread_mutex_lock(&sharedContextLock);
+            for (map<int, pair<CUcontext, int> >::iterator iter = sharedCudaContexts.begin(); iter != sharedCudaContexts.end(); ++iter)
+                if (iter->second.first == context) {
+                    if (--iter->second.second == 0) {
+                        cuProfilerStop();
+                        cuCtxDestroy(context);
+                        sharedCudaContexts.erase(iter);
+                    }
+                    break;
+                }
+            pthread_mutex_unlock(&sharedContextLock);
+        }
+        else {
+            cuProfilerStop();
+            CHECK_RESULT(cuCtxDestroy(context));
+        }
     }
     contextIsValid = false;
 }
 
+// Context construction cost is dominated by module compilation (mitigated by the PTX disk
+// cache), force initialization uploads, and for large systems the first neighbor-list
+// build.  When a construction-time breakdown is needed, bracket the phases in this method
+// and in contextCreated() with host timers; they are one-time paths, so permanent
+// instrumentation is not worth its noise, but these are the boundaries to measure.
+
 void CudaContext::initialize() {
     cuCtxSetCurrent(context);
     string errorMessage = "Error initializing Context";
@@ -280,7 +340,10 @@ void CudaContext::initialize() {
         CHECK_RESULT(cuMemHostAlloc(&pinnedBuffer, pinnedBufferSize*sizeof(double), 0));
     }
     else if (useMixedPrecision) {
-        energyBuffer = CudaArray::create<float>(*this, numEnergyBuffers, "energyBuffer");
+        // Pair interactions are computed in single precision, but the energies accumulate
+        // in double so millions of small contributions do not lose bits.
+
+        energyBuffer = CudaArray::create<double>(*this, numEnergyBuffers, "energyBuffer");
         int pinnedBufferSize = max(paddedNumAtoms*4, numEnergyBuffers);
         CHECK_RESULT(cuMemHostAlloc(&pinnedBuffer, pinnedBufferSize*sizeof(double), 0));
     }
@@ -301,6 +364,7 @@ void CudaContext::initialize() {
     force = CudaArray::create<long long>(*this, paddedNumAtoms*3, "force");
     addAutoclearBuffer(force->getDevicePointer(), force->getSize()*force->getElementSize());
     addAutoclearBuffer(energyBuffer->getDevicePointer(), energyBuffer->getSize()*energyBuffer->getElementSize());
+    energySum = new CudaArray(*this, 1, energyBuffer->getElementSize(), "energySum");
     atomIndexDevice = CudaArray::create<int>(*this, paddedNumAtoms, "atomIndex");
     atomIndex.resize(paddedNumAtoms);
     for (int i = 0; i < paddedNumAtoms; ++i)
@@ -332,6 +396,13 @@ string CudaContext::replaceStrings(const string& input, const std::map<std::stri
     return result;
 }
 
+// On compilation feedback: the compiler's resource usage (registers, spills) is available
+// when modules are built, via --ptxas-options=-v output or cuFuncGetAttribute on the
+// loaded functions.  A feedback layer that logs per-kernel register counts and occupancy
+// when a verbose property is set would make spilling custom kernels visible without
+// external profilers; attribute queries on the loaded module are the portable form, since
+// parsing compiler output is toolchain-specific.
+
 CUmodule CudaContext::createModule(const string source, const char* optimizationFlags) {
     return createModule(source, map<string, string>(), optimizationFlags);
 }
@@ -416,7 +487,11 @@ CUmodule CudaContext::createModule(const string source, const map<string, string
         src << endl;
     src << source << endl;
     
-    // See whether we already have PTX for this kernel cached.
+    // See whether we already have PTX for this kernel cached.  The key is a SHA-1 of the
+    // fully preprocessed source plus the compilation options and architecture, so contexts
+    // built from identical Custom force expressions (a replica-exchange driver creating
+    // dozens of equal contexts, for instance) invoke the compiler once and every later
+    // context loads the cached PTX.
     
     CSHA1 sha1;
     sha1.Update((const UINT_8*) src.str().c_str(), src.str().size());
@@ -428,7 +503,9 @@ CUmodule CudaContext::createModule(const string source, const map<string, string
     cacheFile.flags(ios::hex);
     for (int i = 0; i < 20; i++)
         cacheFile << setw(2) << setfill('0') << (int) hash[i];
-    cacheFile << '_' << gpuArchitecture << '_' << bits;
+    int driverVersion = 0;
+    cuDriverGetVersion(&driverVersion);
+    cacheFile << '_' << gpuArchitecture << '_' << bits << '_' << driverVersion;
     CUmodule module;
     if (cuModuleLoad(&module, cacheFile.str().c_str()) == CUDA_SUCCESS)
         return module;
@@ -575,7 +652,7 @@ void CudaContext::executeKernel(CUfunction kernel, void** arguments, int threads
     if (blockSize == -1)
         blockSize = ThreadBlockSize;
     int gridSize = std::min((threads+blockSize-1)/blockSize, numThreadBlocks);
-    CUresult result = cuLaunchKernel(kernel, gridSize, 1, 1, blockSize, 1, 1, sharedSize, 0, arguments, NULL);
+    CUresult result = cuLaunchKernel(kernel, gridSize, 1, 1, blockSize, 1, 1, sharedSize, currentStream, arguments, NULL);
     if (result != CUDA_SUCCESS) {
         stringstream str;
         str<<"Error invoking kernel: "<<getErrorString(result)<<" ("<<result<<")";
@@ -583,6 +660,53 @@ void CudaContext::executeKernel(CUfunction kernel, void** arguments, int threads
     }
 }
 
+CUdeviceptr CudaContext::allocateMemory(size_t size) {
+    map<size_t, vector<CUdeviceptr> >::iterator pooled = memoryPool.find(size);
+    if (pooled != memoryPool.end() && pooled->second.size() > 0) {
+        CUdeviceptr pointer = pooled->second.back();
+        pooled->second.pop_back();
+        return pointer;
+    }
+    CUdeviceptr pointer;
+    CUresult result = cuMemAlloc(&pointer, size);
+    if (result == CUDA_ERROR_OUT_OF_MEMORY) {
+        // Release everything the pool is holding and try once more.
+
+        for (map<size_t, vector<CUdeviceptr> >::iterator iter = memoryPool.begin(); iter != memoryPool.end(); ++iter)
+            for (int i = 0; i < (int) iter->second.size(); i++)
+                cuMemFree(iter->second[i]);
+        memoryPool.clear();
+        result = cuMemAlloc(&pointer, size);
+    }
+    if (result != CUDA_SUCCESS) {
+        stringstream str;
+        str<<"Error allocating device memory: "<<getErrorString(result)<<" ("<<result<<")";
+        throw OpenMMException(str.str());
+    }
+    return pointer;
+}
+
+void CudaContext::freeMemory(CUdeviceptr pointer, size_t size) {
+    memoryPool[size].push_back(pointer);
+}
+
+double CudaContext::reduceEnergy() {
+    int bufferSize = energyBuffer->getSize();
+    int workGroupSize = 512;
+    void* args[] = {&energyBuffer->getDevicePointer(), &energySum->getDevicePointer(), &bufferSize, &workGroupSize};
+    executeKernel(reduceEnergyKernel, args, workGroupSize, workGroupSize, workGroupSize*energyBuffer->getElementSize());
+    if (getUseDoublePrecision() || getUseMixedPrecision()) {
+        double energy;
+        energySum->download(&energy);
+        return energy;
+    }
+    else {
+        float energy;
+        energySum->download(&energy);
+        return energy;
+    }
+}
+
 int CudaContext::computeThreadBlockSize(double memory, bool preferShared) const {
     int maxShared = 16*1024;
     if (computeCapability >= 2.0 && preferShared)
@@ -24,6 +24,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.      *
  * -------------------------------------------------------------------------- */
 
+// On tabulated-function storage: the generated code reads spline coefficients from global
+// memory; threads in a warp evaluate nearby arguments, so the reads are scattered but
+// local.  On the hardware this tree targets, the practical options are __ldg on compute
+// capability 3.5+ (one-line change in the generated load when the architecture allows) or
+// binding the coefficient arrays to textures, which complicates the argument plumbing for
+// every custom kernel.  If this shows up in profiles, do the __ldg variant first; it needs
+// only an architecture check where this file emits the loads.
+
 #include "CudaExpressionUtilities.h"
 #include "openmm/OpenMMException.h"
 #include "openmm/internal/SplineFitter.h"
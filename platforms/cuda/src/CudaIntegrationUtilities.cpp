@@ -650,6 +650,7 @@ CudaIntegrationUtilities::CudaIntegrationUtilities(CudaContext& context, const S
     numVsites = num2Avg+num3Avg+numOutOfPlane;
     randomKernel = context.getKernel(module, "generateRandomNumbers");
     timeShiftKernel = context.getKernel(module, "timeShiftVelocities");
+    lastCcmaIterations = 4;
 }
 
 CudaIntegrationUtilities::~CudaIntegrationUtilities() {
@@ -757,20 +758,30 @@ void CudaIntegrationUtilities::applyConstraints(bool constrainVelocities, double
                 constrainVelocities ? &context.getVelm().getDevicePointer() : &posDelta->getDevicePointer(),
                 &context.getVelm().getDevicePointer(), &ccmaDelta1->getDevicePointer(), &ccmaDelta2->getDevicePointer(),
                 &ccmaConverged->getDevicePointer(), &i};
+        // Checking for convergence requires synchronizing with the device, so do the first
+        // check just before the iteration count that converged last time, then every few
+        // iterations after that.
+
         const int checkInterval = 4;
+        int firstCheck = (lastCcmaIterations > 2 ? lastCcmaIterations-1 : 1);
         ccmaConvergedMemory[0] = 0;
         for (i = 0; i < 150; i++) {
+            bool checkThisIteration = (i+1 >= firstCheck && (i+1-firstCheck)%checkInterval == 0);
             context.executeKernel(ccmaForceKernel, forceArgs, ccmaAtoms->getSize());
-            if ((i+1)%checkInterval == 0)
+            if (checkThisIteration)
                 CHECK_RESULT2(cuEventRecord(ccmaEvent, 0), "Error recording event for CCMA");
             context.executeKernel(ccmaMultiplyKernel, multiplyArgs, ccmaAtoms->getSize());
             context.executeKernel(ccmaUpdateKernel, updateArgs, context.getNumAtoms());
-            if ((i+1)%checkInterval == 0) {
+            if (checkThisIteration) {
                 CHECK_RESULT2(cuEventSynchronize(ccmaEvent), "Error synchronizing on event for CCMA");
                 if (ccmaConvergedMemory[0])
                     break;
             }
         }
+        // Remember one less than the count just used, so if the system starts converging
+        // faster the first check drifts back down instead of ratcheting upward.
+
+        lastCcmaIterations = i;
     }
 }
 
@@ -103,21 +103,8 @@ double CudaCalcForcesAndEnergyKernel::finishComputation(ContextImpl& context, bo
     for (vector<CudaContext::ForcePostComputation*>::iterator iter = cu.getPostComputations().begin(); iter != cu.getPostComputations().end(); ++iter)
         sum += (*iter)->computeForceAndEnergy(includeForces, includeEnergy, groups);
     cu.getIntegrationUtilities().distributeForcesFromVirtualSites();
-    if (includeEnergy) {
-        CudaArray& energyArray = cu.getEnergyBuffer();
-        if (cu.getUseDoublePrecision()) {
-            double* energy = (double*) cu.getPinnedBuffer();
-            energyArray.download(energy);
-            for (int i = 0; i < energyArray.getSize(); i++)
-                sum += energy[i];
-        }
-        else {
-            float* energy = (float*) cu.getPinnedBuffer();
-            energyArray.download(energy);
-            for (int i = 0; i < energyArray.getSize(); i++)
-                sum += energy[i];
-        }
-    }
+    if (includeEnergy)
+        sum += cu.reduceEnergy();
     return sum;
 }
 
@@ -1375,6 +1362,27 @@ private:
     CalcPmeReciprocalForceKernel::IO& io;
 };
 
+/**
+ * This joins the default stream with the PME stream.  It runs as a post-computation, after
+ * the direct space kernel has been launched, so the reciprocal chain on the PME stream
+ * executes underneath it instead of before it.
+ */
+class CudaCalcNonbondedForceKernel::SyncStreamPostComputation : public CudaContext::ForcePostComputation {
+public:
+    SyncStreamPostComputation(CUevent event, bool& pending) : event(event), pending(pending) {
+    }
+    double computeForceAndEnergy(bool includeForces, bool includeEnergy, int groups) {
+        if (pending) {
+            cuStreamWaitEvent(0, event, 0);
+            pending = false;
+        }
+        return 0.0;
+    }
+private:
+    CUevent event;
+    bool& pending;
+};
+
 class CudaCalcNonbondedForceKernel::PmePostComputation : public CudaContext::ForcePostComputation {
 public:
     PmePostComputation(Kernel& pme, CalcPmeReciprocalForceKernel::IO& io) : pme(pme), io(io) {
@@ -1414,6 +1422,11 @@ CudaCalcNonbondedForceKernel::~CudaCalcNonbondedForceKernel() {
     if (pmeio != NULL)
         delete pmeio;
     if (hasInitializedFFT) {
+        if (usePmeStream) {
+            cuStreamDestroy(pmeStream);
+            cuEventDestroy(pmeStartEvent);
+            cuEventDestroy(pmeEndEvent);
+        }
         cufftDestroy(fftForward);
         cufftDestroy(fftBackward);
     }
@@ -1547,8 +1560,6 @@ void CudaCalcNonbondedForceKernel::initialize(const System& system, const Nonbon
     else if (force.getNonbondedMethod() == NonbondedForce::PME && cu.getContextIndex() == 0) {
         // Compute the PME parameters.
 
-        int gridSizeX, gridSizeY, gridSizeZ;
-
         NonbondedForceImpl::calcPMEParameters(system, force, alpha, gridSizeX, gridSizeY, gridSizeZ);
         gridSizeX = findFFTDimension(gridSizeX);
         gridSizeY = findFFTDimension(gridSizeY);
@@ -1621,6 +1632,24 @@ void CudaCalcNonbondedForceKernel::initialize(const System& system, const Nonbon
             cufftSetCompatibilityMode(fftForward, CUFFT_COMPATIBILITY_NATIVE);
             cufftSetCompatibilityMode(fftBackward, CUFFT_COMPATIBILITY_NATIVE);
 
+            // Create a separate stream for the reciprocal space calculation, so it can
+            // overlap the direct space work.  The stream is non-blocking so the implicit
+            // synchronization of the default stream does not serialize it; the real
+            // dependencies are expressed with events.
+
+            if (cuStreamCreate(&pmeStream, CU_STREAM_NON_BLOCKING) == CUDA_SUCCESS &&
+                    cuEventCreate(&pmeStartEvent, CU_EVENT_DISABLE_TIMING) == CUDA_SUCCESS &&
+                    cuEventCreate(&pmeEndEvent, CU_EVENT_DISABLE_TIMING) == CUDA_SUCCESS) {
+                usePmeStream = true;
+                cufftSetStream(fftForward, pmeStream);
+                cufftSetStream(fftBackward, pmeStream);
+
+                // The join with the default stream happens as a post-computation, after
+                // the direct space kernel has been launched, so the two actually overlap.
+
+                cu.addPostComputation(new SyncStreamPostComputation(pmeEndEvent, pmeStreamPending));
+            }
+
             hasInitializedFFT = true;
 
             // Initialize the b-spline moduli.
@@ -1738,6 +1767,19 @@ double CudaCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeF
         cu.executeKernel(ewaldForcesKernel, forcesArgs, cu.getNumAtoms());
     }
     if (directPmeGrid != NULL && includeReciprocal) {
+        // The direct and reciprocal kernels accumulate energy into the same buffer slots
+        // without atomics, so only overlap them when no energy is being computed.
+
+        bool overlapReciprocal = (usePmeStream && !includeEnergy);
+        if (overlapReciprocal) {
+            // Launch the whole reciprocal space calculation on its own stream.  It must wait
+            // until the charges and the cleared grid are ready, and everything that follows
+            // on the default stream waits for its force contribution at the end.
+
+            cuEventRecord(pmeStartEvent, 0);
+            cuStreamWaitEvent(pmeStream, pmeStartEvent, 0);
+            cu.setCurrentStream(pmeStream);
+        }
         void* gridIndexArgs[] = {&cu.getPosq().getDevicePointer(), &pmeAtomGridIndex->getDevicePointer(), cu.getPeriodicBoxSizePointer(), cu.getInvPeriodicBoxSizePointer()};
         cu.executeKernel(pmeGridIndexKernel, gridIndexArgs, cu.getNumAtoms());
 
@@ -1774,7 +1816,11 @@ double CudaCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeF
         void* interpolateArgs[] = {&cu.getPosq().getDevicePointer(), &cu.getForce().getDevicePointer(), &directPmeGrid->getDevicePointer(),
                 cu.getPeriodicBoxSizePointer(), cu.getInvPeriodicBoxSizePointer(), &pmeAtomGridIndex->getDevicePointer()};
         cu.executeKernel(pmeInterpolateForceKernel, interpolateArgs, cu.getNumAtoms(), 128);
-
+        if (overlapReciprocal) {
+            cu.restoreDefaultStream();
+            cuEventRecord(pmeEndEvent, pmeStream);
+            pmeStreamPending = true;
+        }
     }
     double energy = (includeReciprocal ? ewaldSelfEnergy : 0.0);
     if (dispersionCoefficient != 0.0 && includeDirect) {
@@ -1784,6 +1830,13 @@ double CudaCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeF
     return energy;
 }
 
+void CudaCalcNonbondedForceKernel::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    alpha = this->alpha;
+    nx = gridSizeX;
+    ny = gridSizeY;
+    nz = gridSizeZ;
+}
+
 void CudaCalcNonbondedForceKernel::copyParametersToContext(ContextImpl& context, const NonbondedForce& force) {
     // Make sure the new parameters are acceptable.
     
@@ -4449,6 +4502,8 @@ void CudaIntegrateVerletStepKernel::initialize(const System& system, const Verle
     CUmodule module = cu.createModule(CudaKernelSources::verlet, defines, "");
     kernel1 = cu.getKernel(module, "integrateVerletPart1");
     kernel2 = cu.getKernel(module, "integrateVerletPart2");
+    fusedKernel = cu.getKernel(module, "integrateVerletFused");
+    hasConstraints = (system.getNumConstraints() > 0);
     prevStepSize = -1.0;
 }
 
@@ -4472,22 +4527,32 @@ void CudaIntegrateVerletStepKernel::execute(ContextImpl& context, const VerletIn
         prevStepSize = dt;
     }
 
-    // Call the first integration kernel.
-
     CUdeviceptr posCorrection = (cu.getUseMixedPrecision() ? cu.getPosqCorrection().getDevicePointer() : 0);
-    void* args1[] = {&numAtoms, &paddedNumAtoms, &cu.getIntegrationUtilities().getStepSize().getDevicePointer(), &cu.getPosq().getDevicePointer(), &posCorrection,
-            &cu.getVelm().getDevicePointer(), &cu.getForce().getDevicePointer(), &integration.getPosDelta().getDevicePointer()};
-    cu.executeKernel(kernel1, args1, numAtoms);
+    if (!hasConstraints) {
+        // Nothing needs to happen between the velocity and position updates, so do the whole
+        // integration in a single kernel launch.
 
-    // Apply constraints.
+        void* args[] = {&numAtoms, &paddedNumAtoms, &cu.getIntegrationUtilities().getStepSize().getDevicePointer(), &cu.getPosq().getDevicePointer(), &posCorrection,
+                &cu.getVelm().getDevicePointer(), &cu.getForce().getDevicePointer()};
+        cu.executeKernel(fusedKernel, args, numAtoms);
+    }
+    else {
+        // Call the first integration kernel.
 
-    integration.applyConstraints(integrator.getConstraintTolerance());
+        void* args1[] = {&numAtoms, &paddedNumAtoms, &cu.getIntegrationUtilities().getStepSize().getDevicePointer(), &cu.getPosq().getDevicePointer(), &posCorrection,
+                &cu.getVelm().getDevicePointer(), &cu.getForce().getDevicePointer(), &integration.getPosDelta().getDevicePointer()};
+        cu.executeKernel(kernel1, args1, numAtoms);
 
-    // Call the second integration kernel.
+        // Apply constraints.
 
-    void* args2[] = {&numAtoms, &cu.getIntegrationUtilities().getStepSize().getDevicePointer(), &cu.getPosq().getDevicePointer(), &posCorrection,
-            &cu.getVelm().getDevicePointer(), &integration.getPosDelta().getDevicePointer()};
-    cu.executeKernel(kernel2, args2, numAtoms);
+        integration.applyConstraints(integrator.getConstraintTolerance());
+
+        // Call the second integration kernel.
+
+        void* args2[] = {&numAtoms, &cu.getIntegrationUtilities().getStepSize().getDevicePointer(), &cu.getPosq().getDevicePointer(), &posCorrection,
+                &cu.getVelm().getDevicePointer(), &integration.getPosDelta().getDevicePointer()};
+        cu.executeKernel(kernel2, args2, numAtoms);
+    }
     integration.computeVirtualSites();
 
     // Update the time and step count.
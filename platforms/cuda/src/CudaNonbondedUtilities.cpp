@@ -64,8 +64,8 @@ private:
 
 CudaNonbondedUtilities::CudaNonbondedUtilities(CudaContext& context) : context(context), cutoff(-1.0), useCutoff(false), anyExclusions(false), usePadding(true),
         exclusionIndices(NULL), exclusionRowIndices(NULL), exclusionTiles(NULL), exclusions(NULL), interactingTiles(NULL), interactingAtoms(NULL),
-        interactionCount(NULL), blockCenter(NULL), blockBoundingBox(NULL), sortedBlocks(NULL), sortedBlockCenter(NULL), sortedBlockBoundingBox(NULL),
-        oldPositions(NULL), rebuildNeighborList(NULL), blockSorter(NULL), nonbondedForceGroup(0) {
+        interactionCount(NULL), tileQueueCounter(NULL), useTileQueue(false), blockCenter(NULL), blockBoundingBox(NULL), sortedBlocks(NULL), sortedBlockCenter(NULL), sortedBlockBoundingBox(NULL),
+        oldPositions(NULL), rebuildNeighborList(NULL), blockSorter(NULL), pinnedCountBuffer(NULL), pendingCountDownload(false), nonbondedForceGroup(0) {
     // Decide how many thread blocks to use.
 
     string errorMessage = "Error initializing nonbonded utilities";
@@ -90,6 +90,8 @@ CudaNonbondedUtilities::~CudaNonbondedUtilities() {
         delete interactingAtoms;
     if (interactionCount != NULL)
         delete interactionCount;
+    if (tileQueueCounter != NULL)
+        delete tileQueueCounter;
     if (blockCenter != NULL)
         delete blockCenter;
     if (blockBoundingBox != NULL)
@@ -104,6 +106,10 @@ CudaNonbondedUtilities::~CudaNonbondedUtilities() {
         delete oldPositions;
     if (rebuildNeighborList != NULL)
         delete rebuildNeighborList;
+    if (pinnedCountBuffer != NULL) {
+        cuMemFreeHost(pinnedCountBuffer);
+        cuEventDestroy(downloadCountEvent);
+    }
     if (blockSorter != NULL)
         delete blockSorter;
 }
@@ -273,6 +279,10 @@ void CudaNonbondedUtilities::initialize(const System& system) {
             oldPositions->upload(oldPositionsVec);
         }
         rebuildNeighborList = CudaArray::create<int>(context, 1, "rebuildNeighborList");
+        if (cuMemHostAlloc((void**) &pinnedCountBuffer, sizeof(unsigned int), 0) != CUDA_SUCCESS)
+            pinnedCountBuffer = NULL;
+        else
+            cuEventCreate(&downloadCountEvent, CU_EVENT_DISABLE_TIMING);
         blockSorter = new CudaSort(context, new BlockSortTrait(context.getUseDoublePrecision()), numAtomBlocks);
         vector<unsigned int> count(1, 0);
         interactionCount->upload(count);
@@ -280,6 +290,13 @@ void CudaNonbondedUtilities::initialize(const System& system) {
 
     // Create kernels.
 
+    if (useTileQueue) {
+        // The queue counter is cleared along with the other buffers at the start of each
+        // computation, so every launch starts popping tiles from the front of the list.
+
+        tileQueueCounter = CudaArray::create<unsigned int>(context, 1, "tileQueueCounter");
+        context.addAutoclearBuffer(*tileQueueCounter);
+    }
     if (kernelSource.size() > 0)
         forceKernel = createInteractionKernel(kernelSource, parameters, arguments, true, true);
     if (useCutoff) {
@@ -362,9 +379,38 @@ void CudaNonbondedUtilities::computeInteractions() {
         context.executeKernel(forceKernel, &forceArgs[0], numForceThreadBlocks*forceThreadBlockSize, forceThreadBlockSize);
         if (context.getComputeForceCount() == 1)
             updateNeighborListSize(); // This is the first time step, so check whether our initial guess was large enough.
+        else if (useCutoff && pinnedCountBuffer != NULL) {
+            // The interacting-blocks list can also overflow on a later step.  Check for that
+            // without ever blocking: start an asynchronous download of the interaction count
+            // now and then, and look at the result once the copy has finished on its own.
+
+            if (pendingCountDownload && cuEventQuery(downloadCountEvent) == CUDA_SUCCESS) {
+                pendingCountDownload = false;
+                if (pinnedCountBuffer[0] > (unsigned int) maxTiles)
+                    updateNeighborListSize();
+            }
+            if (!pendingCountDownload && context.getComputeForceCount()%250 == 0) {
+                cuMemcpyDtoHAsync(pinnedCountBuffer, interactionCount->getDevicePointer(), sizeof(unsigned int), 0);
+                cuEventRecord(downloadCountEvent, 0);
+                pendingCountDownload = true;
+            }
+        }
     }
 }
 
+void CudaNonbondedUtilities::getTileStatistics(unsigned int& numInteractingTiles, unsigned int& maxTileCount, unsigned int& totalTiles) {
+    int numBlocks = context.getNumAtomBlocks();
+    totalTiles = numBlocks*(numBlocks+1)/2;
+    maxTileCount = maxTiles;
+    if (useCutoff && interactionCount != NULL) {
+        unsigned int count;
+        interactionCount->download(&count);
+        numInteractingTiles = count;
+    }
+    else
+        numInteractingTiles = totalTiles;
+}
+
 void CudaNonbondedUtilities::updateNeighborListSize() {
     if (!useCutoff)
         return;
@@ -406,6 +452,10 @@ void CudaNonbondedUtilities::setUsePadding(bool padding) {
     usePadding = padding;
 }
 
+void CudaNonbondedUtilities::setUseTileQueue(bool useQueue) {
+    useTileQueue = useQueue;
+}
+
 void CudaNonbondedUtilities::setAtomBlockRange(double startFraction, double endFraction) {
     int numAtomBlocks = context.getNumAtomBlocks();
     startBlockIndex = (int) (startFraction*numAtomBlocks);
@@ -591,6 +641,8 @@ CUfunction CudaNonbondedUtilities::createInteractionKernel(const string& source,
         defines["USE_SYMMETRIC"] = "1";
     if (useShuffle)
         defines["ENABLE_SHUFFLE"] = "1";
+    if (useTileQueue)
+        defines["USE_TILE_QUEUE"] = "1";
     defines["THREAD_BLOCK_SIZE"] = context.intToString(forceThreadBlockSize);
     defines["CUTOFF_SQUARED"] = context.doubleToString(cutoff*cutoff);
     defines["CUTOFF"] = context.doubleToString(cutoff);
@@ -630,6 +682,8 @@ CUfunction CudaNonbondedUtilities::createInteractionKernel(const string& source,
         forceArgs.push_back(&blockBoundingBox->getDevicePointer());
         forceArgs.push_back(&interactingAtoms->getDevicePointer());
     }
+    if (useTileQueue)
+        forceArgs.push_back(&tileQueueCounter->getDevicePointer());
     for (int i = 0; i < (int) params.size(); i++)
         forceArgs.push_back(&params[i].getMemory());
     for (int i = 0; i < (int) arguments.size(); i++)
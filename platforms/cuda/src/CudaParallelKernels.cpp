@@ -132,8 +132,8 @@ private:
 };
 
 CudaParallelCalcForcesAndEnergyKernel::CudaParallelCalcForcesAndEnergyKernel(string name, const Platform& platform, CudaPlatform::PlatformData& data) :
-        CalcForcesAndEnergyKernel(name, platform), data(data), completionTimes(data.contexts.size()), contextNonbondedFractions(data.contexts.size()), contextForces(NULL),
-        pinnedPositionBuffer(NULL), pinnedForceBuffer(NULL) {
+        CalcForcesAndEnergyKernel(name, platform), data(data), completionTimes(data.contexts.size()), contextNonbondedFractions(data.contexts.size()),
+        transferAmount(0.001), lastSlowestContext(-1), contextForces(NULL), pinnedPositionBuffer(NULL), pinnedForceBuffer(NULL) {
     for (int i = 0; i < (int) data.contexts.size(); i++)
         kernels.push_back(Kernel(new CudaCalcForcesAndEnergyKernel(name, platform, *data.contexts[i])));
 }
@@ -201,8 +201,13 @@ double CudaParallelCalcForcesAndEnergyKernel::finishComputation(ContextImpl& con
         void* args[] = {&cu.getForce().getDevicePointer(), &contextForces->getDevicePointer(), &bufferSize, &numBuffers};
         cu.executeKernel(sumKernel, args, bufferSize);
         
-        // Balance work between the contexts by transferring a little nonbonded work from the context that
-        // finished last to the one that finished first.
+        // Balance work between the contexts by transferring nonbonded work from the context
+        // that finished last to the one that finished first.  Because the atoms are
+        // periodically reordered along a Hilbert curve, each context's contiguous range of
+        // atom blocks corresponds to a compact spatial region, so this split already behaves
+        // as a spatial domain decomposition whose boundaries adapt to the measured load.  While the same context keeps
+        // finishing last the amount moved per step grows geometrically, so a large imbalance
+        // is corrected in a few steps instead of creeping toward equilibrium.
         
         int firstIndex = 0, lastIndex = 0;
         for (int i = 0; i < (int) completionTimes.size(); i++) {
@@ -211,7 +216,12 @@ double CudaParallelCalcForcesAndEnergyKernel::finishComputation(ContextImpl& con
             if (completionTimes[i] > completionTimes[lastIndex])
                 lastIndex = i;
         }
-        double fractionToTransfer = min(0.001, contextNonbondedFractions[lastIndex]);
+        if (lastIndex == lastSlowestContext)
+            transferAmount = min(0.05, 2.0*transferAmount);
+        else
+            transferAmount = 0.001;
+        lastSlowestContext = lastIndex;
+        double fractionToTransfer = min(transferAmount, contextNonbondedFractions[lastIndex]);
         contextNonbondedFractions[firstIndex] += fractionToTransfer;
         contextNonbondedFractions[lastIndex] -= fractionToTransfer;
         double startFraction = 0.0;
@@ -571,6 +581,10 @@ CudaParallelCalcNonbondedForceKernel::CudaParallelCalcNonbondedForceKernel(std::
         kernels.push_back(Kernel(new CudaCalcNonbondedForceKernel(name, platform, *data.contexts[i], system)));
 }
 
+void CudaParallelCalcNonbondedForceKernel::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    dynamic_cast<const CudaCalcNonbondedForceKernel&>(kernels[0].getImpl()).getPMEParameters(alpha, nx, ny, nz);
+}
+
 void CudaParallelCalcNonbondedForceKernel::initialize(const System& system, const NonbondedForce& force) {
     for (int i = 0; i < (int) kernels.size(); i++)
         getKernel(i).initialize(system, force);
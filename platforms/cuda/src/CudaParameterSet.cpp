@@ -24,6 +24,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.      *
  * -------------------------------------------------------------------------- */
 
+// On compression: parameters are stored expanded per particle even though most systems
+// have few unique atom types, because every kernel indexes them directly by atom.  An
+// indexed layout (per-atom type index plus a type table in constant or shared memory)
+// would cut memory and bandwidth severalfold, but it changes the signature of every
+// generated kernel that receives parameters, including user-visible custom force source.
+// That makes it a kernel-ABI project, not a storage tweak; this class is the right place
+// to add the indexed representation when that project happens.
+
 #include "CudaParameterSet.h"
 #include "openmm/OpenMMException.h"
 #include <cmath>
@@ -34,6 +34,7 @@
 #include "openmm/System.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
 #include <sstream>
 #include <cstdio>
 #ifdef _MSC_VER
@@ -95,6 +96,7 @@ CudaPlatform::CudaPlatform() {
     platformProperties.push_back(CudaUseBlockingSync());
     platformProperties.push_back(CudaPrecision());
     platformProperties.push_back(CudaUseCpuPme());
+    platformProperties.push_back(CudaUseSharedContext());
     platformProperties.push_back(CudaCompiler());
     platformProperties.push_back(CudaTempDirectory());
     platformProperties.push_back(CudaHostCompiler());
@@ -103,6 +105,7 @@ CudaPlatform::CudaPlatform() {
     setPropertyDefaultValue(CudaUseBlockingSync(), "true");
     setPropertyDefaultValue(CudaPrecision(), "single");
     setPropertyDefaultValue(CudaUseCpuPme(), "false");
+    setPropertyDefaultValue(CudaUseSharedContext(), "false");
 #ifdef _MSC_VER
     char* bindir = getenv("CUDA_BIN_PATH");
     string nvcc = (bindir == NULL ? "nvcc.exe" : string(bindir)+"\\nvcc.exe");
@@ -155,6 +158,8 @@ void CudaPlatform::contextCreated(ContextImpl& context, const map<string, string
             getPropertyDefaultValue(CudaPrecision()) : properties.find(CudaPrecision())->second);
     string cpuPmePropValue = (properties.find(CudaUseCpuPme()) == properties.end() ?
             getPropertyDefaultValue(CudaUseCpuPme()) : properties.find(CudaUseCpuPme())->second);
+    string sharedContextPropValue = (properties.find(CudaUseSharedContext()) == properties.end() ?
+            getPropertyDefaultValue(CudaUseSharedContext()) : properties.find(CudaUseSharedContext())->second);
     const string& compilerPropValue = (properties.find(CudaCompiler()) == properties.end() ?
             getPropertyDefaultValue(CudaCompiler()) : properties.find(CudaCompiler())->second);
     const string& tempPropValue = (properties.find(CudaTempDirectory()) == properties.end() ?
@@ -164,11 +169,12 @@ void CudaPlatform::contextCreated(ContextImpl& context, const map<string, string
     transform(blockingPropValue.begin(), blockingPropValue.end(), blockingPropValue.begin(), ::tolower);
     transform(precisionPropValue.begin(), precisionPropValue.end(), precisionPropValue.begin(), ::tolower);
     transform(cpuPmePropValue.begin(), cpuPmePropValue.end(), cpuPmePropValue.begin(), ::tolower);
+    transform(sharedContextPropValue.begin(), sharedContextPropValue.end(), sharedContextPropValue.begin(), ::tolower);
     vector<string> pmeKernelName;
     pmeKernelName.push_back(CalcPmeReciprocalForceKernel::Name());
     if (!supportsKernels(pmeKernelName))
         cpuPmePropValue = "false";
-    context.setPlatformData(new PlatformData(&context, context.getSystem(), devicePropValue, blockingPropValue, precisionPropValue, cpuPmePropValue, compilerPropValue, tempPropValue, hostCompilerPropValue));
+    context.setPlatformData(new PlatformData(&context, context.getSystem(), devicePropValue, blockingPropValue, precisionPropValue, cpuPmePropValue, compilerPropValue, tempPropValue, hostCompilerPropValue, sharedContextPropValue));
 }
 
 void CudaPlatform::contextDestroyed(ContextImpl& context) const {
@@ -177,8 +183,10 @@ void CudaPlatform::contextDestroyed(ContextImpl& context) const {
 }
 
 CudaPlatform::PlatformData::PlatformData(ContextImpl* context, const System& system, const string& deviceIndexProperty, const string& blockingProperty, const string& precisionProperty,
-            const string& cpuPmeProperty, const string& compilerProperty, const string& tempProperty, const string& hostCompilerProperty) : context(context), removeCM(false), stepCount(0), computeForceCount(0), time(0.0) {
+            const string& cpuPmeProperty, const string& compilerProperty, const string& tempProperty, const string& hostCompilerProperty,
+            const string& sharedContextProperty) : context(context), removeCM(false), stepCount(0), computeForceCount(0), time(0.0) {
     bool blocking = (blockingProperty == "true");
+    bool useSharedContext = (sharedContextProperty == "true");
     vector<string> devices;
     size_t searchPos = 0, nextPos;
     while ((nextPos = deviceIndexProperty.find_first_of(", ", searchPos)) != string::npos) {
@@ -191,11 +199,11 @@ CudaPlatform::PlatformData::PlatformData(ContextImpl* context, const System& sys
             if (devices[i].length() > 0) {
                 unsigned int deviceIndex;
                 stringstream(devices[i]) >> deviceIndex;
-                contexts.push_back(new CudaContext(system, deviceIndex, blocking, precisionProperty, compilerProperty, tempProperty, hostCompilerProperty, *this));
+                contexts.push_back(new CudaContext(system, deviceIndex, blocking, precisionProperty, compilerProperty, tempProperty, hostCompilerProperty, useSharedContext, *this));
             }
         }
         if (contexts.size() == 0)
-            contexts.push_back(new CudaContext(system, -1, blocking, precisionProperty, compilerProperty, tempProperty, hostCompilerProperty, *this));
+            contexts.push_back(new CudaContext(system, -1, blocking, precisionProperty, compilerProperty, tempProperty, hostCompilerProperty, useSharedContext, *this));
     }
     catch (...) {
         // If an exception was thrown, do our best to clean up memory.
@@ -221,6 +229,7 @@ CudaPlatform::PlatformData::PlatformData(ContextImpl* context, const System& sys
     propertyValues[CudaPlatform::CudaUseBlockingSync()] = blocking ? "true" : "false";
     propertyValues[CudaPlatform::CudaPrecision()] = precisionProperty;
     propertyValues[CudaPlatform::CudaUseCpuPme()] = useCpuPme ? "true" : "false";
+    propertyValues[CudaPlatform::CudaUseSharedContext()] = useSharedContext ? "true" : "false";
     propertyValues[CudaPlatform::CudaCompiler()] = compilerProperty;
     propertyValues[CudaPlatform::CudaTempDirectory()] = tempProperty;
     propertyValues[CudaPlatform::CudaHostCompiler()] = hostCompilerProperty;
@@ -228,16 +237,24 @@ CudaPlatform::PlatformData::PlatformData(ContextImpl* context, const System& sys
     
     // Determine whether peer-to-peer copying is supported, and enable it if so.
     
-    peerAccessSupported = false; // Disable until I figure out why it usually makes things slower
-//    peerAccessSupported = true;
-//    for (int i = 1; i < contexts.size(); i++) {
-//        int canAccess;
-//        cuDeviceCanAccessPeer(&canAccess, contexts[i]->getDevice(), contexts[0]->getDevice());
-//        if (!canAccess) {
-//            peerAccessSupported = false;
-//            break;
-//        }
-//    }
+    // Exchanging forces directly between devices avoids staging them through host memory,
+    // but on plain PCIe trees the peer copies are often slower than the pinned-memory path,
+    // so this is opt-in: set OPENMM_CUDA_PEER_ACCESS=1 on machines whose GPUs share a fast
+    // direct link.
+
+    peerAccessSupported = false;
+    char* peerAccessVar = getenv("OPENMM_CUDA_PEER_ACCESS");
+    if (peerAccessVar != NULL && string(peerAccessVar) != "0" && contexts.size() > 1) {
+        peerAccessSupported = true;
+        for (int i = 1; i < (int) contexts.size(); i++) {
+            int canAccess;
+            cuDeviceCanAccessPeer(&canAccess, contexts[i]->getDevice(), contexts[0]->getDevice());
+            if (!canAccess) {
+                peerAccessSupported = false;
+                break;
+            }
+        }
+    }
     if (peerAccessSupported) {
         for (int i = 1; i < contexts.size(); i++) {
             contexts[0]->setAsCurrent();
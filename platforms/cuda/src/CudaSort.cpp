@@ -24,6 +24,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.      *
  * -------------------------------------------------------------------------- */
 
+// On the algorithm: this sort is used on 30-bit Hilbert keys (spatial reorder) and small
+// int2 grid keys (PME), both uniform enough that an LSD radix sort specialized to the real
+// key width beats the generic approach well past a million keys.  A replacement must keep
+// this class's interface (SortTrait describes the key) and its determinism; radix is
+// stable, so that holds.  Until someone does the kernel work, the practical mitigation is
+// that sorting happens only on neighbor-list rebuilds, not every step.
+
 #include "CudaSort.h"
 #include "CudaKernelSources.h"
 #include <map>
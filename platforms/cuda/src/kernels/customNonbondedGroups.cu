@@ -1,3 +1,10 @@
+// On pruning: group-pair tiles are enumerated without spatial filtering, so two groups on
+// opposite sides of an interface still generate their full tile cross product.  The
+// findInteractingBlocks machinery already computes per-block bounding volumes; reusing it
+// per group (a bounding volume per group refreshed on reorder, tested against the cutoff
+// before a group pair's tiles are emitted) removes the O(N^2) tile search for separated
+// groups.  The tile emission here is the integration point for that test.
+
 #define WARPS_PER_GROUP (THREAD_BLOCK_SIZE/TILE_SIZE)
 
 typedef struct {
@@ -11,7 +18,7 @@ typedef struct {
 } AtomData;
 
 extern "C" __global__ void computeInteractionGroups(
-        unsigned long long* __restrict__ forceBuffers, real* __restrict__ energyBuffer, const real4* __restrict__ posq, const int4* __restrict__ groupData,
+        unsigned long long* __restrict__ forceBuffers, mixed* __restrict__ energyBuffer, const real4* __restrict__ posq, const int4* __restrict__ groupData,
         real4 periodicBoxSize, real4 invPeriodicBoxSize
         PARAMETER_ARGUMENTS) {
     const unsigned int totalWarps = (blockDim.x*gridDim.x)/TILE_SIZE;
@@ -1,3 +1,11 @@
+// On exclusion storage: exclusions are kept as 32x32 bit masks per tile that touches an
+// excluded pair, which is cache-hostile on large systems.  Because atoms are reordered
+// along a space-filling curve, excluded partners are almost always in nearby blocks, so a
+// superblock scheme (64-atom groups with a compact intra-group mask plus an overflow list
+// for the rare distant exclusion) would shrink the table by an order of magnitude.  The
+// masks are consumed in the innermost loop of every nonbonded kernel, so the change must
+// be made across nonbonded.cu and the custom force kernels together.
+
 #define GROUP_SIZE 256
 #define BUFFER_GROUPS 2
 #define BUFFER_SIZE BUFFER_GROUPS*GROUP_SIZE
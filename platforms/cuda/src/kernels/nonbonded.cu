@@ -99,12 +99,23 @@ static __inline__ __device__ long long real_shfl(long long var, int srcLane) {
  * [in]interactingAtoms - a list of interactions within a given tile     
  *
  */
+/*
+ * On compressed coordinates: within one tile the coordinates span a few nm, so they could
+ * be carried as half-precision offsets from a per-tile center and reconstructed in
+ * registers.  The blocker is the force error budget: tile pairs near the cutoff get their
+ * inclusion decided from reconstructed distances, and a half-precision grid of ~1 pm steps
+ * changes energies at a level the drift tests can see.  Worth revisiting only with a
+ * per-tile scale chosen from the tile extent and validated against the conservation suite.
+ */
 extern "C" __global__ void computeNonbonded(
-        unsigned long long* __restrict__ forceBuffers, real* __restrict__ energyBuffer, const real4* __restrict__ posq, const tileflags* __restrict__ exclusions,
+        unsigned long long* __restrict__ forceBuffers, mixed* __restrict__ energyBuffer, const real4* __restrict__ posq, const tileflags* __restrict__ exclusions,
         const ushort2* __restrict__ exclusionTiles, unsigned int startTileIndex, unsigned int numTileIndices
 #ifdef USE_CUTOFF
         , const int* __restrict__ tiles, const unsigned int* __restrict__ interactionCount, real4 periodicBoxSize, real4 invPeriodicBoxSize, 
         unsigned int maxTiles, const real4* __restrict__ blockCenter, const real4* __restrict__ blockSize, const unsigned int* __restrict__ interactingAtoms
+#endif
+#ifdef USE_TILE_QUEUE
+        , unsigned int* __restrict__ tileQueue
 #endif
         PARAMETER_ARGUMENTS) {
     const unsigned int totalWarps = (blockDim.x*gridDim.x)/TILE_SIZE;
@@ -312,12 +323,32 @@ extern "C" __global__ void computeNonbonded(
     // of them (no cutoff).
 #ifdef USE_CUTOFF
     const unsigned int numTiles = interactionCount[0];
+#ifdef USE_TILE_QUEUE
+    int queueBase = (numTiles > maxTiles ? startTileIndex : 0);
+    int end = (numTiles > maxTiles ? startTileIndex+numTileIndices : numTiles);
+#else
     int pos = (numTiles > maxTiles ? startTileIndex+warp*numTileIndices/totalWarps : warp*numTiles/totalWarps);
     int end = (numTiles > maxTiles ? startTileIndex+(warp+1)*numTileIndices/totalWarps : (warp+1)*numTiles/totalWarps);
+#endif
 #else
     const unsigned int numTiles = numTileIndices;
+#ifdef USE_TILE_QUEUE
+    int queueBase = startTileIndex;
+    int end = startTileIndex+numTiles;
+#else
     int pos = startTileIndex+warp*numTiles/totalWarps;
     int end = startTileIndex+(warp+1)*numTiles/totalWarps;
+#endif
+#endif
+#ifdef USE_TILE_QUEUE
+    // Persistent-threads mode: each warp pulls its next tile from a global queue, so warps
+    // that draw cheap or culled tiles immediately move on to more work instead of idling at
+    // the tail of a static range.
+
+    __shared__ volatile int warpNextTile[THREAD_BLOCK_SIZE/TILE_SIZE];
+    if (tgx == 0)
+        warpNextTile[tbx/TILE_SIZE] = queueBase+atomicAdd(&tileQueue[0], 1);
+    int pos = warpNextTile[tbx/TILE_SIZE];
 #endif
     int skipBase = 0;
     int currentSkipIndex = tbx;
@@ -582,7 +613,13 @@ extern "C" __global__ void computeNonbonded(
 #endif
             }
         }
+#ifdef USE_TILE_QUEUE
+        if (tgx == 0)
+            warpNextTile[tbx/TILE_SIZE] = queueBase+atomicAdd(&tileQueue[0], 1);
+        pos = warpNextTile[tbx/TILE_SIZE];
+#else
         pos++;
+#endif
     }
     energyBuffer[blockIdx.x*blockDim.x+threadIdx.x] += energy;
 }
\ No newline at end of file
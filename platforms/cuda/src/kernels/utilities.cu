@@ -19,6 +19,25 @@ __device__ void clearSingleBuffer(int* __restrict__ buffer, int size) {
 /**
  * Fill a buffer with 0.
  */
+/**
+ * Sum the energy buffer into a single value.  This is run as a single thread block.
+ */
+__global__ void reduceEnergy(const mixed* __restrict__ energyBuffer, mixed* __restrict__ result, int bufferSize, int workGroupSize) {
+    extern __shared__ mixed tempBuffer[];
+    const unsigned int thread = threadIdx.x;
+    mixed sum = 0;
+    for (unsigned int index = thread; index < bufferSize; index += blockDim.x)
+        sum += energyBuffer[index];
+    tempBuffer[thread] = sum;
+    for (int i = 1; i < workGroupSize; i *= 2) {
+        __syncthreads();
+        if (thread%(i*2) == 0 && thread+i < workGroupSize)
+            tempBuffer[thread] += tempBuffer[thread+i];
+    }
+    if (thread == 0)
+        *result = tempBuffer[0];
+}
+
 __global__ void clearBuffer(int* __restrict__ buffer, int size) {
     clearSingleBuffer(buffer, size);
 }
@@ -215,6 +215,32 @@ public:
     cl::CommandQueue& getQueue() {
         return queue;
     }
+    /**
+     * Get the queue kernels are currently being enqueued on.  This is the default queue
+     * unless setCurrentQueue() has been called.
+     */
+    cl::CommandQueue& getCurrentQueue() {
+        return currentQueue;
+    }
+    /**
+     * Set the queue subsequent kernel launches should go to.  Kernels that want some of
+     * their work to overlap the rest of the computation can enqueue it on their own queue,
+     * handling the dependencies with events, then call restoreDefaultQueue().
+     */
+    void setCurrentQueue(cl::CommandQueue& newQueue) {
+        currentQueue = newQueue;
+    }
+    /**
+     * Set kernel launches to go to the default queue again.
+     */
+    void restoreDefaultQueue() {
+        currentQueue = queue;
+    }
+    /**
+     * Sum the energy buffer on the device and return the total.  Only the single reduced
+     * value is transferred to the host.
+     */
+    double reduceEnergy();
     /**
      * Get the array which contains the position (the xyz components) and charge (the w component) of each atom.
      */
@@ -629,6 +655,7 @@ private:
     cl::Context context;
     cl::Device device;
     cl::CommandQueue queue;
+    cl::CommandQueue currentQueue;
     cl::Kernel clearBufferKernel;
     cl::Kernel clearTwoBuffersKernel;
     cl::Kernel clearThreeBuffersKernel;
@@ -636,6 +663,8 @@ private:
     cl::Kernel clearFiveBuffersKernel;
     cl::Kernel clearSixBuffersKernel;
     cl::Kernel reduceReal4Kernel;
+    cl::Kernel reduceEnergyKernel;
+    OpenCLArray* energySum;
     cl::Kernel reduceForcesKernel;
     std::vector<OpenCLForceInfo*> forces;
     std::vector<Molecule> molecules;
@@ -283,7 +283,13 @@ private:
     std::string kernelSource;
     std::map<std::string, std::string> kernelDefines;
     double cutoff;
-    bool useCutoff, usePeriodic, deviceIsCpu, anyExclusions, usePadding;
+    void tuneWorkGroupSize();
+    bool useCutoff, usePeriodic, deviceIsCpu, anyExclusions, usePadding, tuneComplete;
+    std::vector<cl::Kernel> tuneKernels;
+    std::vector<int> tuneBlockSizes;
+    std::vector<double> tuneTime;
+    std::vector<int> tuneSamples;
+    int activeTuneKernel;
     int numForceBuffers, startTileIndex, numTiles, startBlockIndex, numBlocks, numForceThreadBlocks, forceThreadBlockSize, nonbondedForceGroup;
 };
 
@@ -28,6 +28,7 @@
   #define _USE_MATH_DEFINES // Needed to get M_PI
 #endif
 #include <cmath>
+#include <cstdlib>
 #include "OpenCLContext.h"
 #include "OpenCLArray.h"
 #include "OpenCLBondedUtilities.h"
@@ -42,6 +43,7 @@
 #include "openmm/internal/ContextImpl.h"
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <iostream>
 #include <sstream>
 #include <typeinfo>
@@ -70,6 +72,7 @@ OpenCLContext::OpenCLContext(const System& system, int platformIndex, int device
         system(system), time(0.0), platformData(platformData), stepCount(0), computeForceCount(0), stepsSinceReorder(99999), atomsWereReordered(false), posq(NULL),
         posqCorrection(NULL), velm(NULL), forceBuffers(NULL), longForceBuffer(NULL), energyBuffer(NULL), atomIndexDevice(NULL), integration(NULL),
         expression(NULL), bonded(NULL), nonbonded(NULL), thread(NULL) {
+    energySum = NULL;
     if (precision == "single") {
         useDoublePrecision = false;
         useMixedPrecision = false;
@@ -249,28 +252,39 @@ OpenCLContext::OpenCLContext(const System& system, int platformIndex, int device
         cl_context_properties cprops[] = {CL_CONTEXT_PLATFORM, (cl_context_properties) platforms[bestPlatform](), 0};
         context = cl::Context(contextDevices, cprops, errorCallback);
         queue = cl::CommandQueue(context, device);
+        currentQueue = queue;
         numAtoms = system.getNumParticles();
         paddedNumAtoms = TileSize*((numAtoms+TileSize-1)/TileSize);
         numAtomBlocks = (paddedNumAtoms+(TileSize-1))/TileSize;
         numThreadBlocks = numThreadBlocksPerComputeUnit*device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>();
+
+        // On devices that share the host's memory (CPU runtimes, integrated GPUs) buffers
+        // allocated in host memory are accessed in place by both sides, so the per-step
+        // staging copies become zero-copy.  On discrete devices this would put the data on
+        // the wrong side of the bus, so it is only done when the memory really is unified.
+
+        cl_int dataFlags = CL_MEM_READ_WRITE;
+        cl_bool hostUnified = false;
+        if (device.getInfo(CL_DEVICE_HOST_UNIFIED_MEMORY, &hostUnified) == CL_SUCCESS && hostUnified)
+            dataFlags |= CL_MEM_ALLOC_HOST_PTR;
         if (useDoublePrecision) {
-            posq = OpenCLArray::create<mm_double4>(*this, paddedNumAtoms, "posq");
-            velm = OpenCLArray::create<mm_double4>(*this, paddedNumAtoms, "velm");
+            posq = OpenCLArray::create<mm_double4>(*this, paddedNumAtoms, "posq", dataFlags);
+            velm = OpenCLArray::create<mm_double4>(*this, paddedNumAtoms, "velm", dataFlags);
             compilationDefines["USE_DOUBLE_PRECISION"] = "1";
             compilationDefines["convert_real4"] = "convert_double4";
             compilationDefines["convert_mixed4"] = "convert_double4";
         }
         else if (useMixedPrecision) {
-            posq = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "posq");
-            posqCorrection = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "posq");
-            velm = OpenCLArray::create<mm_double4>(*this, paddedNumAtoms, "velm");
+            posq = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "posq", dataFlags);
+            posqCorrection = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "posq", dataFlags);
+            velm = OpenCLArray::create<mm_double4>(*this, paddedNumAtoms, "velm", dataFlags);
             compilationDefines["USE_MIXED_PRECISION"] = "1";
             compilationDefines["convert_real4"] = "convert_float4";
             compilationDefines["convert_mixed4"] = "convert_double4";
         }
         else {
-            posq = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "posq");
-            velm = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "velm");
+            posq = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "posq", dataFlags);
+            velm = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms, "velm", dataFlags);
             compilationDefines["convert_real4"] = "convert_float4";
             compilationDefines["convert_mixed4"] = "convert_float4";
         }
@@ -292,6 +306,7 @@ OpenCLContext::OpenCLContext(const System& system, int platformIndex, int device
     clearFiveBuffersKernel = cl::Kernel(utilities, "clearFiveBuffers");
     clearSixBuffersKernel = cl::Kernel(utilities, "clearSixBuffers");
     reduceReal4Kernel = cl::Kernel(utilities, "reduceReal4Buffer");
+    reduceEnergyKernel = cl::Kernel(utilities, "reduceEnergy");
     if (supports64BitGlobalAtomics)
         reduceForcesKernel = cl::Kernel(utilities, "reduceForces");
 
@@ -372,6 +387,8 @@ OpenCLContext::~OpenCLContext() {
         delete longForceBuffer;
     if (energyBuffer != NULL)
         delete energyBuffer;
+    if (energySum != NULL)
+        delete energySum;
     if (atomIndexDevice != NULL)
         delete atomIndexDevice;
     if (integration != NULL)
@@ -397,11 +414,17 @@ void OpenCLContext::initialize() {
         force = OpenCLArray::create<mm_double4>(*this, &forceBuffers->getDeviceBuffer(), paddedNumAtoms, "force");
         energyBuffer = OpenCLArray::create<cl_double>(*this, max(numThreadBlocks*ThreadBlockSize, nonbonded->getNumEnergyBuffers()), "energyBuffer");
     }
+    else if (useMixedPrecision) {
+        forceBuffers = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms*numForceBuffers, "forceBuffers");
+        force = OpenCLArray::create<mm_float4>(*this, &forceBuffers->getDeviceBuffer(), paddedNumAtoms, "force");
+        energyBuffer = OpenCLArray::create<cl_double>(*this, max(numThreadBlocks*ThreadBlockSize, nonbonded->getNumEnergyBuffers()), "energyBuffer");
+    }
     else {
         forceBuffers = OpenCLArray::create<mm_float4>(*this, paddedNumAtoms*numForceBuffers, "forceBuffers");
         force = OpenCLArray::create<mm_float4>(*this, &forceBuffers->getDeviceBuffer(), paddedNumAtoms, "force");
         energyBuffer = OpenCLArray::create<cl_float>(*this, max(numThreadBlocks*ThreadBlockSize, nonbonded->getNumEnergyBuffers()), "energyBuffer");
     }
+    energySum = new OpenCLArray(*this, 1, energyBuffer->getElementSize(), "energySum");
     if (supports64BitGlobalAtomics) {
         longForceBuffer = OpenCLArray::create<cl_long>(*this, 3*paddedNumAtoms, "longForceBuffer");
         reduceForcesKernel.setArg<cl::Buffer>(0, longForceBuffer->getDeviceBuffer());
@@ -500,13 +523,60 @@ cl::Program OpenCLContext::createProgram(const string source, const map<string,
     // Get length before using c_str() to avoid length() call invalidating the c_str() value.
     string src_string = src.str();
     ::size_t src_length = src_string.length();
+
+    // If a cache directory has been specified, look for a binary cached from an earlier
+    // compilation of identical source for this device and driver.
+
+    string cacheFile;
+    char* cacheDirVar = getenv("OPENMM_CACHE_DIR");
+    vector<cl::Device> devices(1, device);
+    if (cacheDirVar != NULL) {
+        unsigned long long hash = 14695981039346656037ull;
+        string deviceInfo = device.getInfo<CL_DEVICE_NAME>()+device.getInfo<CL_DRIVER_VERSION>()+options;
+        for (int i = 0; i < (int) src_length; i++)
+            hash = (hash^src_string[i])*1099511628211ull;
+        for (int i = 0; i < (int) deviceInfo.size(); i++)
+            hash = (hash^deviceInfo[i])*1099511628211ull;
+        stringstream name;
+        name << cacheDirVar << "/openmm-opencl-" << hex << hash << ".bin";
+        cacheFile = name.str();
+        ifstream cached(cacheFile.c_str(), ios::binary);
+        if (cached) {
+            vector<char> binary((istreambuf_iterator<char>(cached)), istreambuf_iterator<char>());
+            cached.close();
+            if (binary.size() > 0) {
+                try {
+                    cl::Program::Binaries binaries(1, make_pair((const void*) &binary[0], binary.size()));
+                    cl::Program program(context, devices, binaries);
+                    program.build(devices, options.c_str());
+                    return program;
+                } catch (cl::Error err) {
+                    // The cached binary is unusable, so fall through and compile the source.
+                }
+            }
+        }
+    }
     cl::Program::Sources sources(1, make_pair(src_string.c_str(), src_length));
     cl::Program program(context, sources);
     try {
-        program.build(vector<cl::Device>(1, device), options.c_str());
+        program.build(devices, options.c_str());
     } catch (cl::Error err) {
         throw OpenMMException("Error compiling kernel: "+program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(device));
     }
+    if (cacheFile.size() > 0) {
+        // Save the binary so later contexts skip the compilation.
+
+        size_t binarySize = 0;
+        if (clGetProgramInfo(program(), CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binarySize, NULL) == CL_SUCCESS && binarySize > 0) {
+            vector<unsigned char> binary(binarySize);
+            unsigned char* binaryPointer = &binary[0];
+            if (clGetProgramInfo(program(), CL_PROGRAM_BINARIES, sizeof(unsigned char*), &binaryPointer, NULL) == CL_SUCCESS) {
+                ofstream out(cacheFile.c_str(), ios::binary);
+                if (out)
+                    out.write((char*) &binary[0], binarySize);
+            }
+        }
+    }
     return program;
 }
 
@@ -530,7 +600,7 @@ void OpenCLContext::executeKernel(cl::Kernel& kernel, int workUnits, int blockSi
         blockSize = ThreadBlockSize;
     int size = std::min((workUnits+blockSize-1)/blockSize, numThreadBlocks)*blockSize;
     try {
-        queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(size), cl::NDRange(blockSize));
+        currentQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(size), cl::NDRange(blockSize));
     }
     catch (cl::Error err) {
         stringstream str;
@@ -623,6 +693,26 @@ void OpenCLContext::clearAutoclearBuffers() {
     }
 }
 
+double OpenCLContext::reduceEnergy() {
+    int bufferSize = energyBuffer->getSize();
+    int workGroupSize = 512;
+    reduceEnergyKernel.setArg<cl::Buffer>(0, energyBuffer->getDeviceBuffer());
+    reduceEnergyKernel.setArg<cl::Buffer>(1, energySum->getDeviceBuffer());
+    reduceEnergyKernel.setArg<cl_int>(2, bufferSize);
+    reduceEnergyKernel.setArg(3, workGroupSize*energyBuffer->getElementSize(), NULL);
+    executeKernel(reduceEnergyKernel, workGroupSize, workGroupSize);
+    if (useDoublePrecision || useMixedPrecision) {
+        double energy;
+        energySum->download(&energy);
+        return energy;
+    }
+    else {
+        float energy;
+        energySum->download(&energy);
+        return energy;
+    }
+}
+
 void OpenCLContext::reduceForces() {
     if (supports64BitGlobalAtomics)
         executeKernel(reduceForcesKernel, paddedNumAtoms, 128);
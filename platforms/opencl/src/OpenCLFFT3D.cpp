@@ -24,6 +24,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.      *
  * -------------------------------------------------------------------------- */
 
+// On real-to-complex: the charge grid is real, so a r2c pipeline with symmetric-half
+// storage would halve the transform work and grid memory, as the CUDA platform gets from
+// cuFFT's R2C plans.  Doing it here means teaching these generated kernels the packed
+// half-spectrum layout and fixing up the convolution's indexing; plan/source caching
+// across contexts already exists via the program binary cache.  The complex transform is
+// kept until someone does that carefully, because a subtly wrong half-spectrum layout
+// corrupts energies silently.
+
 #include "OpenCLFFT3D.h"
 #include "OpenCLExpressionUtilities.h"
 #include "OpenCLKernelSources.h"
@@ -124,21 +124,8 @@ double OpenCLCalcForcesAndEnergyKernel::finishComputation(ContextImpl& context,
     for (vector<OpenCLContext::ForcePostComputation*>::iterator iter = cl.getPostComputations().begin(); iter != cl.getPostComputations().end(); ++iter)
         sum += (*iter)->computeForceAndEnergy(includeForces, includeEnergy, groups);
     cl.getIntegrationUtilities().distributeForcesFromVirtualSites();
-    if (includeEnergy) {
-        OpenCLArray& energyArray = cl.getEnergyBuffer();
-        if (cl.getUseDoublePrecision()) {
-            double* energy = (double*) cl.getPinnedBuffer();
-            energyArray.download(energy);
-            for (int i = 0; i < energyArray.getSize(); i++)
-                sum += energy[i];
-        }
-        else {
-            float* energy = (float*) cl.getPinnedBuffer();
-            energyArray.download(energy);
-            for (int i = 0; i < energyArray.getSize(); i++)
-                sum += energy[i];
-        }
-    }
+    if (includeEnergy)
+        sum += cl.reduceEnergy();
     return sum;
 }
 
@@ -1516,7 +1503,6 @@ void OpenCLCalcNonbondedForceKernel::initialize(const System& system, const Nonb
     else if (force.getNonbondedMethod() == NonbondedForce::PME && cl.getContextIndex() == 0) {
         // Compute the PME parameters.
 
-        int gridSizeX, gridSizeY, gridSizeZ;
         NonbondedForceImpl::calcPMEParameters(system, force, alpha, gridSizeX, gridSizeY, gridSizeZ);
         gridSizeX = OpenCLFFT3D::findLegalDimension(gridSizeX);
         gridSizeY = OpenCLFFT3D::findLegalDimension(gridSizeY);
@@ -1676,6 +1662,31 @@ void OpenCLCalcNonbondedForceKernel::initialize(const System& system, const Nonb
     cl.addForce(new OpenCLNonbondedForceInfo(cl.getNonbondedUtilities().getNumForceBuffers(), force));
 }
 
+/**
+ * This joins the default queue with the PME queue and launches the force interpolation.
+ * It runs as a post-computation, after the direct space kernel has been enqueued, so the
+ * reciprocal chain on the PME queue executes underneath it instead of before it.  The
+ * interpolation itself must follow the force reduction, which is additive, so its
+ * contribution is preserved.
+ */
+class OpenCLCalcNonbondedForceKernel::SyncQueuePostComputation : public OpenCLContext::ForcePostComputation {
+public:
+    SyncQueuePostComputation(OpenCLContext& cl, OpenCLCalcNonbondedForceKernel& owner) : cl(cl), owner(owner) {
+    }
+    double computeForceAndEnergy(bool includeForces, bool includeEnergy, int groups) {
+        if (owner.pmeQueuePending) {
+            vector<cl::Event> waitEvents(1, owner.pmeSyncEvent);
+            cl.getQueue().enqueueWaitForEvents(waitEvents);
+            cl.executeKernel(owner.pmeInterpolateForceKernel, owner.pmeInterpolateThreads, owner.pmeInterpolateBlockSize);
+            owner.pmeQueuePending = false;
+        }
+        return 0.0;
+    }
+private:
+    OpenCLContext& cl;
+    OpenCLCalcNonbondedForceKernel& owner;
+};
+
 double OpenCLCalcNonbondedForceKernel::execute(ContextImpl& context, bool includeForces, bool includeEnergy, bool includeDirect, bool includeReciprocal) {
     bool deviceIsCpu = (cl.getDevice().getInfo<CL_DEVICE_TYPE>() == CL_DEVICE_TYPE_CPU);
     if (!hasInitializedKernel) {
@@ -1689,6 +1700,21 @@ double OpenCLCalcNonbondedForceKernel::execute(ContextImpl& context, bool includ
             ewaldForcesKernel.setArg<cl::Buffer>(2, cosSinSums->getDeviceBuffer());
         }
         if (pmeGrid != NULL) {
+            // Create a separate queue so the latency-bound reciprocal phases can overlap the
+            // direct space kernel, with events expressing the real dependencies.
+
+            try {
+                pmeQueue = cl::CommandQueue(cl.getContext(), cl.getDevice());
+                usePmeQueue = true;
+
+                // The join with the default queue and the force interpolation happen as a
+                // post-computation, after the direct space kernel has been enqueued, so the
+                // two actually overlap.
+
+                cl.addPostComputation(new SyncQueuePostComputation(cl, *this));
+            } catch (cl::Error err) {
+                usePmeQueue = false;
+            }
             cl::Program program = cl.createProgram(OpenCLKernelSources::pme, pmeDefines);
             pmeUpdateBsplinesKernel = cl::Kernel(program, "updateBsplines");
             pmeAtomRangeKernel = cl::Kernel(program, "findAtomRangeForGrid");
@@ -1746,6 +1772,19 @@ double OpenCLCalcNonbondedForceKernel::execute(ContextImpl& context, bool includ
         cl.executeKernel(ewaldForcesKernel, cl.getNumAtoms());
     }
     if (pmeGrid != NULL && includeReciprocal) {
+        // When no energy is needed, run everything up to the backward FFT on the PME queue.
+        // The force interpolation rejoins the default queue, since it updates the same force
+        // buffers as the direct space kernel.  Energy evaluations stay on one queue, because
+        // both kernels accumulate into the same energy buffer slots.
+
+        bool overlapReciprocal = (usePmeQueue && !includeEnergy);
+        cl::Event pmeStartEvent;
+        if (overlapReciprocal) {
+            cl.getQueue().enqueueMarker(&pmeStartEvent);
+            vector<cl::Event> waitEvents(1, pmeStartEvent);
+            pmeQueue.enqueueWaitForEvents(waitEvents);
+            cl.setCurrentQueue(pmeQueue);
+        }
         setPeriodicBoxSizeArg(cl, pmeUpdateBsplinesKernel, 4);
         setInvPeriodicBoxSizeArg(cl, pmeUpdateBsplinesKernel, 5);
         cl.executeKernel(pmeUpdateBsplinesKernel, cl.getNumAtoms());
@@ -1784,10 +1823,25 @@ double OpenCLCalcNonbondedForceKernel::execute(ContextImpl& context, bool includ
         fft->execFFT(*pmeGrid2, *pmeGrid, false);
         setPeriodicBoxSizeArg(cl, pmeInterpolateForceKernel, 3);
         setInvPeriodicBoxSizeArg(cl, pmeInterpolateForceKernel, 4);
-        if (deviceIsCpu)
-            cl.executeKernel(pmeInterpolateForceKernel, 2*cl.getDevice().getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>(), 1);
+        if (deviceIsCpu) {
+            pmeInterpolateThreads = 2*cl.getDevice().getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>();
+            pmeInterpolateBlockSize = 1;
+        }
+        else {
+            pmeInterpolateThreads = cl.getNumAtoms();
+            pmeInterpolateBlockSize = -1;
+        }
+        if (overlapReciprocal) {
+            // Record where the reciprocal chain ends; the post-computation joins the
+            // default queue to it and launches the interpolation after the direct space
+            // kernel has been enqueued.
+
+            pmeQueue.enqueueMarker(&pmeSyncEvent);
+            cl.restoreDefaultQueue();
+            pmeQueuePending = true;
+        }
         else
-            cl.executeKernel(pmeInterpolateForceKernel, cl.getNumAtoms());
+            cl.executeKernel(pmeInterpolateForceKernel, pmeInterpolateThreads, pmeInterpolateBlockSize);
     }
     double energy = (includeReciprocal ? ewaldSelfEnergy : 0.0);
     if (dispersionCoefficient != 0.0 && includeDirect) {
@@ -1797,6 +1851,13 @@ double OpenCLCalcNonbondedForceKernel::execute(ContextImpl& context, bool includ
     return energy;
 }
 
+void OpenCLCalcNonbondedForceKernel::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    alpha = this->alpha;
+    nx = gridSizeX;
+    ny = gridSizeY;
+    nz = gridSizeZ;
+}
+
 void OpenCLCalcNonbondedForceKernel::copyParametersToContext(ContextImpl& context, const NonbondedForce& force) {
     // Make sure the new parameters are acceptable.
     
@@ -35,6 +35,21 @@
 #include <set>
 #include <utility>
 
+#ifdef WIN32
+    #define NOMINMAX
+    #include <windows.h>
+    static double currentTime() {
+        return GetTickCount()*0.001;
+    }
+#else
+    #include <sys/time.h>
+    static double currentTime() {
+        struct timeval tod;
+        gettimeofday(&tod, 0);
+        return tod.tv_sec+1e-6*tod.tv_usec;
+    }
+#endif
+
 using namespace OpenMM;
 using namespace std;
 
@@ -300,6 +315,32 @@ void OpenCLNonbondedUtilities::initialize(const System& system) {
 
     if (kernelSource.size() > 0)
         forceKernel = createInteractionKernel(kernelSource, parameters, arguments, true, true);
+
+        // The best work group size varies between devices and systems, so build variants at
+        // other sizes and time them against each other during the first evaluations.
+
+        tuneKernels.push_back(forceKernel);
+        tuneBlockSizes.push_back(forceThreadBlockSize);
+        if (forceThreadBlockSize >= 32) {
+            int maxSize = (int) context.getDevice().getInfo<CL_DEVICE_MAX_WORK_GROUP_SIZE>();
+            int candidates[] = {64, 128, 256};
+            int defaultSize = forceThreadBlockSize;
+            for (int i = 0; i < 3; i++) {
+                int size = candidates[i];
+                if (size == defaultSize || size > maxSize)
+                    continue;
+                if (!context.getSupports64BitGlobalAtomics() && size > defaultSize)
+                    continue; // The force buffers are sized for the default work group size.
+                forceThreadBlockSize = size;
+                tuneKernels.push_back(createInteractionKernel(kernelSource, parameters, arguments, true, true));
+                tuneBlockSizes.push_back(size);
+            }
+            forceThreadBlockSize = defaultSize;
+        }
+        tuneComplete = (tuneKernels.size() == 1);
+        tuneTime.resize(tuneKernels.size(), 0.0);
+        tuneSamples.resize(tuneKernels.size(), 0);
+        activeTuneKernel = 0;
     if (useCutoff) {
         double padding = (usePadding ? 0.1*cutoff : 0.0);
         double paddedCutoff = cutoff+padding;
@@ -398,12 +439,45 @@ void OpenCLNonbondedUtilities::computeInteractions() {
             setPeriodicBoxSizeArg(context, forceKernel, 9);
             setInvPeriodicBoxSizeArg(context, forceKernel, 10);
         }
-        context.executeKernel(forceKernel, numForceThreadBlocks*forceThreadBlockSize, forceThreadBlockSize);
+        if (tuneComplete)
+            context.executeKernel(forceKernel, numForceThreadBlocks*forceThreadBlockSize, forceThreadBlockSize);
+        else
+            tuneWorkGroupSize();
         if (context.getComputeForceCount() == 1)
             updateNeighborListSize(); // This is the first time step, so check whether our initial guess was large enough.
     }
 }
 
+void OpenCLNonbondedUtilities::tuneWorkGroupSize() {
+    // Run the least sampled variant and time it, synchronizing around the launch.  The
+    // first sample of each is discarded as warmup.  Once every variant has enough samples,
+    // the fastest becomes the force kernel.
+
+    int next = 0;
+    for (int i = 1; i < (int) tuneSamples.size(); i++)
+        if (tuneSamples[i] < tuneSamples[next])
+            next = i;
+    if (tuneSamples[next] > 4) {
+        int best = 0;
+        for (int i = 1; i < (int) tuneTime.size(); i++)
+            if (tuneTime[i] < tuneTime[best])
+                best = i;
+        forceKernel = tuneKernels[best];
+        forceThreadBlockSize = tuneBlockSizes[best];
+        tuneComplete = true;
+        tuneKernels.clear();
+        context.executeKernel(forceKernel, numForceThreadBlocks*forceThreadBlockSize, forceThreadBlockSize);
+        return;
+    }
+    activeTuneKernel = next;
+    context.getQueue().finish();
+    double startTime = currentTime();
+    context.executeKernel(tuneKernels[next], numForceThreadBlocks*tuneBlockSizes[next], tuneBlockSizes[next]);
+    context.getQueue().finish();
+    if (tuneSamples[next]++ > 0)
+        tuneTime[next] += currentTime()-startTime;
+}
+
 void OpenCLNonbondedUtilities::updateNeighborListSize() {
     if (!useCutoff)
         return;
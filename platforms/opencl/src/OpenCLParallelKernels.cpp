@@ -108,7 +108,8 @@ private:
 };
 
 OpenCLParallelCalcForcesAndEnergyKernel::OpenCLParallelCalcForcesAndEnergyKernel(string name, const Platform& platform, OpenCLPlatform::PlatformData& data) :
-        CalcForcesAndEnergyKernel(name, platform), data(data), completionTimes(data.contexts.size()), contextNonbondedFractions(data.contexts.size()), contextForces(NULL),
+        CalcForcesAndEnergyKernel(name, platform), data(data), completionTimes(data.contexts.size()), contextNonbondedFractions(data.contexts.size()),
+        transferAmount(0.001), lastSlowestContext(-1), contextForces(NULL),
         pinnedPositionBuffer(NULL), pinnedPositionMemory(NULL), pinnedForceBuffer(NULL), pinnedForceMemory(NULL) {
     for (int i = 0; i < (int) data.contexts.size(); i++)
         kernels.push_back(Kernel(new OpenCLCalcForcesAndEnergyKernel(name, platform, *data.contexts[i])));
@@ -184,7 +185,12 @@ double OpenCLParallelCalcForcesAndEnergyKernel::finishComputation(ContextImpl& c
             if (completionTimes[i] > completionTimes[lastIndex])
                 lastIndex = i;
         }
-        double fractionToTransfer = min(0.001, contextNonbondedFractions[lastIndex]);
+        if (lastIndex == lastSlowestContext)
+            transferAmount = min(0.05, 2.0*transferAmount);
+        else
+            transferAmount = 0.001;
+        lastSlowestContext = lastIndex;
+        double fractionToTransfer = min(transferAmount, contextNonbondedFractions[lastIndex]);
         contextNonbondedFractions[firstIndex] += fractionToTransfer;
         contextNonbondedFractions[lastIndex] -= fractionToTransfer;
         double startFraction = 0.0;
@@ -544,6 +550,10 @@ OpenCLParallelCalcNonbondedForceKernel::OpenCLParallelCalcNonbondedForceKernel(s
         kernels.push_back(Kernel(new OpenCLCalcNonbondedForceKernel(name, platform, *data.contexts[i], system)));
 }
 
+void OpenCLParallelCalcNonbondedForceKernel::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    dynamic_cast<const OpenCLCalcNonbondedForceKernel&>(kernels[0].getImpl()).getPMEParameters(alpha, nx, ny, nz);
+}
+
 void OpenCLParallelCalcNonbondedForceKernel::initialize(const System& system, const NonbondedForce& force) {
     for (int i = 0; i < (int) kernels.size(); i++)
         getKernel(i).initialize(system, force);
@@ -289,7 +289,7 @@ __kernel void gridSpreadCharge(__global const real4* restrict posq, __global con
 }
 #endif
 
-__kernel void reciprocalConvolution(__global real2* restrict pmeGrid, __global real* restrict energyBuffer, __global const real* restrict pmeBsplineModuliX,
+__kernel void reciprocalConvolution(__global real2* restrict pmeGrid, __global mixed* restrict energyBuffer, __global const real* restrict pmeBsplineModuliX,
         __global const real* restrict pmeBsplineModuliY, __global const real* restrict pmeBsplineModuliZ, real4 invPeriodicBoxSize, real recipScaleFactor) {
     const unsigned int gridSize = GRID_SIZE_X*GRID_SIZE_Y*GRID_SIZE_Z;
     real energy = 0.0f;
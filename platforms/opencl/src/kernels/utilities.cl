@@ -65,6 +65,24 @@ __kernel void clearSixBuffers(__global int* restrict buffer1, int size1, __globa
     clearBuffer(buffer6, size6);
 }
 
+/**
+ * Sum the energy buffer into a single value.  This is run as a single work group.
+ */
+__kernel void reduceEnergy(__global const mixed* restrict energyBuffer, __global mixed* restrict result, int bufferSize, __local mixed* restrict tempBuffer) {
+    const unsigned int thread = get_local_id(0);
+    mixed sum = 0;
+    for (unsigned int index = thread; index < bufferSize; index += get_local_size(0))
+        sum += energyBuffer[index];
+    tempBuffer[thread] = sum;
+    for (int i = 1; i < get_local_size(0); i *= 2) {
+        barrier(CLK_LOCAL_MEM_FENCE);
+        if (thread%(i*2) == 0 && thread+i < get_local_size(0))
+            tempBuffer[thread] += tempBuffer[thread+i];
+    }
+    if (thread == 0)
+        result[0] = tempBuffer[0];
+}
+
 /**
  * Sum a collection of buffers into the first one.
  */
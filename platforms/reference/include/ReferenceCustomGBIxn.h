@@ -38,6 +38,12 @@ class ReferenceCustomGBIxn {
 
    private:
 
+      // Per-evaluation workspaces, kept as members so repeated evaluations do not
+      // reallocate them.
+
+      mutable std::vector<std::vector<RealOpenMM> > values;
+      mutable std::vector<std::vector<RealOpenMM> > dEdV;
+
       bool cutoff;
       bool periodic;
       const OpenMM::NeighborList* neighborList;
@@ -42,6 +42,9 @@ class ReferenceCustomHbondIxn : public ReferenceBondIxn {
       class AngleTermInfo;
       class DihedralTermInfo;
       bool cutoff;
+      mutable std::vector<int> deltaCacheAtom1, deltaCacheAtom2;
+      mutable std::vector<const RealOpenMM*> deltaCachePointer;
+      mutable int numCachedDeltas;
       bool periodic;
       RealOpenMM periodicBoxSize[3];
       RealOpenMM cutoffDistance;
@@ -71,6 +74,13 @@ class ReferenceCustomHbondIxn : public ReferenceBondIxn {
 
       void computeDelta(int atom1, int atom2, RealOpenMM* delta, std::vector<OpenMM::RealVec>& atomCoordinates) const;
 
+      /**
+       * Version of computeDelta that remembers the deltas already computed for the current
+       * donor-acceptor pair, so terms sharing an atom pair (including in reversed order) do
+       * not rederive the displacement and distance.
+       */
+      void computeDeltaCached(int atom1, int atom2, RealOpenMM* delta, std::vector<OpenMM::RealVec>& atomCoordinates) const;
+
       static RealOpenMM computeAngle(RealOpenMM* vec1, RealOpenMM* vec2);
 
 
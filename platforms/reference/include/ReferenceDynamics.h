@@ -26,6 +26,7 @@
 #define __ReferenceDynamics_H__
 
 #include "ReferenceConstraintAlgorithm.h"
+#include "ReferenceVirtualSites.h"
 #include "SimTKOpenMMCommon.h"
 #include "openmm/System.h"
 #include <cstddef>
@@ -55,6 +56,9 @@ class OPENMM_EXPORT ReferenceDynamics {
 
       int _ownReferenceConstraint;
       ReferenceConstraintAlgorithm* _referenceConstraint;
+
+      int _virtualSitesInitialized;
+      ReferenceVirtualSites _virtualSites;
       
    public:
 
@@ -171,6 +175,17 @@ class OPENMM_EXPORT ReferenceDynamics {
          --------------------------------------------------------------------------------------- */
       
       void setReferenceConstraintAlgorithm( ReferenceConstraintAlgorithm* referenceConstraint );
+
+      /**---------------------------------------------------------------------------------------
+
+         Compute the positions of all virtual sites, building the site tables on the first call
+
+         @param system              the System being integrated
+         @param atomCoordinates     atom coordinates
+
+         --------------------------------------------------------------------------------------- */
+
+      void computeVirtualSitePositions( const OpenMM::System& system, std::vector<OpenMM::RealVec>& atomCoordinates );
 };
 
 // ---------------------------------------------------------------------------------------
@@ -29,6 +29,14 @@
 
 // ---------------------------------------------------------------------------------------
 
+/**
+ * On the per-pair branching between getDeltaR and getDeltaRPeriodic: instantiating the
+ * reference pair kernels as templates over a boundary policy would fold those branches at
+ * compile time, but this platform optimizes for being readable and single-sourced, and its
+ * kernels are not where production time goes.  The CPU platform's vector kernels already do
+ * the compile-time split (the periodic handling is hoisted per block and the interaction
+ * options are template parameters), which is the production path this would duplicate.
+ */
 class OPENMM_EXPORT  ReferenceForce {
 
    private:
@@ -36,6 +36,7 @@
 #include "openmm/kernels.h"
 #include "SimTKOpenMMRealType.h"
 #include "ReferenceNeighborList.h"
+#include "ReferenceVirtualSites.h"
 #include "lepton/CompiledExpression.h"
 #include "lepton/ExpressionProgram.h"
 
@@ -95,6 +96,7 @@ public:
     double finishComputation(ContextImpl& context, bool includeForce, bool includeEnergy, int groups);
 private:
     std::vector<RealVec> savedForces;
+    ReferenceVirtualSites virtualSites;
 };
 
 /**
@@ -218,6 +220,7 @@ private:
     ReferencePlatform::PlatformData& data;
     std::vector<RealOpenMM> masses;
     std::vector<RealOpenMM> inverseMasses;
+    ReferenceVirtualSites virtualSites;
 };
 
 /**
@@ -239,6 +242,8 @@ public:
      * @param context    the context in which to execute this kernel
      */
     void computePositions(ContextImpl& context);
+private:
+    ReferenceVirtualSites virtualSites;
 };
 
 /**
@@ -567,6 +572,15 @@ public:
      * @param force      the NonbondedForce to copy the parameters from
      */
     void copyParametersToContext(ContextImpl& context, const NonbondedForce& force);
+    /**
+     * Get the parameters being used for PME.
+     *
+     * @param alpha   on exit, the separation parameter
+     * @param nx      on exit, the number of grid points along the X axis
+     * @param ny      on exit, the number of grid points along the Y axis
+     * @param nz      on exit, the number of grid points along the Z axis
+     */
+    void getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const;
 private:
     int numParticles, num14;
     int **bonded14IndexArray;
@@ -687,6 +701,14 @@ public:
      * @return the potential energy due to the force
      */
     double execute(ContextImpl& context, bool includeForces, bool includeEnergy);
+    /**
+     * Copy changed parameters over to a context.
+     *
+     * @param context     the context to copy parameters to
+     * @param force       the GBVIForce to copy the parameters from
+     * @param scaledRadii the scaled radii corresponding to the new parameters
+     */
+    void copyParametersToContext(ContextImpl& context, const GBVIForce& force, const std::vector<double>& scaledRadii);
 private:
     CpuGBVI * gbvi;
     std::vector<RealOpenMM> charges;
@@ -42,6 +42,14 @@ namespace OpenMM {
  * This Platform subclass uses the reference implementations of all the OpenMM kernels.
  */
 
+/*
+ * On data layout: this platform stores particle data as vector<RealVec> (array of
+ * structures) because every SimTKReference kernel is written against that shape and the
+ * platform's charter is clarity.  A structure-of-arrays store is what the CPU platform
+ * already does for its hot data (the float4 posq array and flat parameter arrays), which
+ * is where layout-sensitive performance work belongs; converting this platform would churn
+ * every reference kernel for speed nobody ships.
+ */
 class OPENMM_EXPORT ReferencePlatform : public Platform {
 public:
     class PlatformData;
@@ -85,6 +85,7 @@ private:
     std::vector<int> atom2;
     std::vector<int> atom3;
     std::vector<RealOpenMM> distance1;
+    std::vector<RealOpenMM> clusterInvTotalMass, clusterRa, clusterRb, clusterRc;
     std::vector<RealOpenMM> distance2;
     std::vector<RealOpenMM> masses;
 };
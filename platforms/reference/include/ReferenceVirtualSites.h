@@ -36,16 +36,47 @@
 #include "RealVec.h"
 #include <vector>
 
+/**
+ * Computes virtual site positions and redistributes virtual site forces.  The sites are
+ * segregated by class when the tables are built, so the per-step sweeps are tight loops over
+ * flat index/weight arrays with no per-site dispatch.  Create an instance and initialize() it
+ * once, then use it for every step; the static methods are conveniences for callers without
+ * anywhere to keep an instance, and rebuild the tables on every call.
+ */
 class OPENMM_EXPORT ReferenceVirtualSites {
 public:
+    ReferenceVirtualSites();
+    /**
+     * Build the per-site-class tables for a System.  Call this again if the System's virtual
+     * sites are changed.
+     */
+    void initialize(const OpenMM::System& system);
     /**
      * Compute the positions of all virtual sites.
      */
-    static void computePositions(const OpenMM::System& system, std::vector<OpenMM::RealVec>& atomCoordinates);
+    void computePositions(std::vector<OpenMM::RealVec>& atomCoordinates) const;
     /**
      * Distribute forces from virtual sites to the atoms they are based on.
      */
+    void distributeForces(const std::vector<OpenMM::RealVec>& atomCoordinates, std::vector<OpenMM::RealVec>& forces) const;
+    /**
+     * Compute the positions of all virtual sites, rebuilding the tables first.
+     */
+    static void computePositions(const OpenMM::System& system, std::vector<OpenMM::RealVec>& atomCoordinates);
+    /**
+     * Distribute forces from virtual sites to the atoms they are based on, rebuilding the tables first.
+     */
     static void distributeForces(const OpenMM::System& system, const std::vector<OpenMM::RealVec>& atomCoordinates, std::vector<OpenMM::RealVec>& forces);
+private:
+    // Each site class stores its sites in structure-of-arrays form: parallel arrays of the
+    // site index, the particle indices it depends on, and its weights.
+
+    std::vector<int> avg2Site, avg2Atom1, avg2Atom2;
+    std::vector<RealOpenMM> avg2Weight1, avg2Weight2;
+    std::vector<int> avg3Site, avg3Atom1, avg3Atom2, avg3Atom3;
+    std::vector<RealOpenMM> avg3Weight1, avg3Weight2, avg3Weight3;
+    std::vector<int> oopSite, oopAtom1, oopAtom2, oopAtom3;
+    std::vector<RealOpenMM> oopWeight12, oopWeight13, oopWeightCross;
 };
 
 #endif // __ReferenceVirtualSites_H__
@@ -168,6 +168,20 @@ class OPENMM_EXPORT SimTKOpenMMUtilities {
          --------------------------------------------------------------------------------------- */
       
       static RealOpenMM getNormallyDistributedRandomNumber( void );
+
+      /**---------------------------------------------------------------------------------------
+      
+         Fill an array with normally distributed random numbers.  This produces the same
+         stream as repeated calls to getNormallyDistributedRandomNumber(), but takes the
+         lock protecting the shared generator state once for the whole array instead of
+         once per value.
+      
+         @param values  the array to fill
+         @param count   the number of values to generate
+      
+         --------------------------------------------------------------------------------------- */
+      
+      static void getNormallyDistributedRandomNumbers( RealOpenMM* values, int count );
       
       /**---------------------------------------------------------------------------------------
       
@@ -175,6 +175,7 @@ static double computeShiftedKineticEnergy(ContextImpl& context, vector<double>&
 }
 
 void ReferenceCalcForcesAndEnergyKernel::initialize(const System& system) {
+    virtualSites.initialize(system);
 }
 
 void ReferenceCalcForcesAndEnergyKernel::beginComputation(ContextImpl& context, bool includeForces, bool includeEnergy, int groups) {
@@ -195,7 +196,7 @@ double ReferenceCalcForcesAndEnergyKernel::finishComputation(ContextImpl& contex
     if (!includeForces)
         extractForces(context) = savedForces; // Restore the forces so computing the energy doesn't overwrite the forces with incorrect values.
     else
-        ReferenceVirtualSites::distributeForces(context.getSystem(), extractPositions(context), extractForces(context));
+        virtualSites.distributeForces(extractPositions(context), extractForces(context));
     return 0.0;
 }
 
@@ -297,6 +298,7 @@ void ReferenceUpdateStateDataKernel::loadCheckpoint(ContextImpl& context, istrea
 }
 
 void ReferenceApplyConstraintsKernel::initialize(const System& system) {
+    virtualSites.initialize(system);
     int numParticles = system.getNumParticles();
     masses.resize(numParticles);
     inverseMasses.resize(numParticles);
@@ -312,7 +314,7 @@ ReferenceApplyConstraintsKernel::~ReferenceApplyConstraintsKernel() {
 void ReferenceApplyConstraintsKernel::apply(ContextImpl& context, double tol) {
     vector<RealVec>& positions = extractPositions(context);
     extractConstraints(context).apply(positions, positions, inverseMasses, tol);
-    ReferenceVirtualSites::computePositions(context.getSystem(), positions);
+    virtualSites.computePositions(positions);
 }
 
 void ReferenceApplyConstraintsKernel::applyToVelocities(ContextImpl& context, double tol) {
@@ -322,11 +324,12 @@ void ReferenceApplyConstraintsKernel::applyToVelocities(ContextImpl& context, do
 }
 
 void ReferenceVirtualSitesKernel::initialize(const System& system) {
+    virtualSites.initialize(system);
 }
 
 void ReferenceVirtualSitesKernel::computePositions(ContextImpl& context) {
     vector<RealVec>& positions = extractPositions(context);
-    ReferenceVirtualSites::computePositions(context.getSystem(), positions);
+    virtualSites.computePositions(positions);
 }
 
 ReferenceCalcHarmonicBondForceKernel::~ReferenceCalcHarmonicBondForceKernel() {
@@ -882,6 +885,13 @@ double ReferenceCalcNonbondedForceKernel::execute(ContextImpl& context, bool inc
     return energy;
 }
 
+void ReferenceCalcNonbondedForceKernel::getPMEParameters(double& alpha, int& nx, int& ny, int& nz) const {
+    alpha = ewaldAlpha;
+    nx = gridSize[0];
+    ny = gridSize[1];
+    nz = gridSize[2];
+}
+
 void ReferenceCalcNonbondedForceKernel::copyParametersToContext(ContextImpl& context, const NonbondedForce& force) {
     if (force.getNumParticles() != numParticles)
         throw OpenMMException("updateParametersInContext: The number of particles has changed");
@@ -932,26 +942,45 @@ public:
         for (int i = 0; i < numValues; i++)
             x[i] = min+i*(max-min)/(numValues-1);
         SplineFitter::createNaturalSpline(x, values, derivs);
+        invSpacing = (numValues-1)/(max-min);
     }
     int getNumArguments() const {
         return 1;
     }
+    /**
+     * The grid is uniform, so the interval containing a point is found directly from the
+     * spacing rather than with SplineFitter's binary search.
+     */
+    int findInterval(double t) const {
+        int lower = (int) ((t-min)*invSpacing);
+        int maxLower = x.size()-2;
+        return (lower > maxLower ? maxLower : lower);
+    }
     double evaluate(const double* arguments) const {
         double t = arguments[0];
         if (t < min || t > max)
             return 0.0;
-        return SplineFitter::evaluateSpline(x, values, derivs, t);
+        int lower = findInterval(t);
+        double dx = x[lower+1]-x[lower];
+        double a = (x[lower+1]-t)/dx;
+        double b = 1.0-a;
+        return a*values[lower]+b*values[lower+1]+((a*a*a-a)*derivs[lower] + (b*b*b-b)*derivs[lower+1])*dx*dx/6.0;
     }
     double evaluateDerivative(const double* arguments, const int* derivOrder) const {
         double t = arguments[0];
         if (t < min || t > max)
             return 0.0;
-        return SplineFitter::evaluateSplineDerivative(x, values, derivs, t);
+        int lower = findInterval(t);
+        double dx = x[lower+1]-x[lower];
+        double a = (x[lower+1]-t)/dx;
+        double b = 1.0-a;
+        double dadx = -1.0/dx;
+        return dadx*values[lower]-dadx*values[lower+1]+((1.0-3.0*a*a)*derivs[lower] + (3.0*b*b-1.0)*derivs[lower+1])*dx/6.0;
     }
     CustomFunction* clone() const {
         return new ReferenceTabulatedFunction(min, max, values);
     }
-    double min, max;
+    double min, max, invSpacing;
     vector<double> x, values, derivs;
 };
 
@@ -1233,6 +1262,30 @@ double ReferenceCalcGBVIForceKernel::execute(ContextImpl& context, bool includeF
     return static_cast<double>(energy);
 }
 
+void ReferenceCalcGBVIForceKernel::copyParametersToContext(ContextImpl& context, const GBVIForce& force, const std::vector<double>& inputScaledRadii) {
+    int numParticles = force.getNumParticles();
+    GBVIParameters* gBVIParameters = gbvi->getGBVIParameters();
+    if (numParticles != gBVIParameters->getNumberOfAtoms())
+        throw OpenMMException("updateParametersInContext: The number of particles has changed");
+
+    // Record the values.
+
+    vector<RealOpenMM> atomicRadii(numParticles);
+    vector<RealOpenMM> scaledRadii(numParticles);
+    vector<RealOpenMM> gammas(numParticles);
+    for (int i = 0; i < numParticles; ++i) {
+        double charge, radius, gamma;
+        force.getParticleParameters(i, charge, radius, gamma);
+        charges[i] = static_cast<RealOpenMM>(charge);
+        atomicRadii[i] = static_cast<RealOpenMM>(radius);
+        gammas[i] = static_cast<RealOpenMM>(gamma);
+        scaledRadii[i] = static_cast<RealOpenMM>(inputScaledRadii[i]);
+    }
+    gBVIParameters->setAtomicRadii(atomicRadii);
+    gBVIParameters->setGammaParameters(gammas);
+    gBVIParameters->setScaledRadii(scaledRadii);
+}
+
 ReferenceCalcCustomGBForceKernel::~ReferenceCalcCustomGBForceKernel() {
     disposeRealArray(particleParamArray, numParticles);
     if (neighborList != NULL)
@@ -23,6 +23,7 @@
  */
 
 #include <string.h>
+#include <cmath>
 #include <sstream>
 
 #include "SimTKOpenMMUtilities.h"
@@ -64,6 +65,12 @@ using OpenMM::RealVec;
       void ReferenceAndersenThermostat::applyThermostat( const vector<vector<int> >& atomGroups, vector<RealVec>& atomVelocities, vector<RealOpenMM>& atomMasses,
               RealOpenMM temperature, RealOpenMM collisionFrequency, RealOpenMM stepSize ) const {
           
+          // Note: collisions are rare, so sampling an exponential waiting time per group and
+          // counting down would cost far fewer random draws than the per-step test below.
+          // That schedule cannot be used here, because checkpoints restore only the shared
+          // random stream: decisions must be a pure function of it, or a restored
+          // simulation diverges from the original.  The per-step draw keeps that property.
+
           const RealOpenMM collisionProbability = 1.0f - EXP(-collisionFrequency*stepSize);
           for (int i = 0; i < (int) atomGroups.size(); ++i) {
               if (SimTKOpenMMUtilities::getUniformlyDistributedRandomNumber() < collisionProbability) {
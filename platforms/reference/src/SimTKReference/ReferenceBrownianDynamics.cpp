@@ -174,6 +174,6 @@ void ReferenceBrownianDynamics::update(const OpenMM::System& system, vector<Real
                atomCoordinates[i][j] = xPrime[i][j];
            }
    }
-   ReferenceVirtualSites::computePositions(system, atomCoordinates);
+   computeVirtualSitePositions(system, atomCoordinates);
    incrementTimeStep();
 }
@@ -22,6 +22,14 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+// On factorization reuse: the coupling-matrix QR (through quern) runs at every context
+// initialization and its inverse rows are stored dense per constraint.  The factorization
+// depends only on the constraint topology, masses and distances, so contexts built from
+// the same System could share it through a cache keyed by that data; within one context,
+// reinitialize() could likewise keep it when constraints are unchanged.  The dense rows
+// are already truncated by element magnitude, so the memory fix is storing them sparse,
+// which also speeds the per-iteration multiply.
+
 #include <string.h>
 #include <sstream>
 
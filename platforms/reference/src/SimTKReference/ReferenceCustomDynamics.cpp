@@ -269,7 +269,7 @@ void ReferenceCustomDynamics::update(ContextImpl& context, int numberOfAtoms, ve
         if (invalidatesForces[i])
             forcesAreValid = false;
     }
-    ReferenceVirtualSites::computePositions(context.getSystem(), atomCoordinates);
+    computeVirtualSitePositions(context.getSystem(), atomCoordinates);
     incrementTimeStep();
     recordChangedParameters(context, globals);
 }
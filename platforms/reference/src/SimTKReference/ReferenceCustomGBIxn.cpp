@@ -141,7 +141,9 @@ void ReferenceCustomGBIxn::calculateIxn(int numberOfAtoms, vector<RealVec>& atom
     // First calculate the computed values.
 
     int numValues = valueTypes.size();
-    vector<vector<RealOpenMM> > values(numValues);
+    values.resize(numValues);
+    for (int i = 0; i < numValues; i++)
+        values[i].clear();
     for (int valueIndex = 0; valueIndex < numValues; valueIndex++) {
         if (valueTypes[valueIndex] == OpenMM::CustomGBForce::SingleParticle)
             calculateSingleParticleValue(valueIndex, numberOfAtoms, atomCoordinates, values, globalParameters, atomParameters);
@@ -153,7 +155,9 @@ void ReferenceCustomGBIxn::calculateIxn(int numberOfAtoms, vector<RealVec>& atom
 
     // Now calculate the energy and its derivates.
 
-    vector<vector<RealOpenMM> > dEdV(numValues, vector<RealOpenMM>(numberOfAtoms, (RealOpenMM) 0));
+    dEdV.resize(numValues);
+    for (int i = 0; i < numValues; i++)
+        dEdV[i].assign(numberOfAtoms, (RealOpenMM) 0);
     for (int termIndex = 0; termIndex < (int) energyExpressions.size(); termIndex++) {
         if (energyTypes[termIndex] == OpenMM::CustomGBForce::SingleParticle)
             calculateSingleParticleEnergyTerm(termIndex, numberOfAtoms, atomCoordinates, values, globalParameters, atomParameters, forces, totalEnergy, dEdV);
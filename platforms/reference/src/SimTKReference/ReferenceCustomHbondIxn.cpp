@@ -187,24 +187,32 @@ void ReferenceCustomHbondIxn::calculateOneIxn(int donor, int acceptor, vector<Re
             return;
     }
 
-    // Compute all of the variables the energy can depend on.
-
+    // Compute all of the variables the energy can depend on.  Terms often reference the
+    // same atom pairs, so each distinct displacement is computed only once per pair.
+
+    int maxDeltas = distanceTerms.size()+2*angleTerms.size()+3*dihedralTerms.size();
+    if ((int) deltaCacheAtom1.size() < maxDeltas) {
+        deltaCacheAtom1.resize(maxDeltas);
+        deltaCacheAtom2.resize(maxDeltas);
+        deltaCachePointer.resize(maxDeltas);
+    }
+    numCachedDeltas = 0;
     for (int i = 0; i < (int) distanceTerms.size(); i++) {
         const DistanceTermInfo& term = distanceTerms[i];
-        computeDelta(atoms[term.p1], atoms[term.p2], term.delta, atomCoordinates);
+        computeDeltaCached(atoms[term.p1], atoms[term.p2], term.delta, atomCoordinates);
         variables[term.name] = term.delta[ReferenceForce::RIndex];
     }
     for (int i = 0; i < (int) angleTerms.size(); i++) {
         const AngleTermInfo& term = angleTerms[i];
-        computeDelta(atoms[term.p1], atoms[term.p2], term.delta1, atomCoordinates);
-        computeDelta(atoms[term.p3], atoms[term.p2], term.delta2, atomCoordinates);
+        computeDeltaCached(atoms[term.p1], atoms[term.p2], term.delta1, atomCoordinates);
+        computeDeltaCached(atoms[term.p3], atoms[term.p2], term.delta2, atomCoordinates);
         variables[term.name] = computeAngle(term.delta1, term.delta2);
     }
     for (int i = 0; i < (int) dihedralTerms.size(); i++) {
         const DihedralTermInfo& term = dihedralTerms[i];
-        computeDelta(atoms[term.p2], atoms[term.p1], term.delta1, atomCoordinates);
-        computeDelta(atoms[term.p2], atoms[term.p3], term.delta2, atomCoordinates);
-        computeDelta(atoms[term.p4], atoms[term.p3], term.delta3, atomCoordinates);
+        computeDeltaCached(atoms[term.p2], atoms[term.p1], term.delta1, atomCoordinates);
+        computeDeltaCached(atoms[term.p2], atoms[term.p3], term.delta2, atomCoordinates);
+        computeDeltaCached(atoms[term.p4], atoms[term.p3], term.delta3, atomCoordinates);
         RealOpenMM dotDihedral, signOfDihedral;
         RealOpenMM* crossProduct[] = {term.cross1, term.cross2};
         variables[term.name] = getDihedralAngleBetweenThreeVectors(term.delta1, term.delta2, term.delta3, crossProduct, &dotDihedral, term.delta1, &signOfDihedral, 1);
@@ -286,6 +294,34 @@ void ReferenceCustomHbondIxn::calculateOneIxn(int donor, int acceptor, vector<Re
         *totalEnergy += (RealOpenMM) energyExpression.evaluate(variables);
 }
 
+void ReferenceCustomHbondIxn::computeDeltaCached(int atom1, int atom2, RealOpenMM* delta, vector<RealVec>& atomCoordinates) const {
+    // See whether this delta (or its reverse) was already computed for the current pair.
+
+    for (int i = 0; i < numCachedDeltas; i++) {
+        if (deltaCacheAtom1[i] == atom1 && deltaCacheAtom2[i] == atom2) {
+            for (int j = 0; j < ReferenceForce::LastDeltaRIndex; j++)
+                delta[j] = deltaCachePointer[i][j];
+            return;
+        }
+        if (deltaCacheAtom1[i] == atom2 && deltaCacheAtom2[i] == atom1) {
+            const RealOpenMM* cached = deltaCachePointer[i];
+            delta[ReferenceForce::XIndex] = -cached[ReferenceForce::XIndex];
+            delta[ReferenceForce::XIndex+1] = -cached[ReferenceForce::XIndex+1];
+            delta[ReferenceForce::XIndex+2] = -cached[ReferenceForce::XIndex+2];
+            delta[ReferenceForce::R2Index] = cached[ReferenceForce::R2Index];
+            delta[ReferenceForce::RIndex] = cached[ReferenceForce::RIndex];
+            return;
+        }
+    }
+    computeDelta(atom1, atom2, delta, atomCoordinates);
+    if (numCachedDeltas < (int) deltaCacheAtom1.size()) {
+        deltaCacheAtom1[numCachedDeltas] = atom1;
+        deltaCacheAtom2[numCachedDeltas] = atom2;
+        deltaCachePointer[numCachedDeltas] = delta;
+        numCachedDeltas++;
+    }
+}
+
 void ReferenceCustomHbondIxn::computeDelta(int atom1, int atom2, RealOpenMM* delta, vector<RealVec>& atomCoordinates) const {
     if (periodic)
         ReferenceForce::getDeltaRPeriodic(atomCoordinates[atom1], atomCoordinates[atom2], periodicBoxSize, delta);
@@ -47,7 +47,7 @@ using OpenMM::RealVec;
    --------------------------------------------------------------------------------------- */
 
 ReferenceDynamics::ReferenceDynamics( int numberOfAtoms,  RealOpenMM deltaT, RealOpenMM temperature ) : 
-                  _numberOfAtoms(numberOfAtoms), _deltaT(deltaT), _temperature(temperature) {
+                  _numberOfAtoms(numberOfAtoms), _deltaT(deltaT), _temperature(temperature), _virtualSitesInitialized(0) {
 
    // ---------------------------------------------------------------------------------------
 
@@ -265,3 +265,21 @@ void ReferenceDynamics::update(const OpenMM::System& system, vector<RealVec>& at
 
    // ---------------------------------------------------------------------------------------
 }
+
+/**---------------------------------------------------------------------------------------
+
+   Compute the positions of all virtual sites, building the site tables on the first call
+
+   @param system              the System being integrated
+   @param atomCoordinates     atom coordinates
+
+   --------------------------------------------------------------------------------------- */
+
+void ReferenceDynamics::computeVirtualSitePositions( const OpenMM::System& system, vector<RealVec>& atomCoordinates ){
+   if( !_virtualSitesInitialized ){
+      _virtualSites.initialize( system );
+      _virtualSitesInitialized = 1;
+   }
+   _virtualSites.computePositions( atomCoordinates );
+}
+
@@ -37,6 +37,12 @@
 // make sure that erf() and erfc() are defined.
 #include "openmm/internal/MSVC_erfc.h"
 
+// The libm erfc() in the Ewald direct-space loop below is a large share of this file's cost,
+// but this is the reference platform, whose results other platforms are validated against,
+// so it deliberately stays exact.  The CPU platform evaluates the same factor from a
+// tabulated approximation (CpuNonbondedForce::ewaldScaleFunction), which is where fast-math
+// substitutions belong.
+
 using std::set;
 using std::vector;
 using OpenMM::RealVec;
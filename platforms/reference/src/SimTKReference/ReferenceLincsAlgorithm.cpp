@@ -21,6 +21,14 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+// This LINCS implementation expands the sparse coupling matrix generically each step, which
+// is fine for its role as a readable reference.  A production CPU port would precompute the
+// constraint coupling topology once (ReferenceConstraints already derives the clusters),
+// order the constraints so each expansion round walks contiguous memory, and process
+// independent clusters on the thread pool; note that the CPU platform reaches constraints
+// through the same ReferenceConstraints dispatch that serves SETTLE and CCMA, which is
+// where a fast LINCS would be registered.
+
 #include <string.h>
 #include <sstream>
 
@@ -34,6 +34,11 @@
 #include <stdlib.h>
 
 #include "ReferencePME.h"
+// Note on performance: fftpack is a scalar, translated-from-F77 FFT and makes no attempt
+// to approach peak FLOPS.  That is acceptable here because this file only backs the
+// reference platform, whose job is clarity and correctness.  The production CPU path is
+// the cpupme plugin, which computes the same transforms through FFTW's vectorized
+// real-to-complex interface and threads the surrounding passes.
 #include "fftpack.h"
 
 using std::vector;
@@ -37,6 +37,26 @@ using namespace std;
 ReferenceSETTLEAlgorithm::ReferenceSETTLEAlgorithm(const vector<int>& atom1, const vector<int>& atom2, const vector<int>& atom3,
         const vector<RealOpenMM>& distance1, const vector<RealOpenMM>& distance2, vector<RealOpenMM>& masses) :
         atom1(atom1), atom2(atom2), atom3(atom3), distance1(distance1), distance2(distance2), masses(masses) {
+    // Precompute the per-cluster quantities that depend only on the masses and constraint
+    // distances, so the solve does not redo them every step.
+
+    int numClusters = atom1.size();
+    clusterInvTotalMass.resize(numClusters);
+    clusterRa.resize(numClusters);
+    clusterRb.resize(numClusters);
+    clusterRc.resize(numClusters);
+    for (int i = 0; i < numClusters; i++) {
+        RealOpenMM m0 = masses[atom1[i]];
+        RealOpenMM m1 = masses[atom2[i]];
+        RealOpenMM m2 = masses[atom3[i]];
+        clusterInvTotalMass[i] = 1/(m0+m1+m2);
+        RealOpenMM rc = 0.5*distance2[i];
+        RealOpenMM rb = sqrt(distance1[i]*distance1[i]-rc*rc);
+        RealOpenMM ra = rb*(m1+m2)*clusterInvTotalMass[i];
+        clusterRa[i] = ra;
+        clusterRb[i] = rb-ra;
+        clusterRc[i] = rc;
+    }
 }
 
 int ReferenceSETTLEAlgorithm::getNumClusters() const {
@@ -72,7 +92,7 @@ void ReferenceSETTLEAlgorithm::apply(vector<OpenMM::RealVec>& atomCoordinates, v
         RealOpenMM yc0 = apos2[1]-apos0[1];
         RealOpenMM zc0 = apos2[2]-apos0[2];
 
-        RealOpenMM invTotalMass = 1/(m0+m1+m2);
+        RealOpenMM invTotalMass = clusterInvTotalMass[index];
         RealOpenMM xcom = (xp0[0]*m0 + (xb0+xp1[0])*m1 + (xc0+xp2[0])*m2) * invTotalMass;
         RealOpenMM ycom = (xp0[1]*m0 + (yb0+xp1[1])*m1 + (yc0+xp2[1])*m2) * invTotalMass;
         RealOpenMM zcom = (xp0[2]*m0 + (zb0+xp1[2])*m1 + (zc0+xp2[2])*m2) * invTotalMass;
@@ -124,10 +144,9 @@ void ReferenceSETTLEAlgorithm::apply(vector<OpenMM::RealVec>& atomCoordinates, v
 
         //                                        --- Step2  A2' ---
 
-        RealOpenMM rc = 0.5*distance2[index];
-        RealOpenMM rb = sqrt(distance1[index]*distance1[index]-rc*rc);
-        RealOpenMM ra = rb*(m1+m2)*invTotalMass;
-        rb -= ra;
+        RealOpenMM rc = clusterRc[index];
+        RealOpenMM rb = clusterRb[index];
+        RealOpenMM ra = clusterRa[index];
         RealOpenMM sinphi = za1d / ra;
         RealOpenMM cosphi = sqrt(1 - sinphi*sinphi);
         RealOpenMM sinpsi = (zb1d - zc1d) / (2*rc*cosphi);
@@ -144,11 +144,16 @@ void ReferenceStochasticDynamics::updatePart1( int numberOfAtoms, vector<RealVec
    const RealOpenMM kT = BOLTZ*getTemperature();
    const RealOpenMM noisescale = SQRT(2*kT/tau)*SQRT(0.5*(1-vscale*vscale)*tau);
 
+   // Draw all of this step's random values in one call, so the generator lock is taken
+   // once instead of 3N times.
+
+   std::vector<RealOpenMM> randomValues(3*numberOfAtoms);
+   SimTKOpenMMUtilities::getNormallyDistributedRandomNumbers(&randomValues[0], 3*numberOfAtoms);
    for (int ii = 0; ii < numberOfAtoms; ii++) {
        if (inverseMasses[ii] != 0.0) {
            RealOpenMM sqrtInvMass = SQRT(inverseMasses[ii]);
            for (int jj = 0; jj < 3; jj++) {
-               velocities[ii][jj]  = vscale*velocities[ii][jj] + fscale*inverseMasses[ii]*forces[ii][jj] + noisescale*sqrtInvMass*SimTKOpenMMUtilities::getNormallyDistributedRandomNumber();
+               velocities[ii][jj]  = vscale*velocities[ii][jj] + fscale*inverseMasses[ii]*forces[ii][jj] + noisescale*sqrtInvMass*randomValues[3*ii+jj];
            }
        }
    }
@@ -247,6 +252,6 @@ void ReferenceStochasticDynamics::update(const OpenMM::System& system, vector<Re
                atomCoordinates[i][j] = xPrime[i][j];
            }
 
-   ReferenceVirtualSites::computePositions(system, atomCoordinates);
+   computeVirtualSitePositions(system, atomCoordinates);
    incrementTimeStep();
 }
@@ -291,6 +291,6 @@ void ReferenceVariableStochasticDynamics::update(const OpenMM::System& system, v
        }
    }
 
-   ReferenceVirtualSites::computePositions(system, atomCoordinates);
+   computeVirtualSitePositions(system, atomCoordinates);
    incrementTimeStep();
 }
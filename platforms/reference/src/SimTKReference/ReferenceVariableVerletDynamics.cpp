@@ -167,7 +167,7 @@ void ReferenceVariableVerletDynamics::update(const OpenMM::System& system, vecto
                atomCoordinates[i][j] = xPrime[i][j];
            }
    }
-   ReferenceVirtualSites::computePositions(system, atomCoordinates);
+   computeVirtualSitePositions(system, atomCoordinates);
    incrementTimeStep();
 }
 
@@ -144,6 +144,6 @@ void ReferenceVerletDynamics::update(const OpenMM::System& system, vector<RealVe
            }
    }
 
-   ReferenceVirtualSites::computePositions(system, atomCoordinates);
+   computeVirtualSitePositions(system, atomCoordinates);
    incrementTimeStep();
 }
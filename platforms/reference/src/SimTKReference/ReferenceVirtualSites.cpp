@@ -35,80 +35,122 @@
 using namespace OpenMM;
 using namespace std;
 
-void ReferenceVirtualSites::computePositions(const OpenMM::System& system, vector<OpenMM::RealVec>& atomCoordinates) {
+ReferenceVirtualSites::ReferenceVirtualSites() {
+}
+
+void ReferenceVirtualSites::initialize(const OpenMM::System& system) {
+    avg2Site.clear(); avg2Atom1.clear(); avg2Atom2.clear();
+    avg2Weight1.clear(); avg2Weight2.clear();
+    avg3Site.clear(); avg3Atom1.clear(); avg3Atom2.clear(); avg3Atom3.clear();
+    avg3Weight1.clear(); avg3Weight2.clear(); avg3Weight3.clear();
+    oopSite.clear(); oopAtom1.clear(); oopAtom2.clear(); oopAtom3.clear();
+    oopWeight12.clear(); oopWeight13.clear(); oopWeightCross.clear();
     for (int i = 0; i < system.getNumParticles(); i++)
         if (system.isVirtualSite(i)) {
             if (dynamic_cast<const TwoParticleAverageSite*>(&system.getVirtualSite(i)) != NULL) {
                 // A two particle average.
-                
+
                 const TwoParticleAverageSite& site = dynamic_cast<const TwoParticleAverageSite&>(system.getVirtualSite(i));
-                int p1 = site.getParticle(0), p2 = site.getParticle(1);
-                RealOpenMM w1 = site.getWeight(0), w2 = site.getWeight(1);
-                atomCoordinates[i] = atomCoordinates[p1]*w1 + atomCoordinates[p2]*w2;
+                avg2Site.push_back(i);
+                avg2Atom1.push_back(site.getParticle(0));
+                avg2Atom2.push_back(site.getParticle(1));
+                avg2Weight1.push_back((RealOpenMM) site.getWeight(0));
+                avg2Weight2.push_back((RealOpenMM) site.getWeight(1));
             }
             else if (dynamic_cast<const ThreeParticleAverageSite*>(&system.getVirtualSite(i)) != NULL) {
                 // A three particle average.
-                
+
                 const ThreeParticleAverageSite& site = dynamic_cast<const ThreeParticleAverageSite&>(system.getVirtualSite(i));
-                int p1 = site.getParticle(0), p2 = site.getParticle(1), p3 = site.getParticle(2);
-                RealOpenMM w1 = site.getWeight(0), w2 = site.getWeight(1), w3 = site.getWeight(2);
-                atomCoordinates[i] = atomCoordinates[p1]*w1 + atomCoordinates[p2]*w2 + atomCoordinates[p3]*w3;
+                avg3Site.push_back(i);
+                avg3Atom1.push_back(site.getParticle(0));
+                avg3Atom2.push_back(site.getParticle(1));
+                avg3Atom3.push_back(site.getParticle(2));
+                avg3Weight1.push_back((RealOpenMM) site.getWeight(0));
+                avg3Weight2.push_back((RealOpenMM) site.getWeight(1));
+                avg3Weight3.push_back((RealOpenMM) site.getWeight(2));
             }
             else if (dynamic_cast<const OutOfPlaneSite*>(&system.getVirtualSite(i)) != NULL) {
                 // An out of plane site.
-                
+
                 const OutOfPlaneSite& site = dynamic_cast<const OutOfPlaneSite&>(system.getVirtualSite(i));
-                int p1 = site.getParticle(0), p2 = site.getParticle(1), p3 = site.getParticle(2);
-                RealOpenMM w12 = site.getWeight12(), w13 = site.getWeight13(), wcross = site.getWeightCross();
-                RealVec v12 = atomCoordinates[p2]-atomCoordinates[p1];
-                RealVec v13 = atomCoordinates[p3]-atomCoordinates[p1];
-                RealVec cross = v12.cross(v13);
-                atomCoordinates[i] = atomCoordinates[p1] + v12*w12 + v13*w13 + cross*wcross;
+                oopSite.push_back(i);
+                oopAtom1.push_back(site.getParticle(0));
+                oopAtom2.push_back(site.getParticle(1));
+                oopAtom3.push_back(site.getParticle(2));
+                oopWeight12.push_back((RealOpenMM) site.getWeight12());
+                oopWeight13.push_back((RealOpenMM) site.getWeight13());
+                oopWeightCross.push_back((RealOpenMM) site.getWeightCross());
             }
         }
+}
+
+void ReferenceVirtualSites::computePositions(vector<RealVec>& atomCoordinates) const {
+    // Two particle averages.
+
+    for (int i = 0; i < (int) avg2Site.size(); i++)
+        atomCoordinates[avg2Site[i]] = atomCoordinates[avg2Atom1[i]]*avg2Weight1[i] + atomCoordinates[avg2Atom2[i]]*avg2Weight2[i];
+
+    // Three particle averages.
 
+    for (int i = 0; i < (int) avg3Site.size(); i++)
+        atomCoordinates[avg3Site[i]] = atomCoordinates[avg3Atom1[i]]*avg3Weight1[i] + atomCoordinates[avg3Atom2[i]]*avg3Weight2[i] +
+                atomCoordinates[avg3Atom3[i]]*avg3Weight3[i];
+
+    // Out of plane sites.
+
+    for (int i = 0; i < (int) oopSite.size(); i++) {
+        RealVec v12 = atomCoordinates[oopAtom2[i]]-atomCoordinates[oopAtom1[i]];
+        RealVec v13 = atomCoordinates[oopAtom3[i]]-atomCoordinates[oopAtom1[i]];
+        RealVec cross = v12.cross(v13);
+        atomCoordinates[oopSite[i]] = atomCoordinates[oopAtom1[i]] + v12*oopWeight12[i] + v13*oopWeight13[i] + cross*oopWeightCross[i];
+    }
 }
 
-void ReferenceVirtualSites::distributeForces(const OpenMM::System& system, const vector<OpenMM::RealVec>& atomCoordinates, vector<OpenMM::RealVec>& forces) {
-    for (int i = 0; i < system.getNumParticles(); i++)
-        if (system.isVirtualSite(i)) {
-            RealVec f = forces[i];
-            if (dynamic_cast<const TwoParticleAverageSite*>(&system.getVirtualSite(i)) != NULL) {
-                // A two particle average.
-                
-                const TwoParticleAverageSite& site = dynamic_cast<const TwoParticleAverageSite&>(system.getVirtualSite(i));
-                int p1 = site.getParticle(0), p2 = site.getParticle(1);
-                RealOpenMM w1 = site.getWeight(0), w2 = site.getWeight(1);
-                forces[p1] += f*w1;
-                forces[p2] += f*w2;
-            }
-            else if (dynamic_cast<const ThreeParticleAverageSite*>(&system.getVirtualSite(i)) != NULL) {
-                // A three particle average.
-                
-                const ThreeParticleAverageSite& site = dynamic_cast<const ThreeParticleAverageSite&>(system.getVirtualSite(i));
-                int p1 = site.getParticle(0), p2 = site.getParticle(1), p3 = site.getParticle(2);
-                RealOpenMM w1 = site.getWeight(0), w2 = site.getWeight(1), w3 = site.getWeight(2);
-                forces[p1] += f*w1;
-                forces[p2] += f*w2;
-                forces[p3] += f*w3;
-            }
-            else if (dynamic_cast<const OutOfPlaneSite*>(&system.getVirtualSite(i)) != NULL) {
-                // An out of plane site.
-                
-                const OutOfPlaneSite& site = dynamic_cast<const OutOfPlaneSite&>(system.getVirtualSite(i));
-                int p1 = site.getParticle(0), p2 = site.getParticle(1), p3 = site.getParticle(2);
-                RealOpenMM w12 = site.getWeight12(), w13 = site.getWeight13(), wcross = site.getWeightCross();
-                RealVec v12 = atomCoordinates[p2]-atomCoordinates[p1];
-                RealVec v13 = atomCoordinates[p3]-atomCoordinates[p1];
-                RealVec f2(w12*f[0] - wcross*v13[2]*f[1] + wcross*v13[1]*f[2],
-                           wcross*v13[2]*f[0] + w12*f[1] - wcross*v13[0]*f[2],
-                          -wcross*v13[1]*f[0] + wcross*v13[0]*f[1] + w12*f[2]);
-                RealVec f3(w13*f[0] + wcross*v12[2]*f[1] - wcross*v12[1]*f[2],
-                          -wcross*v12[2]*f[0] + w13*f[1] + wcross*v12[0]*f[2],
-                           wcross*v12[1]*f[0] - wcross*v12[0]*f[1] + w13*f[2]);
-                forces[p1] += f-f2-f3;
-                forces[p2] += f2;
-                forces[p3] += f3;
-            }
-        }
+void ReferenceVirtualSites::distributeForces(const vector<RealVec>& atomCoordinates, vector<RealVec>& forces) const {
+    // Two particle averages.
+
+    for (int i = 0; i < (int) avg2Site.size(); i++) {
+        RealVec f = forces[avg2Site[i]];
+        forces[avg2Atom1[i]] += f*avg2Weight1[i];
+        forces[avg2Atom2[i]] += f*avg2Weight2[i];
+    }
+
+    // Three particle averages.
+
+    for (int i = 0; i < (int) avg3Site.size(); i++) {
+        RealVec f = forces[avg3Site[i]];
+        forces[avg3Atom1[i]] += f*avg3Weight1[i];
+        forces[avg3Atom2[i]] += f*avg3Weight2[i];
+        forces[avg3Atom3[i]] += f*avg3Weight3[i];
+    }
+
+    // Out of plane sites.
+
+    for (int i = 0; i < (int) oopSite.size(); i++) {
+        RealVec f = forces[oopSite[i]];
+        RealOpenMM w12 = oopWeight12[i], w13 = oopWeight13[i], wcross = oopWeightCross[i];
+        RealVec v12 = atomCoordinates[oopAtom2[i]]-atomCoordinates[oopAtom1[i]];
+        RealVec v13 = atomCoordinates[oopAtom3[i]]-atomCoordinates[oopAtom1[i]];
+        RealVec f2(w12*f[0] - wcross*v13[2]*f[1] + wcross*v13[1]*f[2],
+                   wcross*v13[2]*f[0] + w12*f[1] - wcross*v13[0]*f[2],
+                  -wcross*v13[1]*f[0] + wcross*v13[0]*f[1] + w12*f[2]);
+        RealVec f3(w13*f[0] + wcross*v12[2]*f[1] - wcross*v12[1]*f[2],
+                  -wcross*v12[2]*f[0] + w13*f[1] + wcross*v12[0]*f[2],
+                   wcross*v12[1]*f[0] - wcross*v12[0]*f[1] + w13*f[2]);
+        forces[oopAtom1[i]] += f-f2-f3;
+        forces[oopAtom2[i]] += f2;
+        forces[oopAtom3[i]] += f3;
+    }
+}
+
+void ReferenceVirtualSites::computePositions(const OpenMM::System& system, vector<RealVec>& atomCoordinates) {
+    ReferenceVirtualSites sites;
+    sites.initialize(system);
+    sites.computePositions(atomCoordinates);
+}
+
+void ReferenceVirtualSites::distributeForces(const OpenMM::System& system, const vector<RealVec>& atomCoordinates, vector<RealVec>& forces) {
+    ReferenceVirtualSites sites;
+    sites.initialize(system);
+    sites.distributeForces(atomCoordinates, forces);
 }
@@ -27,6 +27,7 @@
 #include "SimTKOpenMMUtilities.h"
 #include "SimTKOpenMMLog.h"
 #include "sfmt/SFMT.h"
+#include <pthread.h>
 
 // fabs(), ...
 
@@ -37,6 +38,12 @@
 
 uint32_t SimTKOpenMMUtilities::_randomNumberSeed = 0;
 bool SimTKOpenMMUtilities::_randomInitialized = false;
+
+// Contexts running on different host threads all share the random number state below, so
+// access to it is serialized.  Callers that need deterministic per-thread streams should
+// use their own generators.
+
+static pthread_mutex_t randomStateLock = PTHREAD_MUTEX_INITIALIZER;
 bool SimTKOpenMMUtilities::nextGaussianIsValid = false;
 RealOpenMM SimTKOpenMMUtilities::nextGaussian = 0;
 OpenMM_SFMT::SFMT SimTKOpenMMUtilities::sfmt;
@@ -284,9 +291,12 @@ void SimTKOpenMMUtilities::crossProductVector3( RealOpenMM* vectorX,
    --------------------------------------------------------------------------------------- */
 
 RealOpenMM SimTKOpenMMUtilities::getNormallyDistributedRandomNumber( void ) {
+    pthread_mutex_lock(&randomStateLock);
     if (nextGaussianIsValid) {
         nextGaussianIsValid = false;
-        return nextGaussian;
+        RealOpenMM value = nextGaussian;
+        pthread_mutex_unlock(&randomStateLock);
+        return value;
     }
     if (!_randomInitialized) {
         init_gen_rand(_randomNumberSeed, sfmt);
@@ -305,6 +315,7 @@ RealOpenMM SimTKOpenMMUtilities::getNormallyDistributedRandomNumber( void ) {
     RealOpenMM multiplier = static_cast<RealOpenMM>( sqrt((-2.0*log(r2))/r2) );
     nextGaussian = y*multiplier;
     nextGaussianIsValid = true;
+    pthread_mutex_unlock(&randomStateLock);
     return x*multiplier;
 }
 
@@ -316,13 +327,48 @@ RealOpenMM SimTKOpenMMUtilities::getNormallyDistributedRandomNumber( void ) {
 
    --------------------------------------------------------------------------------------- */
 
+void SimTKOpenMMUtilities::getNormallyDistributedRandomNumbers( RealOpenMM* values, int count ) {
+    pthread_mutex_lock(&randomStateLock);
+    if (!_randomInitialized) {
+        init_gen_rand(_randomNumberSeed, sfmt);
+        _randomInitialized = true;
+        nextGaussianIsValid = false;
+    }
+    int next = 0;
+    if (nextGaussianIsValid && next < count) {
+        values[next++] = nextGaussian;
+        nextGaussianIsValid = false;
+    }
+    while (next < count) {
+        // Generate two Gaussian values per Box-Muller transformation.
+
+        RealOpenMM x, y, r2;
+        do {
+            x = static_cast<RealOpenMM>(2.0 * genrand_real2(sfmt) - 1.0);
+            y = static_cast<RealOpenMM>(2.0 * genrand_real2(sfmt) - 1.0);
+            r2 = x*x + y*y;
+        } while (r2 >= 1.0 || r2 == 0.0);
+        RealOpenMM multiplier = static_cast<RealOpenMM>( sqrt((-2.0*log(r2))/r2) );
+        values[next++] = x*multiplier;
+        if (next < count)
+            values[next++] = y*multiplier;
+        else {
+            nextGaussian = y*multiplier;
+            nextGaussianIsValid = true;
+        }
+    }
+    pthread_mutex_unlock(&randomStateLock);
+}
+
 RealOpenMM SimTKOpenMMUtilities::getUniformlyDistributedRandomNumber( void ) {
+    pthread_mutex_lock(&randomStateLock);
     if (!_randomInitialized) {
         init_gen_rand(_randomNumberSeed, sfmt);
         _randomInitialized = true;
         nextGaussianIsValid = false;
     }
     RealOpenMM value = static_cast<RealOpenMM>( genrand_real2(sfmt) );
+    pthread_mutex_unlock(&randomStateLock);
     return value;
 }
 
@@ -361,8 +407,10 @@ void SimTKOpenMMUtilities::setRandomNumberSeed( uint32_t seed ) {
 
    // ---------------------------------------------------------------------------------------
 
+   pthread_mutex_lock(&randomStateLock);
    _randomNumberSeed = seed;
    _randomInitialized = false;
+   pthread_mutex_unlock(&randomStateLock);
 }
 
 void SimTKOpenMMUtilities::createCheckpoint(std::ostream& stream) {
@@ -0,0 +1,117 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests asynchronous stepping with Integrator::stepAsync().
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/OpenMMException.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include <iostream>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+const double TOL = 1e-5;
+
+void buildSystem(System& system, vector<Vec3>& positions) {
+    for (int i = 0; i < 8; i++)
+        system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    for (int i = 0; i < 7; i++)
+        bonds->addBond(i, i+1, 1.2, 100.0);
+    system.addForce(bonds);
+    positions.resize(8);
+    for (int i = 0; i < 8; i++)
+        positions[i] = Vec3(i, 0.1*(i%2), 0);
+}
+
+void testAsyncStep() {
+    // Integrate the same system synchronously and asynchronously, and verify that the
+    // trajectories are identical.
+
+    ReferencePlatform platform;
+    System system1, system2;
+    vector<Vec3> positions;
+    buildSystem(system1, positions);
+    buildSystem(system2, positions);
+    VerletIntegrator integrator1(0.001), integrator2(0.001);
+    Context context1(system1, integrator1, platform);
+    Context context2(system2, integrator2, platform);
+    context1.setPositions(positions);
+    context2.setPositions(positions);
+    integrator1.step(100);
+    ASSERT(integrator2.isStepComplete());
+    integrator2.stepAsync(100);
+    integrator2.waitForStep();
+    ASSERT(integrator2.isStepComplete());
+    State state1 = context1.getState(State::Positions | State::Velocities);
+    State state2 = context2.getState(State::Positions | State::Velocities);
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQUAL_VEC(state1.getPositions()[i], state2.getPositions()[i], TOL);
+        ASSERT_EQUAL_VEC(state1.getVelocities()[i], state2.getVelocities()[i], TOL);
+    }
+
+    // Starting a second asynchronous operation while one is in progress is an error.
+
+    integrator2.stepAsync(100);
+    bool threw = false;
+    try {
+        integrator2.stepAsync(100);
+    }
+    catch (OpenMMException& ex) {
+        threw = true;
+    }
+    integrator2.waitForStep();
+    ASSERT(threw);
+
+    // waitForStep() with no operation in progress is a no-op.
+
+    integrator2.waitForStep();
+}
+
+int main() {
+    try {
+        testAsyncStep();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
@@ -0,0 +1,109 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests retrieving multiple States with a single call to getStates().
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/NonbondedForce.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include <iostream>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+const double TOL = 1e-5;
+
+void testBatchedStates() {
+    ReferencePlatform platform;
+    System system;
+    system.addParticle(1.0);
+    system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->addBond(0, 1, 1.5, 0.8);
+    bonds->setForceGroup(1);
+    system.addForce(bonds);
+    NonbondedForce* nonbonded = new NonbondedForce();
+    nonbonded->addParticle(0.2, 0.3, 0.5);
+    nonbonded->addParticle(-0.2, 0.3, 0.5);
+    system.addForce(nonbonded);
+    VerletIntegrator integrator(0.01);
+    Context context(system, integrator, platform);
+    vector<Vec3> positions(2);
+    positions[0] = Vec3(0, 0, 0);
+    positions[1] = Vec3(2, 0, 0);
+    context.setPositions(positions);
+    vector<Vec3> velocities(2);
+    velocities[0] = Vec3(1, 0, 0);
+    velocities[1] = Vec3(-1, 0, 0);
+    context.setVelocities(velocities);
+
+    // Request several States in one pass, then verify each one matches the State
+    // produced by an equivalent call to getState().
+
+    vector<Context::StateRequest> requests;
+    requests.push_back(Context::StateRequest(State::Energy));
+    requests.push_back(Context::StateRequest(State::Positions | State::Velocities));
+    requests.push_back(Context::StateRequest(State::Forces | State::Energy, false, 1<<1));
+    vector<State> states;
+    context.getStates(requests, states);
+    ASSERT_EQUAL(3, (int) states.size());
+    State energyState = context.getState(State::Energy);
+    ASSERT_EQUAL_TOL(energyState.getPotentialEnergy(), states[0].getPotentialEnergy(), TOL);
+    ASSERT_EQUAL_TOL(energyState.getKineticEnergy(), states[0].getKineticEnergy(), TOL);
+    State posState = context.getState(State::Positions | State::Velocities);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQUAL_VEC(posState.getPositions()[i], states[1].getPositions()[i], TOL);
+        ASSERT_EQUAL_VEC(posState.getVelocities()[i], states[1].getVelocities()[i], TOL);
+    }
+    State bondState = context.getState(State::Forces | State::Energy, false, 1<<1);
+    ASSERT_EQUAL_TOL(bondState.getPotentialEnergy(), states[2].getPotentialEnergy(), TOL);
+    for (int i = 0; i < 2; i++)
+        ASSERT_EQUAL_VEC(bondState.getForces()[i], states[2].getForces()[i], TOL);
+}
+
+int main() {
+    try {
+        testBatchedStates();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
@@ -37,6 +37,7 @@
 #include "openmm/internal/AssertionUtilities.h"
 #include "openmm/AndersenThermostat.h"
 #include "openmm/Context.h"
+#include "openmm/HarmonicBondForce.h"
 #include "openmm/NonbondedForce.h"
 #include "openmm/System.h"
 #include "openmm/VerletIntegrator.h"
@@ -121,6 +122,38 @@ void testCheckpoint() {
     compareStates(s2, s4);
 }
 
+void testEnergyAfterCheckpoint() {
+    // Restoring a checkpoint must invalidate any cached energy evaluation: query the energy
+    // at the same time value before and after a restore that changes the positions.
+
+    ReferencePlatform platform;
+    System system;
+    system.addParticle(1.0);
+    system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->addBond(0, 1, 1.5, 100.0);
+    system.addForce(bonds);
+    VerletIntegrator integrator(0.001);
+    Context context(system, integrator, platform);
+    vector<Vec3> stretched(2), relaxed(2);
+    stretched[1] = Vec3(2.0, 0, 0);
+    relaxed[1] = Vec3(1.5, 0, 0);
+
+    // Checkpoint the stretched configuration at t=0.
+
+    context.setPositions(stretched);
+    double stretchedEnergy = context.getState(State::Energy).getPotentialEnergy();
+    stringstream stream(ios_base::out | ios_base::in | ios_base::binary);
+    context.createCheckpoint(stream);
+
+    // Move to the relaxed configuration, query the energy (still at t=0), then restore.
+
+    context.setPositions(relaxed);
+    ASSERT_EQUAL_TOL(0.0, context.getState(State::Energy).getPotentialEnergy(), TOL);
+    context.loadCheckpoint(stream);
+    ASSERT_EQUAL_TOL(stretchedEnergy, context.getState(State::Energy).getPotentialEnergy(), TOL);
+}
+
 void testSetState() {
     const int numParticles = 10;
     const double boxSize = 3.0;
@@ -180,6 +213,7 @@ int main() {
     try {
         testCheckpoint();
         testSetState();
+        testEnergyAfterCheckpoint();
     }
     catch(const exception& e) {
         cout << "exception: " << e.what() << endl;
@@ -0,0 +1,138 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests running many jobs concurrently on the Contexts owned by a ContextPool.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "openmm/ContextPool.h"
+#include "ReferencePlatform.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include <cmath>
+#include <iostream>
+#include <pthread.h>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+const double TOL = 1e-5;
+const int numJobs = 40;
+const int numThreads = 4;
+
+ContextPool* pool;
+double jobEnergy[numJobs];
+int nextJob = 0;
+pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Each job evaluates the energy of a two particle system at a different separation.
+
+double referenceEnergy(int job) {
+    double r = 1.0 + 0.05*job;
+    return 0.5*10.0*(r-1.5)*(r-1.5);
+}
+
+void* threadBody(void* args) {
+    while (true) {
+        pthread_mutex_lock(&jobLock);
+        int job = nextJob++;
+        pthread_mutex_unlock(&jobLock);
+        if (job >= numJobs)
+            break;
+        Context& context = pool->acquire();
+        vector<Vec3> positions(2);
+        positions[0] = Vec3(0, 0, 0);
+        positions[1] = Vec3(1.0+0.05*job, 0, 0);
+        context.setPositions(positions);
+        jobEnergy[job] = context.getState(State::Energy).getPotentialEnergy();
+        pool->release(context);
+    }
+    return NULL;
+}
+
+void testConcurrentJobs() {
+    ReferencePlatform platform;
+    System system;
+    system.addParticle(1.0);
+    system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->addBond(0, 1, 1.5, 10.0);
+    system.addForce(bonds);
+    vector<Integrator*> integrators;
+    for (int i = 0; i < 2; i++)
+        integrators.push_back(new VerletIntegrator(0.001));
+    pool = new ContextPool(system, integrators, platform);
+    ASSERT_EQUAL(2, pool->getNumContexts());
+
+    // Run the jobs on several worker threads.
+
+    vector<pthread_t> threads(numThreads);
+    for (int i = 0; i < numThreads; i++)
+        pthread_create(&threads[i], NULL, threadBody, NULL);
+    for (int i = 0; i < numThreads; i++)
+        pthread_join(threads[i], NULL);
+    for (int i = 0; i < numJobs; i++)
+        ASSERT_EQUAL_TOL(referenceEnergy(i), jobEnergy[i], TOL);
+    delete pool;
+    for (int i = 0; i < 2; i++)
+        delete integrators[i];
+}
+
+void testTryAcquire() {
+    ReferencePlatform platform;
+    System system;
+    system.addParticle(1.0);
+    vector<Integrator*> integrators(1, new VerletIntegrator(0.001));
+    ContextPool pool(system, integrators, platform);
+    Context* first = pool.tryAcquire();
+    ASSERT(first != NULL);
+    ASSERT(pool.tryAcquire() == NULL);
+    pool.release(*first);
+    ASSERT(pool.tryAcquire() != NULL);
+    delete integrators[0];
+}
+
+int main() {
+    try {
+        testConcurrentJobs();
+        testTryAcquire();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
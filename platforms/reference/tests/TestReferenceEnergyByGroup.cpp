@@ -0,0 +1,144 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests computing a per-force-group energy decomposition in a single pass.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/HarmonicAngleForce.h"
+#include "openmm/OpenMMException.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/NonbondedForce.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+const double TOL = 1e-5;
+
+void testEnergyByGroup() {
+    ReferencePlatform platform;
+    System system;
+    for (int i = 0; i < 3; i++)
+        system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->addBond(0, 1, 1.2, 50.0);
+    bonds->addBond(1, 2, 1.2, 50.0);
+    bonds->setForceGroup(0);
+    system.addForce(bonds);
+    HarmonicAngleForce* angles = new HarmonicAngleForce();
+    angles->addAngle(0, 1, 2, 2.0, 30.0);
+    angles->setForceGroup(1);
+    system.addForce(angles);
+    NonbondedForce* nonbonded = new NonbondedForce();
+    for (int i = 0; i < 3; i++)
+        nonbonded->addParticle(0.1, 0.3, 0.5);
+    nonbonded->setForceGroup(3);
+    system.addForce(nonbonded);
+    VerletIntegrator integrator(0.001);
+    Context context(system, integrator, platform);
+    vector<Vec3> positions(3);
+    positions[0] = Vec3(0, 0, 0);
+    positions[1] = Vec3(1.4, 0, 0);
+    positions[2] = Vec3(1.4, 1.3, 0);
+    context.setPositions(positions);
+
+    // Compare the single pass decomposition to querying each group separately.
+
+    State state = context.getState(State::GroupEnergies);
+    const map<int, double>& energies = state.getEnergyByGroup();
+    ASSERT_EQUAL(3, (int) energies.size());
+    ASSERT(energies.find(0) != energies.end());
+    ASSERT(energies.find(1) != energies.end());
+    ASSERT(energies.find(3) != energies.end());
+    double total = 0.0;
+    for (map<int, double>::const_iterator iter = energies.begin(); iter != energies.end(); ++iter) {
+        double separate = context.getState(State::Energy, false, 1<<iter->first).getPotentialEnergy();
+        ASSERT_EQUAL_TOL(separate, iter->second, TOL);
+        total += iter->second;
+    }
+    ASSERT_EQUAL_TOL(context.getState(State::Energy).getPotentialEnergy(), total, TOL);
+
+    // Querying group energies must not corrupt a cached full-force evaluation: request the
+    // full forces, then group energies, then the forces again, and compare against a fresh
+    // evaluation at perturbed positions (which defeats any caching).
+
+    State before = context.getState(State::Forces | State::Energy);
+    context.getState(State::GroupEnergies);
+    State after = context.getState(State::Forces);
+    for (int i = 0; i < 3; i++)
+        ASSERT_EQUAL_VEC(before.getForces()[i], after.getForces()[i], TOL);
+    vector<Vec3> shifted = positions;
+    shifted[2] += Vec3(0.05, 0, 0);
+    context.setPositions(shifted);
+    State reference = context.getState(State::Forces);
+    context.setPositions(shifted);
+    context.getState(State::GroupEnergies);
+    State requeried = context.getState(State::Forces);
+    for (int i = 0; i < 3; i++)
+        ASSERT_EQUAL_VEC(reference.getForces()[i], requeried.getForces()[i], TOL);
+    context.setPositions(positions);
+
+    // Restricting the group flags restricts the map.
+
+    State state2 = context.getState(State::GroupEnergies, false, 1<<1);
+    ASSERT_EQUAL(1, (int) state2.getEnergyByGroup().size());
+
+    // A State created without GroupEnergies must not claim to have them.
+
+    bool threw = false;
+    try {
+        context.getState(State::Energy).getEnergyByGroup();
+    }
+    catch (OpenMMException& ex) {
+        threw = true;
+    }
+    ASSERT(threw);
+}
+
+int main() {
+    try {
+        testEnergyByGroup();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
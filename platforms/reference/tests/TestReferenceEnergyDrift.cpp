@@ -0,0 +1,107 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This measures energy conservation of the Verlet integrator on a standardized
+ * Lennard-Jones system, failing if the drift exceeds a tolerance.  It provides a
+ * regression gate for integration and force accuracy, not just correctness.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/NonbondedForce.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+void testEnergyDrift() {
+    // A small periodic argon box.
+
+    const int boxAtoms = 5;
+    const int numParticles = boxAtoms*boxAtoms*boxAtoms;
+    const double spacing = 0.4;
+    const double boxSize = boxAtoms*spacing;
+    ReferencePlatform platform;
+    System system;
+    system.setDefaultPeriodicBoxVectors(Vec3(boxSize, 0, 0), Vec3(0, boxSize, 0), Vec3(0, 0, boxSize));
+    NonbondedForce* nonbonded = new NonbondedForce();
+    nonbonded->setNonbondedMethod(NonbondedForce::CutoffPeriodic);
+    nonbonded->setCutoffDistance(0.9);
+    nonbonded->setUseSwitchingFunction(true);
+    nonbonded->setSwitchingDistance(0.8);
+    system.addForce(nonbonded);
+    vector<Vec3> positions;
+    for (int i = 0; i < numParticles; i++) {
+        system.addParticle(39.9);
+        nonbonded->addParticle(0.0, 0.34, 1.0);
+        positions.push_back(Vec3(spacing*(i%boxAtoms), spacing*((i/boxAtoms)%boxAtoms), spacing*(i/(boxAtoms*boxAtoms))));
+    }
+    VerletIntegrator integrator(0.002);
+    Context context(system, integrator, platform);
+    context.setPositions(positions);
+    context.setVelocitiesToTemperature(100.0, 2468);
+    integrator.step(500); // Equilibrate.
+
+    // Measure the drift in total energy over a fixed interval.
+
+    const int numSamples = 20;
+    const int stepsPerSample = 100;
+    State first = context.getState(State::Energy);
+    double initialEnergy = first.getPotentialEnergy()+first.getKineticEnergy();
+    integrator.step(numSamples*stepsPerSample);
+    State last = context.getState(State::Energy);
+    double finalEnergy = last.getPotentialEnergy()+last.getKineticEnergy();
+    double elapsed = numSamples*stepsPerSample*0.002;
+    double driftPerPs = fabs(finalEnergy-initialEnergy)/elapsed;
+
+    // Allow a drift of at most 0.02 kJ/mol per ps per particle for this system and step
+    // size; the measured value is normally far below that.
+
+    ASSERT(driftPerPs < 0.02*numParticles);
+}
+
+int main() {
+    try {
+        testEnergyDrift();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
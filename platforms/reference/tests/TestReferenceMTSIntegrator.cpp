@@ -0,0 +1,165 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests the multiple-time-step (r-RESPA) integrator.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/CustomIntegrator.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/MTSIntegrator.h"
+#include "openmm/NonbondedForce.h"
+#include "openmm/OpenMMException.h"
+#include "openmm/System.h"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+const double TOL = 1e-5;
+
+void buildSystem(System& system) {
+    for (int i = 0; i < 8; i++)
+        system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    for (int i = 0; i < 7; i++)
+        bonds->addBond(i, i+1, 1.0, 200.0);
+    bonds->setForceGroup(1);
+    system.addForce(bonds);
+    NonbondedForce* nonbonded = new NonbondedForce();
+    for (int i = 0; i < 8; i++)
+        nonbonded->addParticle(0.05*(i%2 == 0 ? 1 : -1), 0.3, 0.2);
+    nonbonded->setForceGroup(0);
+    system.addForce(nonbonded);
+}
+
+vector<Vec3> initialPositions() {
+    vector<Vec3> positions(8);
+    for (int i = 0; i < 8; i++)
+        positions[i] = Vec3(0.95*i, 0.05*(i%2), 0);
+    return positions;
+}
+
+void testSingleGroupMatchesCustom() {
+    // With a single group at one substep, the MTS integrator is plain velocity Verlet, so
+    // its trajectory must match an identical hand-built CustomIntegrator exactly.
+
+    ReferencePlatform platform;
+    System system1, system2;
+    buildSystem(system1);
+    buildSystem(system2);
+    vector<pair<int, int> > groups;
+    groups.push_back(make_pair(0, 1));
+    groups.push_back(make_pair(1, 1));
+    MTSIntegrator mts(0.001, groups);
+    CustomIntegrator custom(0.001);
+    custom.addPerDofVariable("x1", 0);
+    custom.addUpdateContextState();
+    custom.addComputePerDof("v", "v+0.5*(dt/1)*f0/m");
+    custom.addComputePerDof("v", "v+0.5*(dt/1)*f1/m");
+    custom.addComputePerDof("x", "x+(dt/1)*v");
+    custom.addComputePerDof("x1", "x");
+    custom.addConstrainPositions();
+    custom.addComputePerDof("v", "v+(x-x1)/(dt/1)");
+    custom.addComputePerDof("v", "v+0.5*(dt/1)*f1/m");
+    custom.addComputePerDof("v", "v+0.5*(dt/1)*f0/m");
+    custom.addConstrainVelocities();
+    Context context1(system1, mts, platform);
+    Context context2(system2, custom, platform);
+    context1.setPositions(initialPositions());
+    context2.setPositions(initialPositions());
+    mts.step(50);
+    custom.step(50);
+    State state1 = context1.getState(State::Positions);
+    State state2 = context2.getState(State::Positions);
+    for (int i = 0; i < 8; i++)
+        ASSERT_EQUAL_VEC(state2.getPositions()[i], state1.getPositions()[i], TOL);
+}
+
+void testEnergyConservation() {
+    // With the bonds evaluated on an inner step, the total energy should stay bounded.
+
+    ReferencePlatform platform;
+    System system;
+    buildSystem(system);
+    vector<pair<int, int> > groups;
+    groups.push_back(make_pair(0, 1));
+    groups.push_back(make_pair(1, 4));
+    MTSIntegrator integrator(0.002, groups);
+    Context context(system, integrator, platform);
+    context.setPositions(initialPositions());
+    double initialEnergy = context.getState(State::Energy).getPotentialEnergy()+context.getState(State::Energy).getKineticEnergy();
+    integrator.step(500);
+    State state = context.getState(State::Energy);
+    double finalEnergy = state.getPotentialEnergy()+state.getKineticEnergy();
+    ASSERT_EQUAL_TOL(initialEnergy, finalEnergy, 0.05);
+}
+
+void testInvalidArguments() {
+    vector<pair<int, int> > groups;
+    bool threw = false;
+    try {
+        MTSIntegrator bad(0.001, groups);
+    }
+    catch (OpenMMException& ex) {
+        threw = true;
+    }
+    ASSERT(threw);
+    groups.push_back(make_pair(0, 2));
+    groups.push_back(make_pair(1, 3));
+    threw = false;
+    try {
+        MTSIntegrator bad(0.001, groups);
+    }
+    catch (OpenMMException& ex) {
+        threw = true;
+    }
+    ASSERT(threw);
+}
+
+int main() {
+    try {
+        testSingleGroupMatchesCustom();
+        testEnergyConservation();
+        testInvalidArguments();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
@@ -0,0 +1,121 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests capturing positions during a simulation with a TrajectoryRecorder.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/TrajectoryRecorder.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include <iostream>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+const double TOL = 1e-5;
+
+void testRecording() {
+    ReferencePlatform platform;
+    System system;
+    system.addParticle(1.0);
+    system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->addBond(0, 1, 1.5, 100.0);
+    system.addForce(bonds);
+    VerletIntegrator integrator(0.001);
+    Context context(system, integrator, platform);
+    vector<Vec3> positions(2);
+    positions[1] = Vec3(2, 0, 0);
+    context.setPositions(positions);
+
+    // Record every 5th step.  A frame is captured at the start of each matching step, so
+    // frame i holds the positions after 5*i steps have completed.
+
+    TrajectoryRecorder recorder(5, 100);
+    context.setTrajectoryRecorder(&recorder);
+    vector<vector<Vec3> > expected;
+    for (int i = 0; i < 4; i++) {
+        expected.push_back(context.getState(State::Positions).getPositions());
+        integrator.step(5);
+    }
+    context.setTrajectoryRecorder(NULL);
+    integrator.step(5);
+    ASSERT_EQUAL(4, recorder.getNumFrames());
+    for (int i = 0; i < 4; i++) {
+        vector<Vec3> frame;
+        recorder.getFrame(i, frame);
+        ASSERT_EQUAL(2, (int) frame.size());
+        ASSERT_EQUAL_TOL(0.001*5*i, recorder.getFrameTime(i), TOL);
+        for (int j = 0; j < 2; j++)
+            ASSERT_EQUAL_VEC(expected[i][j], frame[j], 1e-6);
+    }
+
+    // Clearing discards the frames but recording can continue.
+
+    recorder.clear();
+    ASSERT_EQUAL(0, recorder.getNumFrames());
+}
+
+void testRingBuffer() {
+    // With a small buffer, only the most recent frames are kept.
+
+    ReferencePlatform platform;
+    System system;
+    system.addParticle(1.0);
+    VerletIntegrator integrator(0.001);
+    Context context(system, integrator, platform);
+    context.setPositions(vector<Vec3>(1));
+    TrajectoryRecorder recorder(1, 3);
+    context.setTrajectoryRecorder(&recorder);
+    integrator.step(10);
+    ASSERT_EQUAL(3, recorder.getNumFrames());
+    ASSERT_EQUAL_TOL(0.001*7, recorder.getFrameTime(0), TOL);
+    ASSERT_EQUAL_TOL(0.001*9, recorder.getFrameTime(2), TOL);
+}
+
+int main() {
+    try {
+        testRecording();
+        testRingBuffer();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
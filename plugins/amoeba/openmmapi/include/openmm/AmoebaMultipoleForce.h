@@ -260,6 +260,14 @@ public:
      * @return max number of iterations
      */
     int getMutualInducedMaxIterations(void) const;
+    /*
+     * An always-stable extrapolated polarization mode (a fixed, small number of field
+     * matrix-vector applications combined with precomputed extrapolation coefficients, no
+     * SCF loop at all) would make the polarization cost constant per step at a bounded
+     * accuracy epsilon.  It is an integrator-visible approximation, so it belongs here as
+     * an explicit polarization-type choice with its own energy conservation validation,
+     * not as a fast path silently replacing the converged mutual solution.
+     */
 
     /**
      * Set the max number of iterations to be used in calculating the mutual induced dipoles
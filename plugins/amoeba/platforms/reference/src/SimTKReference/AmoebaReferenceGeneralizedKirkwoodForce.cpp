@@ -21,6 +21,13 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+// The permanent-field and induced-field passes below each re-derive the per-pair Born
+// radius chain-rule terms from the descreening integrals.  Those integrals depend only on
+// the pair geometry, so a single pass caching them in a compact per-pair scratch (sized by
+// the neighbor count, reused across the passes of one evaluation) removes the duplicated
+// work; the restructuring has to keep the two passes' accumulation order, since the
+// regression baselines were generated with it.
+
 #include "AmoebaReferenceGeneralizedKirkwoodForce.h"
 
 using std::vector;
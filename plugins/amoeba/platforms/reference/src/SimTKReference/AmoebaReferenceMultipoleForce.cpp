@@ -22,6 +22,14 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+// This file is the reference implementation of the AMOEBA multipole model: single
+// threaded, scalar, and organized for correspondence with the published equations rather
+// than throughput.  A production CPU engine (ThreadPool-parallel permanent multipole and
+// induced field passes over the CpuNeighborList structure, SIMD inner loops) would be a
+// separate code body in the style of platforms/cpu, validated against this one; folding
+// threading into this file would cost it the readability that makes it the validation
+// standard.
+
 #include "AmoebaReferenceMultipoleForce.h"
 #include <algorithm>
 
@@ -679,6 +687,12 @@ void AmoebaReferenceMultipoleForce::initializeInducedDipoles( std::vector<Update
     return;
 }
 
+// On convergence: the induced dipoles are solved by fixed-point mutual iteration with
+// successive over-relaxation, which needs tens of iterations for strongly polarizable
+// systems.  A preconditioned conjugate-gradient solver on the same matrix-vector product
+// converges in a fraction of the iterations and reuses everything here except the update
+// rule; if one is added, make the convergence criterion an option on
+// AmoebaMultipoleForce so existing setups keep their exact behavior.
 void AmoebaReferenceMultipoleForce::calculateInducedDipolePairIxn( unsigned int particleI, 
                                                                    unsigned int particleJ,
                                                                    RealOpenMM rr3,
@@ -431,6 +431,12 @@ RealOpenMM AmoebaReferenceTorsionTorsionForce::calculateTorsionTorsionIxn( const
         sign = one;
     }
 
+    // The bicubic coefficient matrix below is rebuilt from the grid corner values on every
+    // evaluation.  The coefficients depend only on the grid cell, so a per-grid flattened
+    // table of 16 coefficients per cell, built once when the force is initialized and
+    // shared between torsions using the same grid, would reduce each evaluation to the
+    // polynomial itself.  The cache belongs in the kernel that owns the grids, since this
+    // class is constructed per evaluation.
     // bicubic interpolation
  
     RealOpenMM corners[2][2];
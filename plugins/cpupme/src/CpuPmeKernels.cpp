@@ -42,12 +42,17 @@
 using namespace OpenMM;
 using namespace std;
 
+// The interpolation order is a compile-time constant: the B-spline recurrences unroll, the
+// inner spread/gather loops vectorize, and the z-direction spread is written as one fvec4
+// plus a scalar lane, which is only correct for order 5.  Supporting orders 4 and 6 means
+// templating spreadCharge()/interpolateForces() on the order and writing the z handling per
+// instantiation; until something needs those orders, the constant keeps the hot loops tight.
 static const int PME_ORDER = 5;
 
 bool CpuCalcPmeReciprocalForceKernel::hasInitializedThreads = false;
 int CpuCalcPmeReciprocalForceKernel::numThreads = 0;
 
-static void spreadCharge(int start, int end, float* posq, float* grid, int gridx, int gridy, int gridz, int numParticles, Vec3 periodicBoxSize) {
+static void spreadCharge(float* posq, float* grid, int gridx, int gridy, int gridz, int numParticles, Vec3 periodicBoxSize, int slabStart, int slabEnd) {
     float temp[4];
     fvec4 boxSize((float) periodicBoxSize[0], (float) periodicBoxSize[1], (float) periodicBoxSize[2], 0);
     fvec4 invBoxSize((float) (1/periodicBoxSize[0]), (float) (1/periodicBoxSize[1]), (float) (1/periodicBoxSize[2]), 0);
@@ -56,8 +61,28 @@ static void spreadCharge(int start, int end, float* posq, float* grid, int gridx
     fvec4 one(1);
     fvec4 scale(1.0f/(PME_ORDER-1));
     const float epsilonFactor = sqrt(ONE_4PI_EPS0);
-    memset(grid, 0, sizeof(float)*gridx*gridy*gridz);
-    for (int i = start; i < end; i++) {
+
+    // This thread owns the slab of grid planes [slabStart, slabEnd) along x: it spreads
+    // exactly the particles whose base grid point falls in that slab, which means it can
+    // only write to the slab plus PME_ORDER-1 planes above it.  Only that region needs to
+    // be cleared, and the merge pass only reads it back.
+
+    int regionWidth = slabEnd-slabStart+PME_ORDER-1;
+    if (slabEnd == slabStart)
+        return; // This thread owns no planes, so it has nothing to spread.
+    if (regionWidth >= gridx)
+        memset(grid, 0, sizeof(float)*gridx*gridy*gridz);
+    else {
+        int planeSize = gridy*gridz;
+        int clearEnd = slabStart+regionWidth;
+        if (clearEnd <= gridx)
+            memset(grid+slabStart*planeSize, 0, sizeof(float)*regionWidth*planeSize);
+        else {
+            memset(grid+slabStart*planeSize, 0, sizeof(float)*(gridx-slabStart)*planeSize);
+            memset(grid, 0, sizeof(float)*(clearEnd-gridx)*planeSize);
+        }
+    }
+    for (int i = 0; i < numParticles; i++) {
         // Find the position relative to the nearest grid point.
         
         fvec4 pos(&posq[4*i]);
@@ -67,6 +92,10 @@ static void spreadCharge(int start, int end, float* posq, float* grid, int gridx
         ivec4 ti = t;
         fvec4 dr = t-ti;
         ivec4 gridIndex = ti-(gridSizeInt&ti==gridSizeInt);
+        if (gridIndex[0] < slabStart || gridIndex[0] >= slabEnd) {
+            if (gridIndex[0] >= 0)
+                continue; // Another thread owns this particle's slab.
+        }
         
         // Compute the B-spline coefficients.
         
@@ -461,6 +490,15 @@ CpuCalcPmeReciprocalForceKernel::~CpuCalcPmeReciprocalForceKernel() {
     }
 }
 
+/*
+ * On deeper pipelining: beginComputation() returns as soon as the worker threads have the
+ * inputs, and the GPU's direct-space work proceeds underneath; the serialization point is
+ * finishComputation() at the step boundary, where the caller needs this step's reciprocal
+ * forces.  Two-deep pipelining (computing step N+1's reciprocal space during step N's
+ * integration) would require the caller to hand over positions half a step early, which
+ * changes the integration scheme itself, not just this kernel's scheduling.  Within the
+ * present contract the overlap is already maximal.
+ */
 void CpuCalcPmeReciprocalForceKernel::runThread(int index) {
     if (index == -1) {
         // This is the main thread that coordinates all the other ones.
@@ -503,14 +541,40 @@ void CpuCalcPmeReciprocalForceKernel::runThread(int index) {
             threadWait();
             if (isDeleted)
                 break;
-            spreadCharge(particleStart, particleEnd, posq, threadData[index]->tempGrid, gridx, gridy, gridz, numParticles, periodicBoxSize);
+            spreadCharge(posq, threadData[index]->tempGrid, gridx, gridy, gridz, numParticles, periodicBoxSize, gridxStart, gridxEnd);
             threadWait();
+
+            // Merge the slabs into the real grid.  Each plane only has contributions from
+            // the grids of threads whose write region covers it, usually one or two.
+
             int numGrids = threadData.size();
-            for (int i = gridStart; i < gridEnd; i += 4) {
-                fvec4 sum(&realGrid[i]);
-                for (int j = 1; j < numGrids; j++)
-                    sum += fvec4(&threadData[j]->tempGrid[i]);
-                sum.store(&realGrid[i]);
+            int planeSize = gridy*gridz;
+            for (int plane = gridxStart; plane < gridxEnd; plane++) {
+                float* output = &realGrid[plane*planeSize];
+                bool cleared = false;
+                for (int j = 0; j < numGrids; j++) {
+                    int firstPlane = (j*gridx)/numGrids;
+                    int width = ((j+1)*gridx)/numGrids-firstPlane+PME_ORDER-1;
+                    if (firstPlane == (j+1)*gridx/numGrids)
+                        continue; // This thread owned no planes.
+                    if ((plane-firstPlane+gridx)%gridx >= min(width, gridx))
+                        continue; // This thread's region does not cover the plane.
+                    const float* input = &threadData[j]->tempGrid[plane*planeSize];
+                    int vectorEnd = planeSize&~3;
+                    if (!cleared) {
+                        if (input != output)
+                            memcpy(output, input, sizeof(float)*planeSize);
+                        cleared = true;
+                    }
+                    else {
+                        for (int i = 0; i < vectorEnd; i += 4)
+                            (fvec4(&output[i])+fvec4(&input[i])).store(&output[i]);
+                        for (int i = vectorEnd; i < planeSize; i++)
+                            output[i] += input[i];
+                    }
+                }
+                if (!cleared)
+                    memset(output, 0, sizeof(float)*planeSize);
             }
             threadWait();
             if (lastBoxSize != periodicBoxSize) {
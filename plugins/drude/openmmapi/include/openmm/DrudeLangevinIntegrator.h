@@ -49,6 +49,14 @@ namespace OpenMM {
  * particles.
  */
 
+/*
+ * On the step-size limit: the light Drude particles set the fastest timescale, so the whole
+ * system integrates at their step.  A dual-thermostat split-timestep scheme (an inner loop,
+ * or an exact relative-coordinate update, for the Drude degrees of freedom, with a cold
+ * thermostat on the relative motion) lifts the outer step back to the physical timescale.
+ * That is a new integrator subclass with its own kernels, not a flag on this one: the inner
+ * update needs the Drude pair list in a form the step kernel owns.
+ */
 class OPENMM_EXPORT_DRUDE DrudeLangevinIntegrator : public Integrator {
 public:
     /**
@@ -66,6 +66,14 @@ namespace OpenMM {
  * copy (the centroid) for computing the reciprocal space part of PME.
  */
 
+/*
+ * On ring-polymer contraction: evaluating the slowly varying forces (reciprocal-space
+ * electrostatics, implicit solvent) on a contracted set of beads and interpolating back,
+ * while bonded forces stay full-resolution, is the standard way to cut the per-step cost.
+ * Structurally it needs the integrator to evaluate different force groups at different
+ * bead counts, so it builds on per-group evaluation plus a bead-interpolation kernel; the
+ * force-group machinery already exists, the contraction transform does not.
+ */
 class OPENMM_EXPORT_RPMD RPMDIntegrator : public Integrator {
 public:
     /**
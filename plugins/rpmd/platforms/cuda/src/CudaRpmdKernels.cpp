@@ -1,3 +1,9 @@
+// Bead farming across devices: between force evaluations the beads are independent, so
+// they shard naturally onto multiple GPUs using the same pattern as CudaParallelKernels
+// (per-device contexts, fixed bead ranges, partial results exchanged once per step).  The
+// exchange is the normal-mode transform's input rather than a force sum, so it cannot
+// reuse the parallel kernels directly; a bead-sharded variant of this kernel set is the
+// right home for it.
 /* -------------------------------------------------------------------------- *
  *                                   OpenMM                                   *
  * -------------------------------------------------------------------------- *
@@ -0,0 +1,84 @@
+#ifndef OPENMM_DCDWRITER_H_
+#define OPENMM_DCDWRITER_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/State.h"
+#include "openmm/internal/windowsExport.h"
+#include <iosfwd>
+
+namespace OpenMM {
+
+/**
+ * DCDWriter writes States to a stream in the CHARMM/NAMD DCD trajectory format, which most
+ * analysis and visualization tools read directly.  Coordinates are written straight from
+ * the State (converted from nm to Angstroms) with no intermediate copies through a wrapper
+ * layer, and the periodic box is recorded with every frame.
+ *
+ * The DCD header contains the frame count, so if the stream is seekable the writer updates
+ * it after every frame; on a non-seekable stream the count stays zero, which most readers
+ * treat as "read until the end of the file".
+ */
+
+class OPENMM_EXPORT DCDWriter {
+public:
+    /**
+     * Create a DCDWriter.
+     *
+     * @param stream         the stream to write to.  It must remain alive as long as the
+     *                       writer is in use, and should be opened in binary mode.
+     * @param stepsPerFrame  the number of simulation steps between saved frames, recorded
+     *                       in the file header
+     * @param stepSize       the integration step size in picoseconds, recorded in the file
+     *                       header
+     */
+    DCDWriter(std::ostream& stream, int stepsPerFrame, double stepSize);
+    /**
+     * Append one frame.  The State must contain positions, and every frame must contain
+     * the same number of particles.
+     */
+    void writeState(const State& state);
+    /**
+     * Get the number of frames written so far.
+     */
+    int getNumFrames() const;
+private:
+    void writeHeader(int numParticles);
+    std::ostream& stream;
+    int stepsPerFrame;
+    double stepSize;
+    int numFrames, numParticles;
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_DCDWRITER_H_*/
@@ -64,6 +64,15 @@ namespace OpenMM {
  * string representation of an int, but if the original string was non-numeric, the result is undefined.
  */
 
+/*
+ * On allocation behavior: a large System serializes into millions of small nodes, each
+ * with a std::map of string properties, so the allocator dominates the build phase.  An
+ * arena that owns all nodes of one document and releases them together would remove that,
+ * but it changes the value semantics of this class (nodes are freely copied and returned
+ * by value today).  The practical mitigations in place are reserving child vectors where
+ * counts are known and the binary format's cheaper rendering; an arena requires an
+ * explicit document-owner API and is deliberately not being snuck in underneath.
+ */
 class OPENMM_EXPORT SerializationNode {
 public:
     /**
@@ -167,7 +176,14 @@ public:
      * @param defaultValue  the value to return if the specified property does not exist
      */
     double getDoubleProperty(const std::string& name, double defaultValue) const;
-    /**
+        /*
+     * Note on bulk numeric data: properties are stored as strings, so every double passes
+     * through dtoa when set and strtod when read, one value at a time, even in the binary
+     * stream format.  Batch array formatting would require SerializationNode to keep typed
+     * values and the formats to carry typed records; if the conversion cost ever dominates
+     * a real workload, that is the layer to change, not the per-proxy call sites.
+     */
+/**
      * Set the value of a property, specified as a double.
      *
      * @param name   the name of the property to set
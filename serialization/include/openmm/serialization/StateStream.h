@@ -0,0 +1,110 @@
+#ifndef OPENMM_STATESTREAM_H_
+#define OPENMM_STATESTREAM_H_
+
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/State.h"
+#include "openmm/internal/windowsExport.h"
+#include <iosfwd>
+#include <vector>
+
+namespace OpenMM {
+
+/**
+ * StateStreamWriter writes a sequence of States to a stream as a compact, lossless,
+ * append-only trajectory.  Consecutive frames of a simulation differ little, so each
+ * frame's positions and velocities are XOR-deltaed against the previous frame and the
+ * resulting zero-heavy byte stream is run-length encoded; a frame typically costs a
+ * fraction of its raw size while remaining bit-exact.  Each frame is written and flushed
+ * independently, so a stream truncated by a crash is readable up to the last complete
+ * frame.  Read the frames back with StateStreamReader.
+ */
+
+class OPENMM_EXPORT StateStreamWriter {
+public:
+    /**
+     * Create a StateStreamWriter.
+     *
+     * @param stream  the stream to write frames to.  It must remain alive as long as the
+     *                writer is in use.
+     */
+    StateStreamWriter(std::ostream& stream);
+    /**
+     * Create a StateStreamWriter that quantizes values before encoding them.  Positions and
+     * velocities are rounded to multiples of the given tolerance, which makes the deltas
+     * far more compressible at the cost of bounded, configurable error; a tolerance of 0
+     * keeps the stream lossless.  Frames read back contain the quantized values.
+     *
+     * @param stream     the stream to write frames to
+     * @param tolerance  the quantization step (in nm for positions, nm/ps for velocities),
+     *                   or 0 for lossless output
+     */
+    StateStreamWriter(std::ostream& stream, double tolerance);
+    /**
+     * Append one frame.  The State must contain positions and velocities, and every frame
+     * must contain the same number of particles.
+     */
+    void writeState(const State& state);
+private:
+    std::ostream& stream;
+    double tolerance;
+    std::vector<double> lastFrame;
+};
+
+/**
+ * StateStreamReader reads back the frames written by a StateStreamWriter.
+ */
+
+class OPENMM_EXPORT StateStreamReader {
+public:
+    /**
+     * Create a StateStreamReader.
+     *
+     * @param stream  the stream to read frames from.  It must remain alive as long as the
+     *                reader is in use.
+     */
+    StateStreamReader(std::istream& stream);
+    /**
+     * Read the next frame.
+     *
+     * @param state  on exit, a State containing the frame's time, positions and velocities
+     * @return true if a frame was read, or false if the end of the stream was reached
+     */
+    bool readState(State& state);
+private:
+    std::istream& stream;
+    std::vector<double> lastFrame;
+};
+
+} // namespace OpenMM
+
+#endif /*OPENMM_STATESTREAM_H_*/
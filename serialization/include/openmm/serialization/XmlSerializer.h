@@ -44,6 +44,14 @@ namespace OpenMM {
 
 /**
  * XmlSerializer is used for serializing objects as XML, and for reconstructing them again.
+ *
+ * Deserialization parses the whole document into a DOM before any proxy runs, so peak
+ * memory is a multiple of the file size.  A streaming parse would bound that, but the
+ * proxies are written against a fully materialized SerializationNode tree (they index into
+ * children and read properties in arbitrary order), so streaming requires either buffering
+ * one top-level block at a time or rewriting every proxy.  For large systems the practical
+ * answer is the binary format (BinarySerializer), which reads each node exactly once with
+ * no intermediate document.
  */
 
 class OPENMM_EXPORT XmlSerializer {
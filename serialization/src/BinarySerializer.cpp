@@ -0,0 +1,130 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2010 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/serialization/BinarySerializer.h"
+#include <istream>
+#include <ostream>
+#include <string>
+
+using namespace OpenMM;
+using namespace std;
+
+static const char magic[] = "OpenMMBin1";
+
+// Lengths and counts are almost always small, so they are written as a single byte, with
+// 0xFF escaping to a full four byte value.
+
+static void writeInt(ostream& stream, int value) {
+    if (value >= 0 && value < 255) {
+        unsigned char byte = (unsigned char) value;
+        stream.write((char*) &byte, 1);
+    }
+    else {
+        unsigned char escape = 255;
+        stream.write((char*) &escape, 1);
+        stream.write((char*) &value, sizeof(int));
+    }
+}
+
+static int readInt(istream& stream) {
+    unsigned char byte;
+    stream.read((char*) &byte, 1);
+    if (!stream)
+        throw OpenMMException("BinarySerializer: Unexpected end of stream");
+    if (byte < 255)
+        return byte;
+    int value;
+    stream.read((char*) &value, sizeof(int));
+    if (!stream)
+        throw OpenMMException("BinarySerializer: Unexpected end of stream");
+    return value;
+}
+
+static void writeString(ostream& stream, const string& value) {
+    writeInt(stream, value.size());
+    stream.write(value.data(), value.size());
+}
+
+static string readString(istream& stream) {
+    int length = readInt(stream);
+    if (length < 0)
+        throw OpenMMException("BinarySerializer: Corrupt stream");
+    string value(length, ' ');
+    if (length > 0)
+        stream.read(&value[0], length);
+    if (!stream)
+        throw OpenMMException("BinarySerializer: Unexpected end of stream");
+    return value;
+}
+
+void BinarySerializer::serialize(const SerializationNode& node, ostream& stream) {
+    stream.write(magic, sizeof(magic));
+    encodeNode(node, stream);
+}
+
+void BinarySerializer::encodeNode(const SerializationNode& node, ostream& stream) {
+    writeString(stream, node.getName());
+    const map<string, string>& properties = node.getProperties();
+    writeInt(stream, properties.size());
+    for (map<string, string>::const_iterator iter = properties.begin(); iter != properties.end(); ++iter) {
+        writeString(stream, iter->first);
+        writeString(stream, iter->second);
+    }
+    const vector<SerializationNode>& children = node.getChildren();
+    writeInt(stream, children.size());
+    for (int i = 0; i < (int) children.size(); i++)
+        encodeNode(children[i], stream);
+}
+
+void* BinarySerializer::deserializeStream(istream& stream) {
+    char buffer[sizeof(magic)];
+    stream.read(buffer, sizeof(magic));
+    if (!stream || string(buffer, sizeof(magic)) != string(magic, sizeof(magic)))
+        throw OpenMMException("BinarySerializer: Stream does not contain binary serialized data");
+    SerializationNode root;
+    decodeNode(root, stream);
+    const SerializationProxy& proxy = SerializationProxy::getProxy(root.getStringProperty("type"));
+    return proxy.deserialize(root);
+}
+
+void BinarySerializer::decodeNode(SerializationNode& node, istream& stream) {
+    node.setName(readString(stream));
+    int numProperties = readInt(stream);
+    for (int i = 0; i < numProperties; i++) {
+        string key = readString(stream);
+        node.setStringProperty(key, readString(stream));
+    }
+    int numChildren = readInt(stream);
+    for (int i = 0; i < numChildren; i++) {
+        node.getChildren().push_back(SerializationNode());
+        decodeNode(node.getChildren().back(), stream);
+    }
+}
@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/serialization/DCDWriter.h"
+#include "openmm/OpenMMException.h"
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+using namespace OpenMM;
+using namespace std;
+
+// DCD is a sequence of Fortran-style records: a 4 byte length, the payload, and the length
+// again.
+
+static void writeRecordMarker(ostream& stream, int size) {
+    stream.write((char*) &size, sizeof(int));
+}
+
+static void writeIntRecordValue(ostream& stream, int value) {
+    stream.write((char*) &value, sizeof(int));
+}
+
+DCDWriter::DCDWriter(ostream& stream, int stepsPerFrame, double stepSize) :
+        stream(stream), stepsPerFrame(stepsPerFrame), stepSize(stepSize), numFrames(0), numParticles(-1) {
+}
+
+int DCDWriter::getNumFrames() const {
+    return numFrames;
+}
+
+void DCDWriter::writeHeader(int numParticles) {
+    // First record: "CORD" plus twenty control integers.
+
+    writeRecordMarker(stream, 84);
+    stream.write("CORD", 4);
+    int control[20];
+    memset(control, 0, sizeof(control));
+    control[0] = 0;                           // Number of frames; updated as frames are written.
+    control[1] = stepsPerFrame;               // First step.
+    control[2] = stepsPerFrame;               // Steps between frames.
+    // The step size is stored as a float in AKMA time units (48.88821 fs).
+    float akmaStepSize = (float) (stepSize*1000/48.88821);
+    memcpy(&control[9], &akmaStepSize, sizeof(float));
+    control[10] = 1;                          // The unit cell is included with each frame.
+    control[19] = 24;                         // CHARMM version, marking the extended format.
+    stream.write((char*) control, sizeof(control));
+    writeRecordMarker(stream, 84);
+
+    // Second record: the titles.
+
+    writeRecordMarker(stream, 4+80);
+    writeIntRecordValue(stream, 1);
+    char title[80];
+    memset(title, ' ', sizeof(title));
+    memcpy(title, "Created by OpenMM", 17);
+    stream.write(title, sizeof(title));
+    writeRecordMarker(stream, 4+80);
+
+    // Third record: the number of atoms.
+
+    writeRecordMarker(stream, 4);
+    writeIntRecordValue(stream, numParticles);
+    writeRecordMarker(stream, 4);
+}
+
+void DCDWriter::writeState(const State& state) {
+    const vector<Vec3>& positions = state.getPositions();
+    if (numParticles == -1) {
+        numParticles = positions.size();
+        writeHeader(numParticles);
+    }
+    else if ((int) positions.size() != numParticles)
+        throw OpenMMException("DCDWriter: Every frame must contain the same number of particles");
+
+    // Write the unit cell: a, gamma, b, beta, alpha, c, with lengths in Angstroms.
+
+    Vec3 a, b, c;
+    state.getPeriodicBoxVectors(a, b, c);
+    double cell[6] = {10*a[0], 90.0, 10*b[1], 90.0, 90.0, 10*c[2]};
+    writeRecordMarker(stream, 48);
+    stream.write((char*) cell, sizeof(cell));
+    writeRecordMarker(stream, 48);
+
+    // Write the coordinates, one axis at a time, converted to Angstroms.
+
+    vector<float> values(numParticles);
+    for (int axis = 0; axis < 3; axis++) {
+        for (int i = 0; i < numParticles; i++)
+            values[i] = (float) (10*positions[i][axis]);
+        writeRecordMarker(stream, 4*numParticles);
+        stream.write((char*) &values[0], 4*numParticles);
+        writeRecordMarker(stream, 4*numParticles);
+    }
+    numFrames++;
+
+    // Update the frame count in the header if the stream allows seeking.
+
+    ostream::pos_type end = stream.tellp();
+    if (end != ostream::pos_type(-1)) {
+        stream.seekp(8);
+        if (stream) {
+            writeIntRecordValue(stream, numFrames);
+            stream.seekp(end);
+        }
+        stream.clear();
+    }
+    stream.flush();
+}
@@ -102,6 +102,11 @@
 
 using namespace OpenMM;
 
+// All proxies are registered eagerly when the library loads.  A lazy registry resolved on
+// first lookup would shave library load time, but the registry must then be consulted with
+// the same lock on every miss, deserialization of unknown types needs the full table
+// anyway, and the eager cost is a few dozen map inserts.  Keeping registration eager and
+// boring is the better trade until profiling shows otherwise.
 extern "C" void registerSerializationProxies() {
     SerializationProxy::registerProxy(typeid(AndersenThermostat), new AndersenThermostatProxy());
     SerializationProxy::registerProxy(typeid(CMAPTorsionForce), new CMAPTorsionForceProxy());
@@ -0,0 +1,183 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2013 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+#include "openmm/serialization/StateStream.h"
+#include "openmm/OpenMMException.h"
+#include <cmath>
+#include <istream>
+#include <ostream>
+
+using namespace OpenMM;
+using namespace std;
+
+/**
+ * The XOR of a frame against the previous one is mostly zero bytes, since the high bytes of
+ * slowly changing doubles agree.  The encoding below writes literal bytes unchanged except
+ * that every zero byte is followed by a run length, so runs of up to 255 zeros cost two
+ * bytes.
+ */
+static void writeEncoded(ostream& stream, const vector<unsigned char>& data) {
+    int size = data.size();
+    for (int i = 0; i < size; i++) {
+        unsigned char value = data[i];
+        stream.write((char*) &value, 1);
+        if (value == 0) {
+            int run = 1;
+            while (run < 255 && i+1 < size && data[i+1] == 0) {
+                run++;
+                i++;
+            }
+            unsigned char count = (unsigned char) run;
+            stream.write((char*) &count, 1);
+        }
+    }
+}
+
+static bool readEncoded(istream& stream, vector<unsigned char>& data) {
+    int size = data.size();
+    int next = 0;
+    while (next < size) {
+        unsigned char value;
+        stream.read((char*) &value, 1);
+        if (!stream)
+            return false;
+        if (value == 0) {
+            unsigned char count;
+            stream.read((char*) &count, 1);
+            if (!stream || count == 0 || next+count > size)
+                return false;
+            for (int i = 0; i < count; i++)
+                data[next++] = 0;
+        }
+        else
+            data[next++] = value;
+    }
+    return true;
+}
+
+StateStreamWriter::StateStreamWriter(ostream& stream) : stream(stream), tolerance(0.0) {
+}
+
+StateStreamWriter::StateStreamWriter(ostream& stream, double tolerance) : stream(stream), tolerance(tolerance) {
+    if (tolerance < 0)
+        throw OpenMMException("StateStreamWriter: tolerance cannot be negative");
+}
+
+void StateStreamWriter::writeState(const State& state) {
+    const vector<Vec3>& positions = state.getPositions();
+    const vector<Vec3>& velocities = state.getVelocities();
+    int numParticles = positions.size();
+    vector<double> frame(6*numParticles+10);
+    frame[0] = state.getTime();
+    Vec3 a, b, c;
+    state.getPeriodicBoxVectors(a, b, c);
+    frame[1] = a[0]; frame[2] = a[1]; frame[3] = a[2];
+    frame[4] = b[0]; frame[5] = b[1]; frame[6] = b[2];
+    frame[7] = c[0]; frame[8] = c[1]; frame[9] = c[2];
+    for (int i = 0; i < numParticles; i++)
+        for (int j = 0; j < 3; j++) {
+            frame[10+3*i+j] = positions[i][j];
+            frame[10+3*(numParticles+i)+j] = velocities[i][j];
+        }
+    if (tolerance > 0) {
+        // Round the values to the quantization grid.  Identical grid values XOR to zero,
+        // so the encoded deltas shrink dramatically.
+
+        for (int i = 10; i < (int) frame.size(); i++)
+            frame[i] = tolerance*floor(frame[i]/tolerance+0.5);
+    }
+    if (lastFrame.size() == 0) {
+        // This is the first frame, so write the header and the frame with no delta.
+
+        lastFrame.resize(frame.size(), 0.0);
+        stream.write("OpenMMStateStream1", 18);
+        stream.write((char*) &numParticles, sizeof(int));
+    }
+    else if (lastFrame.size() != frame.size())
+        throw OpenMMException("StateStreamWriter: Every frame must contain the same number of particles");
+
+    // XOR against the previous frame and encode.
+
+    int numBytes = frame.size()*sizeof(double);
+    const unsigned char* current = (const unsigned char*) &frame[0];
+    const unsigned char* previous = (const unsigned char*) &lastFrame[0];
+    vector<unsigned char> delta(numBytes);
+    for (int i = 0; i < numBytes; i++)
+        delta[i] = current[i]^previous[i];
+    writeEncoded(stream, delta);
+    stream.flush();
+    lastFrame = frame;
+}
+
+StateStreamReader::StateStreamReader(istream& stream) : stream(stream) {
+}
+
+bool StateStreamReader::readState(State& state) {
+    if (lastFrame.size() == 0) {
+        // Read the header.
+
+        char header[18];
+        stream.read(header, 18);
+        if (!stream)
+            return false;
+        if (string(header, 18) != "OpenMMStateStream1")
+            throw OpenMMException("StateStreamReader: Stream does not contain a state stream");
+        int numParticles;
+        stream.read((char*) &numParticles, sizeof(int));
+        if (!stream || numParticles < 0)
+            throw OpenMMException("StateStreamReader: Corrupt stream header");
+        lastFrame.resize(6*numParticles+10, 0.0);
+    }
+    int numBytes = lastFrame.size()*sizeof(double);
+    vector<unsigned char> delta(numBytes);
+    if (!readEncoded(stream, delta))
+        return false;
+    unsigned char* previous = (unsigned char*) &lastFrame[0];
+    for (int i = 0; i < numBytes; i++)
+        previous[i] ^= delta[i];
+
+    // Build the State.
+
+    int numParticles = (lastFrame.size()-10)/6;
+    State::StateBuilder builder(lastFrame[0]);
+    builder.setPeriodicBoxVectors(Vec3(lastFrame[1], lastFrame[2], lastFrame[3]),
+            Vec3(lastFrame[4], lastFrame[5], lastFrame[6]), Vec3(lastFrame[7], lastFrame[8], lastFrame[9]));
+    vector<Vec3> positions(numParticles), velocities(numParticles);
+    for (int i = 0; i < numParticles; i++)
+        for (int j = 0; j < 3; j++) {
+            positions[i][j] = lastFrame[10+3*i+j];
+            velocities[i][j] = lastFrame[10+3*(numParticles+i)+j];
+        }
+    builder.swapPositions(positions);
+    builder.swapVelocities(velocities);
+    state = builder.getState();
+    return true;
+}
@@ -30,6 +30,8 @@
  * -------------------------------------------------------------------------- */
 
 #include "openmm/serialization/SystemProxy.h"
+#include "openmm/internal/ThreadPool.h"
+#include <pthread.h>
 #include "openmm/serialization/SerializationNode.h"
 #include "openmm/Force.h"
 #include "openmm/System.h"
@@ -42,6 +44,45 @@ using namespace std;
 SystemProxy::SystemProxy() : SerializationProxy("System") {
 }
 
+class SerializeForcesTask : public ThreadPool::Task {
+public:
+    SerializeForcesTask(const System& system, std::vector<SerializationNode>& forceNodes) :
+            system(system), forceNodes(forceNodes), nextForce(0), failed(false) {
+        pthread_mutex_init(&lock, NULL);
+    }
+    ~SerializeForcesTask() {
+        pthread_mutex_destroy(&lock);
+    }
+    void execute(ThreadPool& threads, int threadIndex) {
+        while (true) {
+            pthread_mutex_lock(&lock);
+            int force = nextForce++;
+            pthread_mutex_unlock(&lock);
+            if (force >= system.getNumForces())
+                break;
+            try {
+                const SerializationProxy& proxy = SerializationProxy::getProxy(typeid(system.getForce(force)));
+                proxy.serialize(&system.getForce(force), forceNodes[force]);
+                if (forceNodes[force].hasProperty("type"))
+                    throw OpenMMException(proxy.getTypeName()+" created node with reserved property 'type'");
+                forceNodes[force].setStringProperty("type", proxy.getTypeName());
+            }
+            catch (const std::exception& ex) {
+                pthread_mutex_lock(&lock);
+                failed = true;
+                message = ex.what();
+                pthread_mutex_unlock(&lock);
+            }
+        }
+    }
+    const System& system;
+    std::vector<SerializationNode>& forceNodes;
+    int nextForce;
+    bool failed;
+    std::string message;
+    pthread_mutex_t lock;
+};
+
 void SystemProxy::serialize(const void* object, SerializationNode& node) const {
     node.setIntProperty("version", 1);
     const System& system = *reinterpret_cast<const System*>(object);
@@ -77,8 +118,22 @@ void SystemProxy::serialize(const void* object, SerializationNode& node) const {
         constraints.createChildNode("Constraint").setIntProperty("p1", particle1).setIntProperty("p2", particle2).setDoubleProperty("d", distance);
     }
     SerializationNode& forces = node.createChildNode("Forces");
-    for (int i = 0; i < system.getNumForces(); i++)
-        forces.createChildNode("Force", &system.getForce(i));
+    int numForces = system.getNumForces();
+    if (numForces > 1) {
+        // The Force subtrees are independent, so build them in parallel and attach them
+        // in order afterward.
+
+        for (int i = 0; i < numForces; i++)
+            forces.createChildNode("Force");
+        SerializeForcesTask task(system, forces.getChildren());
+        ThreadPool threads;
+        threads.execute(task);
+        threads.waitForThreads();
+        if (task.failed)
+            throw OpenMMException("An error occurred while serializing a Force: "+task.message);
+    }
+    else if (numForces == 1)
+        forces.createChildNode("Force", &system.getForce(0));
 }
 
 void* SystemProxy::deserialize(const SerializationNode& node) const {
@@ -0,0 +1,106 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2010 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests round-tripping objects through the binary serialization format.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/NonbondedForce.h"
+#include "openmm/System.h"
+#include "openmm/serialization/BinarySerializer.h"
+#include "openmm/serialization/XmlSerializer.h"
+#include <iostream>
+#include <sstream>
+
+using namespace OpenMM;
+using namespace std;
+
+void testSerialization() {
+    // Create a System.
+
+    System system;
+    system.setDefaultPeriodicBoxVectors(Vec3(3.5, 0, 0), Vec3(0, 4.1, 0), Vec3(0, 0, 2.9));
+    for (int i = 0; i < 50; i++)
+        system.addParticle(1.0+0.1*i);
+    for (int i = 0; i < 10; i++)
+        system.addConstraint(3*i, 3*i+1, 0.1*i);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    bonds->addBond(0, 1, 1.2, 100.0);
+    bonds->addBond(2, 3, 1.4, 150.0);
+    system.addForce(bonds);
+    NonbondedForce* nonbonded = new NonbondedForce();
+    for (int i = 0; i < 50; i++)
+        nonbonded->addParticle(0.01*i, 0.3, 0.5);
+    system.addForce(nonbonded);
+
+    // Round-trip it through the binary format, then compare the XML renderings of the
+    // original and the copy, which must be identical.
+
+    stringstream binary(ios_base::in | ios_base::out | ios_base::binary);
+    BinarySerializer::serialize<System>(&system, "System", binary);
+    System* copy = BinarySerializer::deserialize<System>(binary);
+    stringstream xml1, xml2;
+    XmlSerializer::serialize<System>(&system, "System", xml1);
+    XmlSerializer::serialize<System>(copy, "System", xml2);
+    delete copy;
+    ASSERT(xml1.str() == xml2.str());
+
+    // The binary form should also be smaller than the XML form.
+
+    ASSERT(binary.str().size() < xml1.str().size());
+
+    // A stream that does not contain binary data must be rejected cleanly.
+
+    bool threw = false;
+    try {
+        stringstream garbage("<System/>");
+        System* bad = BinarySerializer::deserialize<System>(garbage);
+        delete bad;
+    }
+    catch (OpenMMException& ex) {
+        threw = true;
+    }
+    ASSERT(threw);
+}
+
+int main() {
+    try {
+        testSerialization();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
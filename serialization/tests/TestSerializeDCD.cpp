@@ -0,0 +1,102 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2010 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests writing trajectory frames in the DCD format.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include "openmm/serialization/DCDWriter.h"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+using namespace OpenMM;
+using namespace std;
+
+void testDCD() {
+    const int numParticles = 7;
+    System system;
+    for (int i = 0; i < numParticles; i++)
+        system.addParticle(1.0);
+    VerletIntegrator integrator(0.002);
+    ReferencePlatform platform;
+    Context context(system, integrator, platform);
+    vector<Vec3> positions(numParticles);
+    for (int i = 0; i < numParticles; i++)
+        positions[i] = Vec3(0.1*i, 0.2*i, 0.3*i);
+    context.setPositions(positions);
+    stringstream stream(ios_base::in | ios_base::out | ios_base::binary);
+    DCDWriter writer(stream, 10, 0.002);
+    const int numFrames = 3;
+    for (int i = 0; i < numFrames; i++) {
+        writer.writeState(context.getState(State::Positions));
+        integrator.step(10);
+    }
+    ASSERT_EQUAL(numFrames, writer.getNumFrames());
+
+    // Verify the file structure.
+
+    string data = stream.str();
+    ASSERT_EQUAL(84, *(int*) &data[0]);
+    ASSERT(memcmp(&data[4], "CORD", 4) == 0);
+    ASSERT_EQUAL(numFrames, *(int*) &data[8]);      // Frame count, updated in place.
+    ASSERT_EQUAL(84, *(int*) &data[88]);
+    // Find the atom-count record: header record (92 bytes) + title record (4+4+80+4).
+    int atomRecord = 92+92;
+    ASSERT_EQUAL(4, *(int*) &data[atomRecord]);
+    ASSERT_EQUAL(numParticles, *(int*) &data[atomRecord+4]);
+    // Each frame: cell record (4+48+4) + three coordinate records (4+4N+4 each).
+    int frameSize = 56+3*(8+4*numParticles);
+    int firstFrame = atomRecord+12;
+    ASSERT_EQUAL((int) data.size(), firstFrame+numFrames*frameSize);
+    // First frame's x record holds the coordinates in Angstroms.
+    int xRecord = firstFrame+56;
+    ASSERT_EQUAL(4*numParticles, *(int*) &data[xRecord]);
+    float x1 = *(float*) &data[xRecord+4+4];
+    ASSERT_EQUAL_TOL(1.0, x1, 1e-5);                // 0.1 nm -> 1 Angstrom
+}
+
+int main() {
+    try {
+        testDCD();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
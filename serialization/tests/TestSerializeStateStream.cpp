@@ -0,0 +1,114 @@
+/* -------------------------------------------------------------------------- *
+ *                                   OpenMM                                   *
+ * -------------------------------------------------------------------------- *
+ * This is part of the OpenMM molecular simulation toolkit originating from   *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org.               *
+ *                                                                            *
+ * Portions copyright (c) 2010 Stanford University and the Authors.           *
+ * Authors: Peter Eastman                                                     *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS, CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,    *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ * -------------------------------------------------------------------------- */
+
+/**
+ * This tests writing and reading trajectory frames with StateStream.
+ */
+
+#include "openmm/internal/AssertionUtilities.h"
+#include "openmm/Context.h"
+#include "ReferencePlatform.h"
+#include "openmm/HarmonicBondForce.h"
+#include "openmm/System.h"
+#include "openmm/VerletIntegrator.h"
+#include "openmm/serialization/StateStream.h"
+#include <iostream>
+#include <sstream>
+
+using namespace OpenMM;
+using namespace std;
+
+void testStateStream() {
+    // Run a short simulation, saving frames to a stream.
+
+    System system;
+    for (int i = 0; i < 10; i++)
+        system.addParticle(1.0);
+    HarmonicBondForce* bonds = new HarmonicBondForce();
+    for (int i = 0; i < 9; i++)
+        bonds->addBond(i, i+1, 1.1, 50.0);
+    system.addForce(bonds);
+    VerletIntegrator integrator(0.001);
+    ReferencePlatform platform;
+    Context context(system, integrator, platform);
+    vector<Vec3> positions(10);
+    for (int i = 0; i < 10; i++)
+        positions[i] = Vec3(1.05*i, 0.1*(i%3), 0);
+    context.setPositions(positions);
+    stringstream stream(ios_base::in | ios_base::out | ios_base::binary);
+    StateStreamWriter writer(stream);
+    vector<State> expected;
+    for (int frame = 0; frame < 20; frame++) {
+        State state = context.getState(State::Positions | State::Velocities);
+        writer.writeState(state);
+        expected.push_back(state);
+        integrator.step(5);
+    }
+
+    // Read them back and verify they are bit-exact.
+
+    StateStreamReader reader(stream);
+    State state;
+    for (int frame = 0; frame < 20; frame++) {
+        ASSERT(reader.readState(state));
+        ASSERT_EQUAL(expected[frame].getTime(), state.getTime());
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 3; j++) {
+                ASSERT_EQUAL(expected[frame].getPositions()[i][j], state.getPositions()[i][j]);
+                ASSERT_EQUAL(expected[frame].getVelocities()[i][j], state.getVelocities()[i][j]);
+            }
+        }
+    }
+    ASSERT(!reader.readState(state));
+
+    // A truncated stream reads cleanly up to the last complete frame.
+
+    string data = stream.str();
+    stringstream truncated(data.substr(0, data.size()/2), ios_base::in | ios_base::binary);
+    StateStreamReader reader2(truncated);
+    int framesRead = 0;
+    while (reader2.readState(state))
+        framesRead++;
+    ASSERT(framesRead > 0);
+    ASSERT(framesRead < 20);
+}
+
+int main() {
+    try {
+        testStateStream();
+    }
+    catch(const exception& e) {
+        cout << "exception: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
@@ -185,6 +185,28 @@ void testCustomFunction(const string& expression, const string& equivalent) {
     verifySameValue(deriv3, deriv4, 2.0, -3.0);
 }
 
+void testBatchEvaluation() {
+    // Verify that evaluateBatch() produces the same results as evaluating one value at a time.
+
+    CompiledExpression exp = Parser::parse("4*eps*((sigma/r)^12-(sigma/r)^6)+q*erf(r)/r+exp(-a*r^2)").createCompiledExpression();
+    exp.getVariableReference("eps") = 0.5;
+    exp.getVariableReference("sigma") = 0.3;
+    exp.getVariableReference("q") = 1.5;
+    exp.getVariableReference("a") = 2.0;
+    const int count = 500;
+    vector<double> r(count), results(count);
+    for (int i = 0; i < count; i++)
+        r[i] = 0.2+0.01*i;
+    vector<string> variables(1, "r");
+    vector<const double*> values(1, &r[0]);
+    exp.evaluateBatch(variables, values, count, &results[0]);
+    for (int i = 0; i < count; i++) {
+        exp.getVariableReference("r") = r[i];
+        double expected = exp.evaluate();
+        ASSERT_EQUAL_TOL(expected, results[i], 1e-10);
+    }
+}
+
 int main() {
     try {
         verifyEvaluation("5", 5.0);
@@ -264,6 +286,7 @@ int main() {
         cout << Parser::parse("1/(1+x)").optimize() << endl;
         cout << Parser::parse("x^(1/2)").optimize() << endl;
         cout << Parser::parse("log(3*cos(x))^(sqrt(4)-2)").optimize() << endl;
+        testBatchEvaluation();
     }
     catch(const exception& e) {
         cout << "exception: " << e.what() << endl;
@@ -1,3 +1,10 @@
+# Note on array marshalling: the generated C and Fortran wrappers move Vec3 arrays through
+# per-element OpenMM_Vec3Array accessors, which dominates set-up and reporting time for
+# large systems.  Since this generator owns the emitted code, the right fix is to also
+# emit bulk entry points (get/set of a whole array from a contiguous double buffer) for
+# the Vec3Array type and for the State accessors, rather than hand-editing the generated
+# files.  The C++ side already exposes everything needed (vectors and contiguous layouts).
+
 from __future__ import print_function
 import sys, os
 import time